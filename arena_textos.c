@@ -0,0 +1,247 @@
+#include <stdio.h>
+#include <stdlib.h> // Para malloc, realloc e free
+#include <string.h> // Para strlen, memcpy e strcmp
+#include "arena_textos.h"
+
+/** @brief Capacidade inicial (em bytes) da arena na primeira gravação. */
+#define CAPACIDADE_INICIAL_ARENA 4096
+/** @brief Capacidade inicial dos vetores do dicionário. */
+#define CAPACIDADE_INICIAL_DICIONARIO 16
+
+// --- FUNÇÕES DA ARENA ---
+
+void inicializar_arena_textos(ArenaTextos* arena) {
+    arena->dados = NULL;
+    arena->usado = 0;
+    arena->capacidade = 0;
+    arena->descartado = 0;
+}
+
+int adicionar_texto_arena(ArenaTextos* arena, const char* texto, unsigned int* deslocamento) {
+    if (arena == NULL || texto == NULL || deslocamento == NULL) {
+        return 0;
+    }
+
+    size_t tamanho = strlen(texto) + 1; // Inclui o terminador nulo
+    if (arena->usado + tamanho > arena->capacidade) {
+        size_t nova = arena->capacidade > 0 ? arena->capacidade : CAPACIDADE_INICIAL_ARENA;
+        while (arena->usado + tamanho > nova) {
+            nova *= 2;
+        }
+        if (nova > 0xFFFFFFFFu) {
+            fprintf(stderr, "ERRO (adicionar_texto_arena): Arena de textos excedeu 4 GiB.\n");
+            return 0;
+        }
+        char* dados = (char*) realloc(arena->dados, nova);
+        if (dados == NULL) {
+            perror("ERRO (adicionar_texto_arena): Falha ao alocar arena de textos");
+            return 0;
+        }
+        arena->dados = dados;
+        arena->capacidade = nova;
+    }
+
+    memcpy(arena->dados + arena->usado, texto, tamanho);
+    *deslocamento = (unsigned int)arena->usado;
+    arena->usado += tamanho;
+    return 1;
+}
+
+const char* texto_na_arena(const ArenaTextos* arena, unsigned int deslocamento) {
+    return arena->dados + deslocamento;
+}
+
+void descartar_texto_arena(ArenaTextos* arena, unsigned int deslocamento) {
+    arena->descartado += strlen(arena->dados + deslocamento) + 1;
+}
+
+void liberar_arena_textos(ArenaTextos* arena) {
+    if (arena == NULL) {
+        return;
+    }
+    free(arena->dados);
+    inicializar_arena_textos(arena);
+}
+
+// --- FUNÇÕES DO DICIONÁRIO ---
+
+unsigned int hash_texto(const char* texto) {
+    unsigned int hash = 2166136261u;
+    while (*texto != '\0') {
+        hash ^= (unsigned char)*texto++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void inicializar_dicionario_textos(DicionarioTextos* dicionario) {
+    inicializar_arena_textos(&dicionario->textos);
+    dicionario->deslocamentos = NULL;
+    dicionario->hashes = NULL;
+    dicionario->referencias = NULL;
+    dicionario->quantidade = 0;
+    dicionario->capacidade = 0;
+    dicionario->tabela = NULL;
+    dicionario->capacidade_tabela = 0;
+}
+
+/**
+ * @brief Reconstrói a tabela hash com a nova capacidade a partir dos hashes guardados.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar (a tabela antiga é preservada).
+ */
+static int redimensionar_tabela_dicionario(DicionarioTextos* dicionario, int nova_capacidade) {
+    int* tabela = (int*) malloc((size_t)nova_capacidade * sizeof(int));
+    if (tabela == NULL) {
+        perror("ERRO (redimensionar_tabela_dicionario): Falha ao alocar tabela do dicionario");
+        return 0;
+    }
+    for (int i = 0; i < nova_capacidade; i++) {
+        tabela[i] = -1;
+    }
+
+    unsigned int mascara = (unsigned int)nova_capacidade - 1;
+    for (int id = 0; id < dicionario->quantidade; id++) {
+        unsigned int pos = dicionario->hashes[id] & mascara;
+        while (tabela[pos] >= 0) {
+            pos = (pos + 1) & mascara;
+        }
+        tabela[pos] = id;
+    }
+
+    free(dicionario->tabela);
+    dicionario->tabela = tabela;
+    dicionario->capacidade_tabela = nova_capacidade;
+    return 1;
+}
+
+/**
+ * @brief Garante espaço para mais um ID nos vetores e na tabela hash (fator de carga <= 50%).
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+static int garantir_capacidade_dicionario(DicionarioTextos* dicionario) {
+    if (dicionario->quantidade == dicionario->capacidade) {
+        int nova = dicionario->capacidade > 0 ? dicionario->capacidade * 2 : CAPACIDADE_INICIAL_DICIONARIO;
+        unsigned int* deslocamentos = (unsigned int*) realloc(dicionario->deslocamentos, (size_t)nova * sizeof(unsigned int));
+        if (deslocamentos == NULL) {
+            perror("ERRO (garantir_capacidade_dicionario): Falha ao alocar dicionario");
+            return 0;
+        }
+        dicionario->deslocamentos = deslocamentos;
+        unsigned int* hashes = (unsigned int*) realloc(dicionario->hashes, (size_t)nova * sizeof(unsigned int));
+        if (hashes == NULL) {
+            perror("ERRO (garantir_capacidade_dicionario): Falha ao alocar dicionario");
+            return 0;
+        }
+        dicionario->hashes = hashes;
+        int* referencias = (int*) realloc(dicionario->referencias, (size_t)nova * sizeof(int));
+        if (referencias == NULL) {
+            perror("ERRO (garantir_capacidade_dicionario): Falha ao alocar dicionario");
+            return 0;
+        }
+        dicionario->referencias = referencias;
+        dicionario->capacidade = nova;
+    }
+
+    if ((dicionario->quantidade + 1) * 2 > dicionario->capacidade_tabela) {
+        int nova = dicionario->capacidade_tabela > 0 ? dicionario->capacidade_tabela * 2 : CAPACIDADE_INICIAL_DICIONARIO * 2;
+        return redimensionar_tabela_dicionario(dicionario, nova);
+    }
+    return 1;
+}
+
+/**
+ * @brief Localiza a posição da tabela onde o texto está (ou estaria, se ausente).
+ * @return unsigned int A posição; `tabela[pos]` é o ID do texto ou -1 se ele não existir.
+ */
+static unsigned int localizar_posicao_dicionario(const DicionarioTextos* dicionario, const char* texto, unsigned int hash) {
+    unsigned int mascara = (unsigned int)dicionario->capacidade_tabela - 1;
+    unsigned int pos = hash & mascara;
+    while (dicionario->tabela[pos] >= 0) {
+        int id = dicionario->tabela[pos];
+        if (dicionario->hashes[id] == hash &&
+            strcmp(texto_na_arena(&dicionario->textos, dicionario->deslocamentos[id]), texto) == 0) {
+            break;
+        }
+        pos = (pos + 1) & mascara;
+    }
+    return pos;
+}
+
+int buscar_id_texto(const DicionarioTextos* dicionario, const char* texto) {
+    if (dicionario == NULL || texto == NULL || dicionario->quantidade == 0) {
+        return -1;
+    }
+    unsigned int pos = localizar_posicao_dicionario(dicionario, texto, hash_texto(texto));
+    return dicionario->tabela[pos];
+}
+
+int internar_texto(DicionarioTextos* dicionario, const char* texto) {
+    if (dicionario == NULL || texto == NULL) {
+        return -1;
+    }
+
+    int id = buscar_id_texto(dicionario, texto);
+    if (id >= 0) {
+        dicionario->referencias[id]++;
+        return id;
+    }
+
+    if (!garantir_capacidade_dicionario(dicionario)) {
+        return -1;
+    }
+    unsigned int deslocamento;
+    if (!adicionar_texto_arena(&dicionario->textos, texto, &deslocamento)) {
+        return -1;
+    }
+
+    unsigned int hash = hash_texto(texto);
+    id = dicionario->quantidade++;
+    dicionario->deslocamentos[id] = deslocamento;
+    dicionario->hashes[id] = hash;
+    dicionario->referencias[id] = 1;
+    dicionario->tabela[localizar_posicao_dicionario(dicionario, texto, hash)] = id;
+    return id;
+}
+
+const char* texto_do_id(const DicionarioTextos* dicionario, int id) {
+    if (dicionario == NULL || id < 0 || id >= dicionario->quantidade) {
+        return "";
+    }
+    return texto_na_arena(&dicionario->textos, dicionario->deslocamentos[id]);
+}
+
+int id_do_deslocamento(const DicionarioTextos* dicionario, size_t deslocamento) {
+    if (dicionario == NULL || dicionario->quantidade == 0 || deslocamento >= dicionario->textos.usado) {
+        return -1;
+    }
+    // Último ID cujo texto começa em deslocamento <= o byte procurado
+    int inicio = 0;
+    int fim = dicionario->quantidade - 1;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio + 1) / 2;
+        if (dicionario->deslocamentos[meio] <= deslocamento) {
+            inicio = meio;
+        } else {
+            fim = meio - 1;
+        }
+    }
+    return inicio;
+}
+
+void liberar_referencia_texto(DicionarioTextos* dicionario, int id) {
+    if (dicionario != NULL && id >= 0 && id < dicionario->quantidade && dicionario->referencias[id] > 0) {
+        dicionario->referencias[id]--;
+    }
+}
+
+void liberar_dicionario_textos(DicionarioTextos* dicionario) {
+    if (dicionario == NULL) {
+        return;
+    }
+    liberar_arena_textos(&dicionario->textos);
+    free(dicionario->deslocamentos);
+    free(dicionario->hashes);
+    free(dicionario->referencias);
+    free(dicionario->tabela);
+    inicializar_dicionario_textos(dicionario);
+}
@@ -0,0 +1,146 @@
+#ifndef ARENA_TEXTOS_H
+#define ARENA_TEXTOS_H
+
+#include <stddef.h> // Para size_t
+
+/**
+ * @file arena_textos.h
+ * @brief Define a arena de textos (strings de tamanho variável guardadas em um único
+ * buffer contíguo) e o dicionário de textos internados usados pelo armazenamento
+ * compacto de livros.
+ *
+ * Na arena, cada texto é gravado com seu terminador nulo e identificado pelo
+ * deslocamento (offset) em relação ao início do buffer. No dicionário, cada texto
+ * distinto é guardado uma única vez e identificado por um ID inteiro pequeno, de modo
+ * que comparar dois textos internados por igualdade é comparar dois inteiros.
+ */
+
+/**
+ * @brief Buffer contíguo e crescente de strings terminadas em nulo.
+ */
+typedef struct {
+    char* dados;                 ///< Buffer com os textos gravados em sequência.
+    size_t usado;                ///< Bytes já ocupados (incluindo textos descartados).
+    size_t capacidade;           ///< Bytes alocados em `dados`.
+    size_t descartado;           ///< Bytes de textos descartados (espaço recuperável por compactação).
+} ArenaTextos;
+
+/**
+ * @brief Dicionário de textos internados (texto distinto -> ID inteiro).
+ * Os IDs são atribuídos em ordem crescente a partir de 0 e nunca são reutilizados.
+ */
+typedef struct {
+    ArenaTextos textos;          ///< Arena onde cada texto distinto é gravado uma única vez.
+    unsigned int* deslocamentos; ///< Para cada ID, o deslocamento do texto na arena.
+    unsigned int* hashes;        ///< Para cada ID, o hash do texto (evita recalcular ao crescer a tabela).
+    int* referencias;            ///< Para cada ID, quantos registros usam o texto.
+    int quantidade;              ///< Número de textos distintos (próximo ID a ser atribuído).
+    int capacidade;              ///< Capacidade alocada dos vetores indexados por ID.
+    int* tabela;                 ///< Tabela hash (sondagem linear) com IDs; -1 indica posição livre.
+    int capacidade_tabela;       ///< Número de posições da tabela (potência de 2, ou 0).
+} DicionarioTextos;
+
+// --- Protótipos das Funções da Arena ---
+
+/**
+ * @brief Inicializa uma arena vazia. Nenhuma memória é alocada até o primeiro texto.
+ * @param arena Ponteiro para a ArenaTextos. Não deve ser NULL.
+ */
+void inicializar_arena_textos(ArenaTextos* arena);
+
+/**
+ * @brief Grava uma cópia do texto (com terminador nulo) no final da arena.
+ * @param arena Ponteiro para a ArenaTextos.
+ * @param texto String constante a ser copiada. Não deve ser NULL.
+ * @param deslocamento Ponteiro onde o deslocamento do texto gravado será armazenado.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar.
+ * @warning Ponteiros obtidos com `texto_na_arena` são invalidados por esta função.
+ */
+int adicionar_texto_arena(ArenaTextos* arena, const char* texto, unsigned int* deslocamento);
+
+/**
+ * @brief Retorna o texto gravado no deslocamento informado.
+ * @param arena Ponteiro constante para a ArenaTextos.
+ * @param deslocamento Deslocamento retornado por `adicionar_texto_arena`.
+ * @return const char* Ponteiro para o texto, válido até a próxima gravação ou compactação.
+ */
+const char* texto_na_arena(const ArenaTextos* arena, unsigned int deslocamento);
+
+/**
+ * @brief Marca como descartado o texto no deslocamento informado.
+ * O espaço só é recuperado quando o dono da arena a compacta.
+ * @param arena Ponteiro para a ArenaTextos.
+ * @param deslocamento Deslocamento do texto que deixou de ser usado.
+ */
+void descartar_texto_arena(ArenaTextos* arena, unsigned int deslocamento);
+
+/**
+ * @brief Libera a memória da arena e a deixa vazia (reutilizável).
+ * @param arena Ponteiro para a ArenaTextos. Se NULL, a função não faz nada.
+ */
+void liberar_arena_textos(ArenaTextos* arena);
+
+// --- Protótipos das Funções do Dicionário ---
+
+/**
+ * @brief Calcula o hash FNV-1a de 32 bits de uma string.
+ * @param texto String terminada em nulo.
+ * @return unsigned int O valor do hash.
+ */
+unsigned int hash_texto(const char* texto);
+
+/**
+ * @brief Inicializa um dicionário vazio.
+ * @param dicionario Ponteiro para o DicionarioTextos. Não deve ser NULL.
+ */
+void inicializar_dicionario_textos(DicionarioTextos* dicionario);
+
+/**
+ * @brief Interna o texto: retorna o ID do texto se ele já existir, ou grava-o e
+ * atribui um novo ID. Em ambos os casos, o contador de referências do ID é incrementado.
+ * @param dicionario Ponteiro para o DicionarioTextos.
+ * @param texto String constante a ser internada. Não deve ser NULL.
+ * @return int O ID do texto, ou -1 se a alocação falhar.
+ */
+int internar_texto(DicionarioTextos* dicionario, const char* texto);
+
+/**
+ * @brief Busca o ID de um texto sem interná-lo.
+ * @param dicionario Ponteiro constante para o DicionarioTextos.
+ * @param texto String constante buscada.
+ * @return int O ID do texto, ou -1 se o texto não estiver no dicionário.
+ */
+int buscar_id_texto(const DicionarioTextos* dicionario, const char* texto);
+
+/**
+ * @brief Retorna o texto associado a um ID.
+ * @param dicionario Ponteiro constante para o DicionarioTextos.
+ * @param id ID retornado por `internar_texto`.
+ * @return const char* O texto, ou "" se o ID for inválido. Válido até a próxima internação.
+ */
+const char* texto_do_id(const DicionarioTextos* dicionario, int id);
+
+/**
+ * @brief Localiza o ID do texto que contém o byte no deslocamento informado da arena
+ * do dicionário. Como os textos são gravados em ordem de ID e nunca removidos, os
+ * deslocamentos crescem com o ID e a busca é binária.
+ * @param dicionario Ponteiro constante para o DicionarioTextos.
+ * @param deslocamento Deslocamento de um byte dentro de `dicionario->textos`.
+ * @return int O ID do texto, ou -1 se o deslocamento for inválido.
+ */
+int id_do_deslocamento(const DicionarioTextos* dicionario, size_t deslocamento);
+
+/**
+ * @brief Decrementa o contador de referências de um ID (o texto é mantido no dicionário).
+ * @param dicionario Ponteiro para o DicionarioTextos.
+ * @param id ID cujo registro deixou de usar o texto.
+ */
+void liberar_referencia_texto(DicionarioTextos* dicionario, int id);
+
+/**
+ * @brief Libera toda a memória do dicionário e o deixa vazio (reutilizável).
+ * @param dicionario Ponteiro para o DicionarioTextos. Se NULL, a função não faz nada.
+ */
+void liberar_dicionario_textos(DicionarioTextos* dicionario);
+
+#endif // ARENA_TEXTOS_H
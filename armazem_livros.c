@@ -0,0 +1,392 @@
+#include <stdio.h>
+#include <stdlib.h> // Para malloc, realloc e free
+#include <string.h> // Para strncpy
+#include "armazem_livros.h"
+
+/** @brief Capacidade inicial do vetor denso na primeira inserção. */
+#define CAPACIDADE_INICIAL_ARMAZEM 64
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Garante espaço para `minimo` registros no vetor denso (crescimento geométrico).
+ * @return int 1 em caso de sucesso, 0 se a realocação falhar (o conteúdo é preservado).
+ */
+static int garantir_capacidade_registros(ArmazemLivros* armazem, int minimo) {
+    if (minimo <= armazem->capacidade) {
+        return 1;
+    }
+    int nova = armazem->capacidade > 0 ? armazem->capacidade : CAPACIDADE_INICIAL_ARMAZEM;
+    while (nova < minimo) {
+        nova *= 2;
+    }
+
+    RegistroLivro* registros = (RegistroLivro*) realloc(armazem->registros, (size_t)nova * sizeof(RegistroLivro));
+    if (registros == NULL) {
+        perror("ERRO (garantir_capacidade_registros): Falha ao alocar vetor de registros");
+        return 0;
+    }
+    armazem->registros = registros;
+
+    int* handles = (int*) realloc(armazem->handle_de_posicao, (size_t)nova * sizeof(int));
+    if (handles == NULL) {
+        perror("ERRO (garantir_capacidade_registros): Falha ao alocar vetor de handles");
+        return 0; // 'registros' maior é inofensivo; a capacidade continua a antiga
+    }
+    armazem->handle_de_posicao = handles;
+    armazem->capacidade = nova;
+    return 1;
+}
+
+/**
+ * @brief Garante espaço para `minimo` handles na tabela handle -> posição.
+ * @return int 1 em caso de sucesso, 0 se a realocação falhar.
+ */
+static int garantir_capacidade_handles(ArmazemLivros* armazem, int minimo) {
+    if (minimo <= armazem->capacidade_handles) {
+        return 1;
+    }
+    int nova = armazem->capacidade_handles > 0 ? armazem->capacidade_handles : CAPACIDADE_INICIAL_ARMAZEM;
+    while (nova < minimo) {
+        nova *= 2;
+    }
+
+    int* posicoes = (int*) realloc(armazem->posicao_de_handle, (size_t)nova * sizeof(int));
+    if (posicoes == NULL) {
+        perror("ERRO (garantir_capacidade_handles): Falha ao alocar tabela de handles");
+        return 0;
+    }
+    armazem->posicao_de_handle = posicoes;
+
+    int* livres = (int*) realloc(armazem->handles_livres, (size_t)nova * sizeof(int));
+    if (livres == NULL) {
+        perror("ERRO (garantir_capacidade_handles): Falha ao alocar pilha de handles livres");
+        return 0;
+    }
+    armazem->handles_livres = livres;
+    armazem->capacidade_handles = nova;
+    return 1;
+}
+
+/**
+ * @brief Garante espaço para `minimo` entradas no vetor de donos dos títulos.
+ * @return int 1 em caso de sucesso, 0 se a realocação falhar.
+ */
+static int garantir_capacidade_titulos(ArmazemLivros* armazem, int minimo) {
+    if (minimo <= armazem->capacidade_titulos) {
+        return 1;
+    }
+    int nova = armazem->capacidade_titulos > 0 ? armazem->capacidade_titulos : CAPACIDADE_INICIAL_ARMAZEM;
+    while (nova < minimo) {
+        nova *= 2;
+    }
+
+    TituloNaArena* donos = (TituloNaArena*) realloc(armazem->donos_titulos, (size_t)nova * sizeof(TituloNaArena));
+    if (donos == NULL) {
+        perror("ERRO (garantir_capacidade_titulos): Falha ao alocar vetor de titulos");
+        return 0;
+    }
+    armazem->donos_titulos = donos;
+    armazem->capacidade_titulos = nova;
+    return 1;
+}
+
+/**
+ * @brief Regrava as arenas de títulos (originais e dobrados) apenas com os títulos dos
+ * registros presentes, na ordem do vetor denso, descartando o espaço de títulos removidos.
+ * Se a alocação falhar, as arenas antigas são mantidas (compactação é só uma otimização).
+ */
+static void compactar_titulos(ArmazemLivros* armazem) {
+    ArenaTextos nova;
+    ArenaTextos nova_dobrada;
+    inicializar_arena_textos(&nova);
+    inicializar_arena_textos(&nova_dobrada);
+    // Deslocamentos novos: [0..quantidade) na arena original, [quantidade..2*quantidade) na dobrada.
+    unsigned int* deslocamentos = (unsigned int*) malloc((size_t)(armazem->quantidade > 0 ? 2 * armazem->quantidade : 1) * sizeof(unsigned int));
+    if (deslocamentos == NULL) {
+        return;
+    }
+    // As novas arenas têm exatamente `quantidade` títulos, e o vetor de donos já comporta
+    // pelo menos isso (ele também contava os títulos descartados).
+
+    for (int i = 0; i < armazem->quantidade; i++) {
+        const RegistroLivro* registro = &armazem->registros[i];
+        if (!adicionar_texto_arena(&nova, titulo_registro(armazem, registro), &deslocamentos[i]) ||
+            !adicionar_texto_arena(&nova_dobrada, titulo_dobrado_registro(armazem, registro), &deslocamentos[armazem->quantidade + i])) {
+            liberar_arena_textos(&nova);
+            liberar_arena_textos(&nova_dobrada);
+            free(deslocamentos);
+            return;
+        }
+    }
+    for (int i = 0; i < armazem->quantidade; i++) {
+        armazem->registros[i].deslocamento_titulo = deslocamentos[i];
+        armazem->registros[i].deslocamento_titulo_dobrado = deslocamentos[armazem->quantidade + i];
+        armazem->donos_titulos[i].deslocamento = deslocamentos[armazem->quantidade + i];
+        armazem->donos_titulos[i].handle = armazem->handle_de_posicao[i];
+    }
+    armazem->quantidade_titulos = armazem->quantidade;
+
+    liberar_arena_textos(&armazem->titulos);
+    liberar_arena_textos(&armazem->titulos_dobrados);
+    armazem->titulos = nova;
+    armazem->titulos_dobrados = nova_dobrada;
+    free(deslocamentos);
+}
+
+// --- FUNÇÕES DO ARMAZENAMENTO ---
+
+void inicializar_armazem(ArmazemLivros* armazem) {
+    armazem->registros = NULL;
+    armazem->handle_de_posicao = NULL;
+    armazem->quantidade = 0;
+    armazem->capacidade = 0;
+    armazem->posicao_de_handle = NULL;
+    armazem->total_handles = 0;
+    armazem->capacidade_handles = 0;
+    armazem->handles_livres = NULL;
+    armazem->quantidade_livres = 0;
+    inicializar_arena_textos(&armazem->titulos);
+    inicializar_arena_textos(&armazem->titulos_dobrados);
+    armazem->donos_titulos = NULL;
+    armazem->quantidade_titulos = 0;
+    armazem->capacidade_titulos = 0;
+    inicializar_dicionario_textos(&armazem->autores);
+    inicializar_dicionario_textos(&armazem->generos);
+    inicializar_dicionario_textos(&armazem->autores_dobrados);
+}
+
+int reservar_armazem(ArmazemLivros* armazem, int capacidade) {
+    if (armazem == NULL || capacidade < 0) {
+        return 0;
+    }
+    return garantir_capacidade_registros(armazem, capacidade) &&
+           garantir_capacidade_handles(armazem, capacidade) &&
+           garantir_capacidade_titulos(armazem, capacidade);
+}
+
+int inserir_registro_armazem(ArmazemLivros* armazem, const Livro* livro, ChaveIsbn chave) {
+    if (armazem == NULL || livro == NULL) {
+        return HANDLE_INVALIDO;
+    }
+    if (!garantir_capacidade_registros(armazem, armazem->quantidade + 1)) {
+        return HANDLE_INVALIDO;
+    }
+    if (armazem->quantidade_livres == 0 && !garantir_capacidade_handles(armazem, armazem->total_handles + 1)) {
+        return HANDLE_INVALIDO;
+    }
+    if (!garantir_capacidade_titulos(armazem, armazem->quantidade_titulos + 1)) {
+        return HANDLE_INVALIDO;
+    }
+
+    // Converte para o formato compacto antes de ocupar a posição e o handle.
+    // As versões dobradas de título e autor são calculadas aqui, uma única vez.
+    char titulo_dobrado[TAM_TITULO];
+    char autor_dobrado[TAM_AUTOR];
+    dobrar_texto(livro->titulo, titulo_dobrado, sizeof(titulo_dobrado));
+    dobrar_texto(livro->autor, autor_dobrado, sizeof(autor_dobrado));
+
+    RegistroLivro registro;
+    if (!adicionar_texto_arena(&armazem->titulos, livro->titulo, &registro.deslocamento_titulo)) {
+        return HANDLE_INVALIDO;
+    }
+    if (!adicionar_texto_arena(&armazem->titulos_dobrados, titulo_dobrado, &registro.deslocamento_titulo_dobrado)) {
+        descartar_texto_arena(&armazem->titulos, registro.deslocamento_titulo);
+        return HANDLE_INVALIDO;
+    }
+    registro.id_autor = internar_texto(&armazem->autores, livro->autor);
+    registro.id_genero = internar_texto(&armazem->generos, livro->genero);
+    registro.id_autor_dobrado = internar_texto(&armazem->autores_dobrados, autor_dobrado);
+    if (registro.id_autor < 0 || registro.id_genero < 0 || registro.id_autor_dobrado < 0) {
+        descartar_texto_arena(&armazem->titulos, registro.deslocamento_titulo);
+        descartar_texto_arena(&armazem->titulos_dobrados, registro.deslocamento_titulo_dobrado);
+        liberar_referencia_texto(&armazem->autores, registro.id_autor);
+        liberar_referencia_texto(&armazem->generos, registro.id_genero);
+        liberar_referencia_texto(&armazem->autores_dobrados, registro.id_autor_dobrado);
+        return HANDLE_INVALIDO;
+    }
+    registro.chave_isbn = chave;
+    registro.anoPublicacao = livro->anoPublicacao;
+    strncpy(registro.isbn, livro->isbn, TAM_ISBN - 1);
+    registro.isbn[TAM_ISBN - 1] = '\0';
+
+    int handle;
+    if (armazem->quantidade_livres > 0) {
+        handle = armazem->handles_livres[--armazem->quantidade_livres];
+    } else {
+        handle = armazem->total_handles++;
+    }
+
+    int posicao = armazem->quantidade++;
+    armazem->registros[posicao] = registro;
+    armazem->handle_de_posicao[posicao] = handle;
+    armazem->posicao_de_handle[handle] = posicao;
+    armazem->donos_titulos[armazem->quantidade_titulos].deslocamento = registro.deslocamento_titulo_dobrado;
+    armazem->donos_titulos[armazem->quantidade_titulos].handle = handle;
+    armazem->quantidade_titulos++;
+    return handle;
+}
+
+int localizar_titulo_na_arena(const ArmazemLivros* armazem, size_t deslocamento) {
+    if (armazem == NULL || armazem->quantidade_titulos == 0 || deslocamento >= armazem->titulos_dobrados.usado) {
+        return -1;
+    }
+    // Última entrada com deslocamento <= o byte procurado
+    int inicio = 0;
+    int fim = armazem->quantidade_titulos - 1;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio + 1) / 2;
+        if (armazem->donos_titulos[meio].deslocamento <= deslocamento) {
+            inicio = meio;
+        } else {
+            fim = meio - 1;
+        }
+    }
+    return armazem->donos_titulos[inicio].deslocamento <= deslocamento ? inicio : -1;
+}
+
+int posicao_do_handle(const ArmazemLivros* armazem, int handle) {
+    if (armazem == NULL || handle < 0 || handle >= armazem->total_handles) {
+        return -1;
+    }
+    return armazem->posicao_de_handle[handle];
+}
+
+const RegistroLivro* obter_registro_armazem(const ArmazemLivros* armazem, int handle) {
+    int posicao = posicao_do_handle(armazem, handle);
+    return posicao < 0 ? NULL : &armazem->registros[posicao];
+}
+
+const char* titulo_registro(const ArmazemLivros* armazem, const RegistroLivro* registro) {
+    return texto_na_arena(&armazem->titulos, registro->deslocamento_titulo);
+}
+
+const char* autor_registro(const ArmazemLivros* armazem, const RegistroLivro* registro) {
+    return texto_do_id(&armazem->autores, registro->id_autor);
+}
+
+const char* genero_registro(const ArmazemLivros* armazem, const RegistroLivro* registro) {
+    return texto_do_id(&armazem->generos, registro->id_genero);
+}
+
+const char* titulo_dobrado_registro(const ArmazemLivros* armazem, const RegistroLivro* registro) {
+    return texto_na_arena(&armazem->titulos_dobrados, registro->deslocamento_titulo_dobrado);
+}
+
+const char* autor_dobrado_registro(const ArmazemLivros* armazem, const RegistroLivro* registro) {
+    return texto_do_id(&armazem->autores_dobrados, registro->id_autor_dobrado);
+}
+
+void materializar_livro(const ArmazemLivros* armazem, const RegistroLivro* registro, Livro* destino) {
+    strncpy(destino->titulo, titulo_registro(armazem, registro), TAM_TITULO - 1);
+    destino->titulo[TAM_TITULO - 1] = '\0';
+    strncpy(destino->autor, autor_registro(armazem, registro), TAM_AUTOR - 1);
+    destino->autor[TAM_AUTOR - 1] = '\0';
+    destino->anoPublicacao = registro->anoPublicacao;
+    strncpy(destino->isbn, registro->isbn, TAM_ISBN - 1);
+    destino->isbn[TAM_ISBN - 1] = '\0';
+    strncpy(destino->genero, genero_registro(armazem, registro), TAM_GENERO - 1);
+    destino->genero[TAM_GENERO - 1] = '\0';
+}
+
+int remover_registro_armazem(ArmazemLivros* armazem, int handle) {
+    int posicao = posicao_do_handle(armazem, handle);
+    if (posicao < 0) {
+        return 0;
+    }
+
+    const RegistroLivro* removido = &armazem->registros[posicao];
+    int titulo = localizar_titulo_na_arena(armazem, removido->deslocamento_titulo_dobrado);
+    if (titulo >= 0) {
+        armazem->donos_titulos[titulo].handle = HANDLE_INVALIDO;
+    }
+    descartar_texto_arena(&armazem->titulos, removido->deslocamento_titulo);
+    descartar_texto_arena(&armazem->titulos_dobrados, removido->deslocamento_titulo_dobrado);
+    liberar_referencia_texto(&armazem->autores, removido->id_autor);
+    liberar_referencia_texto(&armazem->generos, removido->id_genero);
+    liberar_referencia_texto(&armazem->autores_dobrados, removido->id_autor_dobrado);
+
+    // Move o último registro para a posição liberada, mantendo o vetor sem buracos.
+    int ultima = armazem->quantidade - 1;
+    if (posicao != ultima) {
+        int handle_movido = armazem->handle_de_posicao[ultima];
+        armazem->registros[posicao] = armazem->registros[ultima];
+        armazem->handle_de_posicao[posicao] = handle_movido;
+        armazem->posicao_de_handle[handle_movido] = posicao;
+    }
+    armazem->quantidade--;
+
+    armazem->posicao_de_handle[handle] = -1;
+    armazem->handles_livres[armazem->quantidade_livres++] = handle;
+
+    // Compacta quando os títulos removidos passam a ocupar mais da metade da arena.
+    if (armazem->titulos.descartado > 4096 && armazem->titulos.descartado * 2 > armazem->titulos.usado) {
+        compactar_titulos(armazem);
+    }
+    return 1;
+}
+
+int reordenar_armazem(ArmazemLivros* armazem, const int* ordem_handles) {
+    if (armazem == NULL || ordem_handles == NULL) {
+        return 0;
+    }
+    if (armazem->quantidade < 2) {
+        return 1;
+    }
+
+    // Posição atual do registro que deve ir para cada posição. Calculada antes, em uma
+    // passada com acessos independentes, para que o percurso dos ciclos abaixo não
+    // espere duas leituras aleatórias encadeadas a cada registro.
+    int* origem = (int*) malloc((size_t)armazem->quantidade * sizeof(int));
+    if (origem == NULL) {
+        perror("ERRO (reordenar_armazem): Falha ao alocar vetor temporario");
+        return 0;
+    }
+    for (int i = 0; i < armazem->quantidade; i++) {
+        origem[i] = armazem->posicao_de_handle[ordem_handles[i]];
+    }
+
+    // Permutação aplicada no próprio vetor, ciclo a ciclo: cada registro é movido uma
+    // única vez. Posições já preenchidas são marcadas com -1 em `origem`.
+    for (int inicio = 0; inicio < armazem->quantidade; inicio++) {
+        if (origem[inicio] < 0 || origem[inicio] == inicio) {
+            continue;
+        }
+        RegistroLivro guardado = armazem->registros[inicio];
+        int destino = inicio;
+        for (;;) {
+            int fonte = origem[destino];
+            origem[destino] = -1;
+            if (fonte == inicio) {
+                armazem->registros[destino] = guardado;
+                break;
+            }
+            armazem->registros[destino] = armazem->registros[fonte];
+            destino = fonte;
+        }
+    }
+    for (int i = 0; i < armazem->quantidade; i++) {
+        armazem->handle_de_posicao[i] = ordem_handles[i];
+        armazem->posicao_de_handle[ordem_handles[i]] = i;
+    }
+
+    free(origem);
+    return 1;
+}
+
+void liberar_armazem(ArmazemLivros* armazem) {
+    if (armazem == NULL) {
+        return;
+    }
+    free(armazem->registros);
+    free(armazem->handle_de_posicao);
+    free(armazem->posicao_de_handle);
+    free(armazem->handles_livres);
+    free(armazem->donos_titulos);
+    liberar_arena_textos(&armazem->titulos);
+    liberar_arena_textos(&armazem->titulos_dobrados);
+    liberar_dicionario_textos(&armazem->autores);
+    liberar_dicionario_textos(&armazem->generos);
+    liberar_dicionario_textos(&armazem->autores_dobrados);
+    inicializar_armazem(armazem);
+}
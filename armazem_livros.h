@@ -0,0 +1,210 @@
+#ifndef ARMAZEM_LIVROS_H
+#define ARMAZEM_LIVROS_H
+
+#include "livro.h"        // Necessário para a definição da struct Livro
+#include "arena_textos.h" // Arena de títulos e dicionários de autores/gêneros
+#include "chave_isbn.h"   // Chave de 64 bits do ISBN normalizado
+#include "normalizacao.h" // Dobra de textos (minúsculas, sem acentos) para as buscas
+
+/**
+ * @file armazem_livros.h
+ * @brief Define o armazenamento contíguo de registros de livros usado pela coleção.
+ *
+ * Os registros ficam em um vetor denso e crescente (sem buracos), de modo que
+ * percorrer a coleção inteira é uma leitura sequencial da memória. Cada registro
+ * é identificado por um "handle" inteiro estável: o handle não muda quando outros
+ * registros são removidos, mesmo que o registro seja movido dentro do vetor.
+ *
+ * A remoção é O(1): o último registro do vetor é movido para a posição liberada
+ * (swap-remove) e o handle removido vai para uma lista de handles livres.
+ *
+ * Os registros usam um formato compacto (RegistroLivro): o título fica em uma arena
+ * de textos do armazenamento (sem o preenchimento fixo de TAM_TITULO bytes) e autor
+ * e gênero são internados em dicionários, de modo que cada registro guarda apenas
+ * IDs inteiros. Livros com o mesmo autor (ou gênero) têm o mesmo ID, e a igualdade
+ * de autor/gênero se reduz a uma comparação de inteiros. A struct Livro continua
+ * sendo o formato de troca (teclado, arquivos, fila de desejos) e é reconstruída
+ * sob demanda com `materializar_livro`.
+ *
+ * Para as buscas, título e autor também são guardados "dobrados" (minúsculas e sem
+ * acentos, ver normalizacao.h), calculados uma única vez na inserção: o título
+ * dobrado fica em uma segunda arena e o autor dobrado em um segundo dicionário.
+ */
+
+/** @brief Valor usado para indicar um handle inexistente/inválido. */
+#define HANDLE_INVALIDO (-1)
+
+/**
+ * @brief Registro compacto de um livro dentro do armazenamento.
+ */
+typedef struct {
+    ChaveIsbn chave_isbn;             ///< ISBN normalizado, usado em hash, igualdade e ordenação.
+    unsigned int deslocamento_titulo; ///< Deslocamento do título na arena `titulos` do armazenamento.
+    int id_autor;                     ///< ID do autor no dicionário `autores`.
+    int id_genero;                    ///< ID do gênero no dicionário `generos`.
+    unsigned int deslocamento_titulo_dobrado; ///< Deslocamento do título dobrado na arena `titulos_dobrados`.
+    int id_autor_dobrado;             ///< ID do autor dobrado no dicionário `autores_dobrados`.
+    int anoPublicacao;                ///< Ano de publicação do livro.
+    char isbn[TAM_ISBN];              ///< ISBN como foi digitado (apenas para exibição e gravação).
+} RegistroLivro;
+
+/**
+ * @brief Associação entre um título dobrado gravado na arena `titulos_dobrados` e o
+ * registro dono dele. Os títulos são gravados sempre no final da arena, então o vetor
+ * destas entradas fica naturalmente em ordem crescente de deslocamento, o que permite
+ * descobrir, por busca binária, a qual registro pertence um byte qualquer da arena.
+ */
+typedef struct {
+    unsigned int deslocamento;   ///< Deslocamento do título dobrado na arena `titulos_dobrados`.
+    int handle;                  ///< Handle do registro dono, ou HANDLE_INVALIDO se o título foi descartado.
+} TituloNaArena;
+
+/**
+ * @brief Estrutura do armazenamento de livros.
+ */
+typedef struct {
+    RegistroLivro* registros;    ///< Vetor denso de registros (posições 0..quantidade-1).
+    int* handle_de_posicao;      ///< Para cada posição do vetor denso, o handle do registro.
+    int quantidade;              ///< Número de registros armazenados.
+    int capacidade;              ///< Capacidade alocada de `registros` e `handle_de_posicao`.
+
+    int* posicao_de_handle;      ///< Para cada handle, a posição no vetor denso (-1 se livre).
+    int total_handles;           ///< Número de handles já criados (livres ou em uso).
+    int capacidade_handles;      ///< Capacidade alocada de `posicao_de_handle` e `handles_livres`.
+    int* handles_livres;         ///< Pilha de handles liberados, reaproveitados em novas inserções.
+    int quantidade_livres;       ///< Número de handles na pilha de livres.
+
+    ArenaTextos titulos;         ///< Títulos dos registros, gravados em sequência.
+    ArenaTextos titulos_dobrados; ///< Títulos dobrados (minúsculas, sem acentos), usados nas buscas.
+    TituloNaArena* donos_titulos; ///< Títulos dobrados em ordem de deslocamento (para varreduras da arena).
+    int quantidade_titulos;      ///< Número de entradas em `donos_titulos` (inclui títulos descartados).
+    int capacidade_titulos;      ///< Capacidade alocada de `donos_titulos`.
+    DicionarioTextos autores;    ///< Autores distintos (ID -> texto).
+    DicionarioTextos generos;    ///< Gêneros distintos (ID -> texto).
+    DicionarioTextos autores_dobrados; ///< Autores dobrados distintos, usados nas buscas.
+} ArmazemLivros;
+
+// --- Protótipos das Funções ---
+
+/**
+ * @brief Inicializa um armazenamento vazio. Nenhuma memória é alocada até a primeira inserção.
+ * @param armazem Ponteiro para o ArmazemLivros. Não deve ser NULL.
+ */
+void inicializar_armazem(ArmazemLivros* armazem);
+
+/**
+ * @brief Garante capacidade para pelo menos `capacidade` registros sem realocações.
+ * @param armazem Ponteiro para o ArmazemLivros.
+ * @param capacidade Número total de registros esperado.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+int reservar_armazem(ArmazemLivros* armazem, int capacidade);
+
+/**
+ * @brief Insere o livro, convertido para o formato compacto, no final do vetor denso.
+ * @param armazem Ponteiro para o ArmazemLivros.
+ * @param livro Ponteiro constante para o livro a ser copiado.
+ * @param chave Chave do ISBN do livro, já normalizada pelo chamador (`chave_isbn`).
+ * @return int O handle do novo registro, ou HANDLE_INVALIDO se a alocação falhar.
+ */
+int inserir_registro_armazem(ArmazemLivros* armazem, const Livro* livro, ChaveIsbn chave);
+
+/**
+ * @brief Remove o registro identificado pelo handle (swap-remove, O(1) amortizado).
+ * O último registro do vetor passa a ocupar a posição liberada; seu handle não muda.
+ * Quando a maior parte da arena de títulos estiver ocupada por títulos removidos,
+ * ela é compactada (junto com a arena de títulos dobrados).
+ * @param armazem Ponteiro para o ArmazemLivros.
+ * @param handle Handle do registro a remover.
+ * @return int 1 se o registro foi removido, 0 se o handle for inválido.
+ */
+int remover_registro_armazem(ArmazemLivros* armazem, int handle);
+
+/**
+ * @brief Retorna a posição atual do registro no vetor denso.
+ * @param armazem Ponteiro constante para o ArmazemLivros.
+ * @param handle Handle do registro.
+ * @return int A posição (0..quantidade-1), ou -1 se o handle for inválido.
+ */
+int posicao_do_handle(const ArmazemLivros* armazem, int handle);
+
+/**
+ * @brief Obtém o registro identificado pelo handle.
+ * @param armazem Ponteiro constante para o ArmazemLivros.
+ * @param handle Handle do registro.
+ * @return const RegistroLivro* Ponteiro para o registro, ou NULL se o handle for inválido.
+ * @warning O ponteiro é invalidado por qualquer inserção ou remoção no armazenamento
+ * (o vetor pode ser realocado ou o registro movido). Guarde o handle, não o ponteiro.
+ */
+const RegistroLivro* obter_registro_armazem(const ArmazemLivros* armazem, int handle);
+
+/**
+ * @brief Retorna o título de um registro.
+ * @return const char* O título, válido até a próxima inserção ou remoção.
+ */
+const char* titulo_registro(const ArmazemLivros* armazem, const RegistroLivro* registro);
+
+/**
+ * @brief Retorna o autor de um registro (texto internado).
+ * @return const char* O autor, válido até a próxima inserção.
+ */
+const char* autor_registro(const ArmazemLivros* armazem, const RegistroLivro* registro);
+
+/**
+ * @brief Retorna o gênero de um registro (texto internado).
+ * @return const char* O gênero, válido até a próxima inserção.
+ */
+const char* genero_registro(const ArmazemLivros* armazem, const RegistroLivro* registro);
+
+/**
+ * @brief Retorna o título dobrado (minúsculas, sem acentos) de um registro.
+ * @return const char* O título dobrado, válido até a próxima inserção ou remoção.
+ */
+const char* titulo_dobrado_registro(const ArmazemLivros* armazem, const RegistroLivro* registro);
+
+/**
+ * @brief Retorna o autor dobrado (minúsculas, sem acentos) de um registro.
+ * @return const char* O autor dobrado, válido até a próxima inserção.
+ */
+const char* autor_dobrado_registro(const ArmazemLivros* armazem, const RegistroLivro* registro);
+
+/**
+ * @brief Localiza o título dobrado que contém o byte no deslocamento informado.
+ * Usada para converter ocorrências encontradas varrendo a arena `titulos_dobrados`
+ * inteira (ver busca_substring.h) em registros.
+ *
+ * @param armazem Ponteiro constante para o ArmazemLivros.
+ * @param deslocamento Deslocamento de um byte dentro da arena de títulos dobrados.
+ * @return int O índice da entrada em `donos_titulos` (o handle pode ser
+ * HANDLE_INVALIDO, se o título foi descartado), ou -1 se o deslocamento for inválido.
+ */
+int localizar_titulo_na_arena(const ArmazemLivros* armazem, size_t deslocamento);
+
+/**
+ * @brief Reconstrói a struct Livro completa a partir de um registro compacto.
+ * @param armazem Ponteiro constante para o ArmazemLivros.
+ * @param registro Registro de origem.
+ * @param destino Ponteiro para a struct Livro a ser preenchida. Não deve ser NULL.
+ */
+void materializar_livro(const ArmazemLivros* armazem, const RegistroLivro* registro, Livro* destino);
+
+/**
+ * @brief Reorganiza o vetor denso segundo uma nova ordem de handles.
+ * Após a chamada, a posição i contém o registro cujo handle é `ordem_handles[i]`.
+ * Os handles continuam identificando os mesmos registros. A permutação é aplicada
+ * no próprio vetor, seguindo seus ciclos: cada registro é movido uma única vez, e o
+ * único vetor temporário tem um int por registro (a posição de origem).
+ *
+ * @param armazem Ponteiro para o ArmazemLivros.
+ * @param ordem_handles Vetor com `armazem->quantidade` handles válidos, sem repetições.
+ * @return int 1 em caso de sucesso, 0 se a alocação do vetor temporário falhar.
+ */
+int reordenar_armazem(ArmazemLivros* armazem, const int* ordem_handles);
+
+/**
+ * @brief Libera toda a memória do armazenamento e o deixa vazio (reutilizável).
+ * @param armazem Ponteiro para o ArmazemLivros. Se NULL, a função não faz nada.
+ */
+void liberar_armazem(ArmazemLivros* armazem);
+
+#endif // ARMAZEM_LIVROS_H
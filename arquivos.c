@@ -2,7 +2,48 @@
 #include <stdlib.h>
 #include <string.h>
 #include "arquivos.h"
-#include "livro.h" // Para struct Livro, NoLista, ColecaoLivros, adicionar_livro_colecao
+#include "livro.h" // Para struct Livro, ColecaoLivros, adicionar_livro_colecao
+
+/** @brief Quantidade de livros processados por lote ao gravar e carregar os arquivos. */
+#define LIVROS_POR_LOTE 256
+
+// --- FUNÇÕES AUXILIARES ---
+
+/**
+ * @brief Adiciona um lote lido de arquivo à coleção e reporta em stderr cada livro
+ * rejeitado (colisão de ISBN ou falha de memória). ISBNs repetidos são esperados ao
+ * incrementar a coleção e apenas contados em `duplicados`.
+ */
+static void adicionar_lote_arquivo(ColecaoLivros* colecao, const Livro* lote, int quantidade,
+                                   int quantidade_esperada, const char* nome_arquivo, int* duplicados) {
+    ResultadoInsercao resultados[LIVROS_POR_LOTE];
+    adicionar_livros_em_lote(colecao, lote, quantidade, quantidade_esperada, resultados);
+    for (int i = 0; i < quantidade; i++) {
+        switch (resultados[i]) {
+            case INSERCAO_DUPLICADO_COLECAO:
+            case INSERCAO_DUPLICADO_LOTE:
+                (*duplicados)++;
+                break;
+            case INSERCAO_COLISAO_ISBN:
+                fprintf(stderr, "Aviso (%s): livro '%s' ignorado; o ISBN '%s' colide com outro ISBN textual.\n",
+                        nome_arquivo, lote[i].titulo, lote[i].isbn);
+                break;
+            case INSERCAO_FALHA_MEMORIA:
+                fprintf(stderr, "Erro (%s): livro '%s' (ISBN '%s') nao carregado por falta de memoria.\n",
+                        nome_arquivo, lote[i].titulo, lote[i].isbn);
+                break;
+            default:
+                break; // Sucesso; ISBN nulo (INSERCAO_ISBN_INVALIDO) não ocorre: Livro.isbn é um vetor
+        }
+    }
+}
+
+/** @brief Reporta em stderr quantos livros do arquivo foram ignorados por ISBN repetido. */
+static void reportar_duplicados(const char* nome_arquivo, int duplicados) {
+    if (duplicados > 0) {
+        fprintf(stderr, "Aviso (%s): %d livro(s) ignorado(s) por ISBN ja existente.\n", nome_arquivo, duplicados);
+    }
+}
 
 // --- FUNÇÕES IMPLEMENTADAS ---
 
@@ -21,18 +62,18 @@ int salvar_colecao_texto(const ColecaoLivros* colecao, const char* nome_arquivo)
         return 0; // Falha
     }
 
-    NoLista* atual = colecao->inicio;
-    // Lógica: Percorrer a lista de livros da coleção.
-    while (atual != NULL) {
+    // Lógica: Percorrer o vetor denso de livros da coleção (leitura sequencial).
+    const ArmazemLivros* armazem = &colecao->armazem;
+    for (int i = 0; i < armazem->quantidade; i++) {
+        const RegistroLivro* atual = &armazem->registros[i];
         // Lógica: Para cada livro, escrever seus dados formatados no arquivo.
         // Formato CSV: "Titulo","Autor",Ano,"ISBN","Genero"\n
         fprintf(arquivo, "\"%s\",\"%s\",%d,\"%s\",\"%s\"\n",
-                atual->dadosLivro.titulo,
-                atual->dadosLivro.autor,
-                atual->dadosLivro.anoPublicacao,
-                atual->dadosLivro.isbn,
-                atual->dadosLivro.genero);
-        atual = atual->proximo;
+                titulo_registro(armazem, atual),
+                autor_registro(armazem, atual),
+                atual->anoPublicacao,
+                atual->isbn,
+                genero_registro(armazem, atual));
     }
 
     // Lógica: Fechar o arquivo.
@@ -57,32 +98,40 @@ int carregar_colecao_texto(ColecaoLivros* colecao, const char* nome_arquivo) {
         return 0; // Falha (arquivo pode não existir, tratado como coleção vazia)
     }
 
-    Livro livro_temp;
+    Livro lote[LIVROS_POR_LOTE]; // Livros lidos e ainda não adicionados à coleção
+    int no_lote = 0;
+    int duplicados = 0;
     char linha[512]; // Buffer para ler uma linha inteira
 
     // Lógica: Ler o arquivo linha por linha.
     while (fgets(linha, sizeof(linha), arquivo) != NULL) {
-        // Lógica: Para cada linha, parsear os dados para preencher uma struct Livro temporária.
+        Livro* livro_temp = &lote[no_lote];
+        // Lógica: Para cada linha, parsear os dados para preencher a próxima posição do lote.
         // Usar sscanf para parsear a linha de acordo com o formato usado em salvar_colecao_texto.
         // %[^\"] lê até encontrar uma aspa.
         // Os números (99, 99, 13, 49) são para prevenir buffer overflow nos campos de livro_temp,
         // assumindo que os campos string na struct Livro têm tamanho 100, 100, 14, 50 respectivamente.
         int campos_lidos = sscanf(linha, "\"%99[^\"]\",\"%99[^\"]\",%d,\"%13[^\"]\",\"%49[^\"]\"",
-               livro_temp.titulo,
-               livro_temp.autor,
-               &livro_temp.anoPublicacao, // sscanf precisa do endereço para int
-               livro_temp.isbn,
-               livro_temp.genero);
+               livro_temp->titulo,
+               livro_temp->autor,
+               &livro_temp->anoPublicacao, // sscanf precisa do endereço para int
+               livro_temp->isbn,
+               livro_temp->genero);
         
         if (campos_lidos == 5) { // Verifica se todos os 5 campos foram lidos corretamente
-            // Lógica: Adicionar o livro_temp à coleção usando adicionar_livro_colecao.
-            // Assumindo que adicionar_livro_colecao é uma função definida em livro.h/livro.c
-            adicionar_livro_colecao(colecao, livro_temp);
+            // Lógica: Quando o lote enche, adicioná-lo à coleção de uma vez
+            // (ISBNs repetidos são descartados por adicionar_livros_em_lote).
+            if (++no_lote == LIVROS_POR_LOTE) {
+                adicionar_lote_arquivo(colecao, lote, no_lote, 0, nome_arquivo, &duplicados);
+                no_lote = 0;
+            }
         } else {
             //fprintf(stderr, "Aviso: Linha mal formatada ou em branco no arquivo: %s", linha);
             // Pode ser uma linha em branco no final do arquivo, ou um erro de formatação.
         }
     }
+    adicionar_lote_arquivo(colecao, lote, no_lote, 0, nome_arquivo, &duplicados); // Restante do último lote
+    reportar_duplicados(nome_arquivo, duplicados);
 
     // Lógica: Fechar o arquivo.
     fclose(arquivo);
@@ -105,18 +154,22 @@ int salvar_colecao_binario(const ColecaoLivros* colecao, const char* nome_arquiv
     }
 
     // Opcional: Salvar a quantidade de livros primeiro.
-    // fwrite(&(colecao->quantidade), sizeof(int), 1, arquivo);
-
-    NoLista* atual = colecao->inicio;
-    // Lógica: Percorrer a lista.
-    while (atual != NULL) {
-        // Lógica: Para cada livro, escrever a struct Livro inteira no arquivo usando fwrite.
-        if (fwrite(&(atual->dadosLivro), sizeof(Livro), 1, arquivo) != 1) {
+    // fwrite(&(colecao->armazem.quantidade), sizeof(int), 1, arquivo);
+
+    // Lógica: O arquivo guarda structs Livro completas. Os registros compactos são
+    // reconstruídos em lotes e cada lote é escrito com um único fwrite.
+    Livro lote[LIVROS_POR_LOTE];
+    const ArmazemLivros* armazem = &colecao->armazem;
+    for (int inicio = 0; inicio < armazem->quantidade; inicio += LIVROS_POR_LOTE) {
+        size_t tamanho_lote = 0;
+        for (int i = inicio; i < armazem->quantidade && tamanho_lote < LIVROS_POR_LOTE; i++) {
+            materializar_livro(armazem, &armazem->registros[i], &lote[tamanho_lote++]);
+        }
+        if (fwrite(lote, sizeof(Livro), tamanho_lote, arquivo) != tamanho_lote) {
             perror("Erro ao escrever livro em arquivo binario");
             fclose(arquivo);
             return 0; // Falha na escrita
         }
-        atual = atual->proximo;
     }
 
     // Lógica: Fechar o arquivo.
@@ -141,18 +194,25 @@ int carregar_colecao_binario(ColecaoLivros* colecao, const char* nome_arquivo) {
         return 0; 
     }
 
-    // Opcional: Se você salvou a quantidade de livros, leia-a primeiro.
-    // int quantidade_a_ler;
-    // if (fread(&quantidade_a_ler, sizeof(int), 1, arquivo) != 1) { /* erro */ }
-    // for (int i = 0; i < quantidade_a_ler; ++i) { /* ler livro */ }
-
-    Livro livro_temp;
-    // Lógica: Ler os livros do arquivo um por um usando fread, até o fim do arquivo.
-    // fread retorna o número de itens lidos com sucesso.
-    while (fread(&livro_temp, sizeof(Livro), 1, arquivo) == 1) {
-        // Assumindo que adicionar_livro_colecao é uma função definida em livro.h/livro.c
-        adicionar_livro_colecao(colecao, livro_temp);
+    // Lógica: Estimar o número de livros pelo tamanho do arquivo (cada livro ocupa
+    // sizeof(Livro) bytes), para que a coleção reserve todo o espaço de uma só vez.
+    long bytes_arquivo = 0;
+    if (fseek(arquivo, 0, SEEK_END) == 0) {
+        bytes_arquivo = ftell(arquivo);
+    }
+    rewind(arquivo);
+    int livros_restantes = bytes_arquivo > 0 ? (int)(bytes_arquivo / (long)sizeof(Livro)) : 0;
+
+    Livro lote[LIVROS_POR_LOTE];
+    size_t lidos;
+    int duplicados = 0;
+    // Lógica: Ler os livros em blocos com fread até o fim do arquivo e adicionar cada
+    // bloco à coleção de uma vez. fread retorna o número de itens lidos com sucesso.
+    while ((lidos = fread(lote, sizeof(Livro), LIVROS_POR_LOTE, arquivo)) > 0) {
+        adicionar_lote_arquivo(colecao, lote, (int)lidos, livros_restantes, nome_arquivo, &duplicados);
+        livros_restantes -= (int)lidos;
     }
+    reportar_duplicados(nome_arquivo, duplicados);
 
     // Lógica: Fechar o arquivo.
     fclose(arquivo);
@@ -0,0 +1,505 @@
+#include <stdio.h>
+#include <stdlib.h> // Para malloc, realloc, calloc e free
+#include <string.h> // Para memmove, memcpy e memset
+#include "bitmap_handles.h"
+
+/** @brief Capacidades iniciais dos vetores do conjunto. */
+#define CAPACIDADE_INICIAL_CONTEINERES 4
+#define CAPACIDADE_INICIAL_VALORES 8
+
+/**
+ * @brief Um contêiner em forma de mapa só volta à forma de vetor abaixo deste tamanho,
+ * para que inserções e remoções alternadas perto do limite não convertam a cada passo.
+ */
+#define LIMITE_VOLTA_VETOR (LIMITE_CONTEINER_VETOR / 2)
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Posição do contêiner com a chave, ou o ponto de inserção (busca binária).
+ */
+static int localizar_conteiner(const BitmapHandles* bitmap, uint16_t chave) {
+    int inicio = 0;
+    int fim = bitmap->quantidade;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (bitmap->conteineres[meio].chave < chave) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return inicio;
+}
+
+/**
+ * @brief Posição do valor no vetor ordenado, ou o ponto de inserção (busca binária).
+ */
+static int localizar_valor(const uint16_t* valores, int quantidade, uint16_t valor) {
+    int inicio = 0;
+    int fim = quantidade;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (valores[meio] < valor) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return inicio;
+}
+
+/**
+ * @brief Converte um contêiner em forma de vetor para a forma de mapa de bits.
+ */
+static int converter_para_mapa(ConteinerBitmap* conteiner) {
+    uint64_t* bits = (uint64_t*) calloc(PALAVRAS_CONTEINER, sizeof(uint64_t));
+    if (bits == NULL) {
+        perror("ERRO (converter_para_mapa): Falha ao alocar mapa de bits");
+        return 0;
+    }
+    for (int i = 0; i < conteiner->cardinalidade; i++) {
+        uint16_t v = conteiner->valores[i];
+        bits[v >> 6] |= (uint64_t)1 << (v & 63);
+    }
+    free(conteiner->valores);
+    conteiner->valores = NULL;
+    conteiner->capacidade = 0;
+    conteiner->bits = bits;
+    return 1;
+}
+
+/**
+ * @brief Converte um contêiner em forma de mapa de bits para a forma de vetor.
+ * Se a alocação falhar, o contêiner continua (corretamente) na forma de mapa.
+ */
+static void converter_para_vetor(ConteinerBitmap* conteiner) {
+    uint16_t* valores = (uint16_t*) malloc((size_t)conteiner->cardinalidade * sizeof(uint16_t));
+    if (valores == NULL) {
+        return;
+    }
+    int n = 0;
+    for (int p = 0; p < PALAVRAS_CONTEINER; p++) {
+        uint64_t palavra = conteiner->bits[p];
+        while (palavra != 0) {
+            valores[n++] = (uint16_t)((p << 6) | __builtin_ctzll(palavra));
+            palavra &= palavra - 1;
+        }
+    }
+    free(conteiner->bits);
+    conteiner->bits = NULL;
+    conteiner->valores = valores;
+    conteiner->capacidade = conteiner->cardinalidade;
+}
+
+/**
+ * @brief Expande um contêiner (de qualquer forma) em PALAVRAS_CONTEINER palavras.
+ */
+static void preencher_palavras(const ConteinerBitmap* conteiner, uint64_t* palavras) {
+    if (conteiner->bits != NULL) {
+        memcpy(palavras, conteiner->bits, PALAVRAS_CONTEINER * sizeof(uint64_t));
+        return;
+    }
+    memset(palavras, 0, PALAVRAS_CONTEINER * sizeof(uint64_t));
+    for (int i = 0; i < conteiner->cardinalidade; i++) {
+        uint16_t v = conteiner->valores[i];
+        palavras[v >> 6] |= (uint64_t)1 << (v & 63);
+    }
+}
+
+/**
+ * @brief Acrescenta ao fim do destino um contêiner com a chave (maior que as
+ * existentes), copiando `valores` (forma de vetor) ou `palavras` (forma de mapa).
+ * Contêineres vazios são descartados.
+ */
+static int anexar_conteiner(BitmapHandles* destino, uint16_t chave, const uint16_t* valores,
+                            const uint64_t* palavras, int cardinalidade) {
+    if (cardinalidade == 0) {
+        return 1;
+    }
+    if (destino->quantidade == destino->capacidade) {
+        int nova = destino->capacidade > 0 ? destino->capacidade * 2 : CAPACIDADE_INICIAL_CONTEINERES;
+        ConteinerBitmap* conteineres = (ConteinerBitmap*) realloc(destino->conteineres, (size_t)nova * sizeof(ConteinerBitmap));
+        if (conteineres == NULL) {
+            perror("ERRO (anexar_conteiner): Falha ao alocar conteineres");
+            return 0;
+        }
+        destino->conteineres = conteineres;
+        destino->capacidade = nova;
+    }
+
+    ConteinerBitmap* conteiner = &destino->conteineres[destino->quantidade];
+    conteiner->chave = chave;
+    conteiner->cardinalidade = cardinalidade;
+    conteiner->valores = NULL;
+    conteiner->capacidade = 0;
+    conteiner->bits = NULL;
+    if (valores != NULL) {
+        conteiner->valores = (uint16_t*) malloc((size_t)cardinalidade * sizeof(uint16_t));
+        if (conteiner->valores == NULL) {
+            perror("ERRO (anexar_conteiner): Falha ao alocar valores");
+            return 0;
+        }
+        memcpy(conteiner->valores, valores, (size_t)cardinalidade * sizeof(uint16_t));
+        conteiner->capacidade = cardinalidade;
+    } else {
+        conteiner->bits = (uint64_t*) malloc(PALAVRAS_CONTEINER * sizeof(uint64_t));
+        if (conteiner->bits == NULL) {
+            perror("ERRO (anexar_conteiner): Falha ao alocar mapa de bits");
+            return 0;
+        }
+        memcpy(conteiner->bits, palavras, PALAVRAS_CONTEINER * sizeof(uint64_t));
+    }
+    destino->quantidade++;
+    destino->cardinalidade += cardinalidade;
+    return 1;
+}
+
+/**
+ * @brief Acrescenta o resultado de uma operação palavra a palavra, escolhendo a forma
+ * pela cardinalidade (vetor até LIMITE_CONTEINER_VETOR elementos).
+ */
+static int anexar_palavras(BitmapHandles* destino, uint16_t chave, const uint64_t* palavras, uint16_t* auxiliar) {
+    int cardinalidade = 0;
+    for (int p = 0; p < PALAVRAS_CONTEINER; p++) {
+        cardinalidade += __builtin_popcountll(palavras[p]);
+    }
+    if (cardinalidade > LIMITE_CONTEINER_VETOR) {
+        return anexar_conteiner(destino, chave, NULL, palavras, cardinalidade);
+    }
+    int n = 0;
+    for (int p = 0; p < PALAVRAS_CONTEINER; p++) {
+        uint64_t palavra = palavras[p];
+        while (palavra != 0) {
+            auxiliar[n++] = (uint16_t)((p << 6) | __builtin_ctzll(palavra));
+            palavra &= palavra - 1;
+        }
+    }
+    return anexar_conteiner(destino, chave, auxiliar, NULL, n);
+}
+
+/**
+ * @brief Copia um contêiner de uma das entradas para o fim do destino.
+ */
+static int copiar_conteiner(BitmapHandles* destino, const ConteinerBitmap* origem) {
+    return anexar_conteiner(destino, origem->chave, origem->valores, origem->bits, origem->cardinalidade);
+}
+
+/**
+ * @brief Interseção de dois contêineres com a mesma chave.
+ */
+static int intersectar_conteineres(BitmapHandles* destino, const ConteinerBitmap* a, const ConteinerBitmap* b,
+                                   uint64_t* palavras, uint64_t* palavras_b, uint16_t* auxiliar) {
+    (void)palavras_b; // Só a união precisa expandir as duas entradas
+    if (a->bits == NULL && b->bits == NULL) {
+        // Vetor com vetor: intercalação
+        int i = 0, j = 0, n = 0;
+        while (i < a->cardinalidade && j < b->cardinalidade) {
+            if (a->valores[i] < b->valores[j]) {
+                i++;
+            } else if (a->valores[i] > b->valores[j]) {
+                j++;
+            } else {
+                auxiliar[n++] = a->valores[i];
+                i++;
+                j++;
+            }
+        }
+        return anexar_conteiner(destino, a->chave, auxiliar, NULL, n);
+    }
+    if (a->bits == NULL || b->bits == NULL) {
+        // Vetor com mapa: cada valor do vetor é testado no mapa
+        const ConteinerBitmap* vetor = a->bits == NULL ? a : b;
+        const uint64_t* mapa = a->bits == NULL ? b->bits : a->bits;
+        int n = 0;
+        for (int i = 0; i < vetor->cardinalidade; i++) {
+            uint16_t v = vetor->valores[i];
+            if (mapa[v >> 6] & ((uint64_t)1 << (v & 63))) {
+                auxiliar[n++] = v;
+            }
+        }
+        return anexar_conteiner(destino, a->chave, auxiliar, NULL, n);
+    }
+    // Mapa com mapa: E palavra a palavra
+    for (int p = 0; p < PALAVRAS_CONTEINER; p++) {
+        palavras[p] = a->bits[p] & b->bits[p];
+    }
+    return anexar_palavras(destino, a->chave, palavras, auxiliar);
+}
+
+/**
+ * @brief União de dois contêineres com a mesma chave.
+ */
+static int unir_conteineres(BitmapHandles* destino, const ConteinerBitmap* a, const ConteinerBitmap* b,
+                            uint64_t* palavras, uint64_t* palavras_b, uint16_t* auxiliar) {
+    if (a->bits == NULL && b->bits == NULL && a->cardinalidade + b->cardinalidade <= LIMITE_CONTEINER_VETOR) {
+        // Vetores pequenos: intercalação sem repetições
+        int i = 0, j = 0, n = 0;
+        while (i < a->cardinalidade || j < b->cardinalidade) {
+            if (j == b->cardinalidade || (i < a->cardinalidade && a->valores[i] < b->valores[j])) {
+                auxiliar[n++] = a->valores[i++];
+            } else if (i == a->cardinalidade || b->valores[j] < a->valores[i]) {
+                auxiliar[n++] = b->valores[j++];
+            } else {
+                auxiliar[n++] = a->valores[i];
+                i++;
+                j++;
+            }
+        }
+        return anexar_conteiner(destino, a->chave, auxiliar, NULL, n);
+    }
+    // Caso geral: OU palavra a palavra
+    preencher_palavras(a, palavras);
+    preencher_palavras(b, palavras_b);
+    for (int p = 0; p < PALAVRAS_CONTEINER; p++) {
+        palavras[p] |= palavras_b[p];
+    }
+    return anexar_palavras(destino, a->chave, palavras, auxiliar);
+}
+
+/** @brief Operação sobre um par de contêineres com a mesma chave. */
+typedef int (*OperacaoConteineres)(BitmapHandles*, const ConteinerBitmap*, const ConteinerBitmap*,
+                                   uint64_t*, uint64_t*, uint16_t*);
+
+/**
+ * @brief Percorre os contêineres de `a` e `b` em ordem de chave, aplicando `operacao`
+ * às chaves comuns e, se `manter_exclusivos`, copiando os contêineres de uma só entrada.
+ */
+static int combinar_bitmaps(const BitmapHandles* a, const BitmapHandles* b, BitmapHandles* destino,
+                            OperacaoConteineres operacao, int manter_exclusivos) {
+    liberar_bitmap(destino);
+    if (a == NULL || b == NULL) {
+        return 0;
+    }
+
+    // Áreas de trabalho reutilizadas por todos os pares de contêineres
+    uint64_t* palavras = (uint64_t*) malloc(2 * PALAVRAS_CONTEINER * sizeof(uint64_t));
+    uint16_t* auxiliar = (uint16_t*) malloc(LIMITE_CONTEINER_VETOR * sizeof(uint16_t));
+    if (palavras == NULL || auxiliar == NULL) {
+        perror("ERRO (combinar_bitmaps): Falha ao alocar area de trabalho");
+        free(palavras);
+        free(auxiliar);
+        return 0;
+    }
+
+    int i = 0, j = 0, ok = 1;
+    while (ok && (i < a->quantidade || j < b->quantidade)) {
+        if (j == b->quantidade || (i < a->quantidade && a->conteineres[i].chave < b->conteineres[j].chave)) {
+            ok = !manter_exclusivos || copiar_conteiner(destino, &a->conteineres[i]);
+            i++;
+        } else if (i == a->quantidade || b->conteineres[j].chave < a->conteineres[i].chave) {
+            ok = !manter_exclusivos || copiar_conteiner(destino, &b->conteineres[j]);
+            j++;
+        } else {
+            ok = operacao(destino, &a->conteineres[i], &b->conteineres[j],
+                          palavras, palavras + PALAVRAS_CONTEINER, auxiliar);
+            i++;
+            j++;
+        }
+    }
+    free(palavras);
+    free(auxiliar);
+    if (!ok) {
+        liberar_bitmap(destino);
+    }
+    return ok;
+}
+
+// --- FUNÇÕES DO CONJUNTO ---
+
+void inicializar_bitmap(BitmapHandles* bitmap) {
+    bitmap->conteineres = NULL;
+    bitmap->quantidade = 0;
+    bitmap->capacidade = 0;
+    bitmap->cardinalidade = 0;
+}
+
+int adicionar_bitmap(BitmapHandles* bitmap, int handle) {
+    if (bitmap == NULL || handle < 0) {
+        return 0;
+    }
+    uint16_t chave = (uint16_t)((unsigned)handle >> 16);
+    uint16_t valor = (uint16_t)(handle & 0xFFFF);
+
+    int c = localizar_conteiner(bitmap, chave);
+    if (c == bitmap->quantidade || bitmap->conteineres[c].chave != chave) {
+        if (bitmap->quantidade == bitmap->capacidade) {
+            int nova = bitmap->capacidade > 0 ? bitmap->capacidade * 2 : CAPACIDADE_INICIAL_CONTEINERES;
+            ConteinerBitmap* conteineres = (ConteinerBitmap*) realloc(bitmap->conteineres, (size_t)nova * sizeof(ConteinerBitmap));
+            if (conteineres == NULL) {
+                perror("ERRO (adicionar_bitmap): Falha ao alocar conteineres");
+                return 0;
+            }
+            bitmap->conteineres = conteineres;
+            bitmap->capacidade = nova;
+        }
+        uint16_t* valores = (uint16_t*) malloc(CAPACIDADE_INICIAL_VALORES * sizeof(uint16_t));
+        if (valores == NULL) {
+            perror("ERRO (adicionar_bitmap): Falha ao alocar conteiner");
+            return 0;
+        }
+        memmove(&bitmap->conteineres[c + 1], &bitmap->conteineres[c],
+                (size_t)(bitmap->quantidade - c) * sizeof(ConteinerBitmap));
+        bitmap->conteineres[c].chave = chave;
+        bitmap->conteineres[c].cardinalidade = 0;
+        bitmap->conteineres[c].valores = valores;
+        bitmap->conteineres[c].capacidade = CAPACIDADE_INICIAL_VALORES;
+        bitmap->conteineres[c].bits = NULL;
+        bitmap->quantidade++;
+    }
+
+    ConteinerBitmap* conteiner = &bitmap->conteineres[c];
+    if (conteiner->bits == NULL) {
+        int posicao = localizar_valor(conteiner->valores, conteiner->cardinalidade, valor);
+        if (posicao < conteiner->cardinalidade && conteiner->valores[posicao] == valor) {
+            return 1; // Já presente
+        }
+        if (conteiner->cardinalidade < LIMITE_CONTEINER_VETOR) {
+            if (conteiner->cardinalidade == conteiner->capacidade) {
+                int nova = conteiner->capacidade * 2;
+                if (nova > LIMITE_CONTEINER_VETOR) {
+                    nova = LIMITE_CONTEINER_VETOR;
+                }
+                uint16_t* valores = (uint16_t*) realloc(conteiner->valores, (size_t)nova * sizeof(uint16_t));
+                if (valores == NULL) {
+                    perror("ERRO (adicionar_bitmap): Falha ao ampliar conteiner");
+                    return 0; // Só ocorre com o contêiner cheio, nunca com um recém-criado
+                }
+                conteiner->valores = valores;
+                conteiner->capacidade = nova;
+            }
+            memmove(&conteiner->valores[posicao + 1], &conteiner->valores[posicao],
+                    (size_t)(conteiner->cardinalidade - posicao) * sizeof(uint16_t));
+            conteiner->valores[posicao] = valor;
+            conteiner->cardinalidade++;
+            bitmap->cardinalidade++;
+            return 1;
+        }
+        if (!converter_para_mapa(conteiner)) {
+            return 0;
+        }
+    }
+
+    uint64_t bit = (uint64_t)1 << (valor & 63);
+    if ((conteiner->bits[valor >> 6] & bit) == 0) {
+        conteiner->bits[valor >> 6] |= bit;
+        conteiner->cardinalidade++;
+        bitmap->cardinalidade++;
+    }
+    return 1;
+}
+
+void remover_bitmap(BitmapHandles* bitmap, int handle) {
+    if (bitmap == NULL || handle < 0) {
+        return;
+    }
+    uint16_t chave = (uint16_t)((unsigned)handle >> 16);
+    uint16_t valor = (uint16_t)(handle & 0xFFFF);
+
+    int c = localizar_conteiner(bitmap, chave);
+    if (c == bitmap->quantidade || bitmap->conteineres[c].chave != chave) {
+        return;
+    }
+    ConteinerBitmap* conteiner = &bitmap->conteineres[c];
+    if (conteiner->bits == NULL) {
+        int posicao = localizar_valor(conteiner->valores, conteiner->cardinalidade, valor);
+        if (posicao == conteiner->cardinalidade || conteiner->valores[posicao] != valor) {
+            return;
+        }
+        memmove(&conteiner->valores[posicao], &conteiner->valores[posicao + 1],
+                (size_t)(conteiner->cardinalidade - posicao - 1) * sizeof(uint16_t));
+    } else {
+        uint64_t bit = (uint64_t)1 << (valor & 63);
+        if ((conteiner->bits[valor >> 6] & bit) == 0) {
+            return;
+        }
+        conteiner->bits[valor >> 6] &= ~bit;
+    }
+    conteiner->cardinalidade--;
+    bitmap->cardinalidade--;
+
+    if (conteiner->cardinalidade == 0) {
+        free(conteiner->valores);
+        free(conteiner->bits);
+        memmove(&bitmap->conteineres[c], &bitmap->conteineres[c + 1],
+                (size_t)(bitmap->quantidade - c - 1) * sizeof(ConteinerBitmap));
+        bitmap->quantidade--;
+    } else if (conteiner->bits != NULL && conteiner->cardinalidade < LIMITE_VOLTA_VETOR) {
+        converter_para_vetor(conteiner);
+    }
+}
+
+int contem_bitmap(const BitmapHandles* bitmap, int handle) {
+    if (bitmap == NULL || handle < 0) {
+        return 0;
+    }
+    uint16_t chave = (uint16_t)((unsigned)handle >> 16);
+    uint16_t valor = (uint16_t)(handle & 0xFFFF);
+
+    int c = localizar_conteiner(bitmap, chave);
+    if (c == bitmap->quantidade || bitmap->conteineres[c].chave != chave) {
+        return 0;
+    }
+    const ConteinerBitmap* conteiner = &bitmap->conteineres[c];
+    if (conteiner->bits != NULL) {
+        return (conteiner->bits[valor >> 6] >> (valor & 63)) & 1;
+    }
+    int posicao = localizar_valor(conteiner->valores, conteiner->cardinalidade, valor);
+    return posicao < conteiner->cardinalidade && conteiner->valores[posicao] == valor;
+}
+
+int intersectar_bitmaps(const BitmapHandles* a, const BitmapHandles* b, BitmapHandles* destino) {
+    return combinar_bitmaps(a, b, destino, intersectar_conteineres, 0);
+}
+
+int unir_bitmaps(const BitmapHandles* a, const BitmapHandles* b, BitmapHandles* destino) {
+    return combinar_bitmaps(a, b, destino, unir_conteineres, 1);
+}
+
+void iniciar_iterador_bitmap(IteradorBitmap* iterador, const BitmapHandles* bitmap) {
+    iterador->bitmap = bitmap;
+    iterador->conteiner = 0;
+    iterador->posicao = 0;
+}
+
+int proximo_bitmap(IteradorBitmap* iterador) {
+    const BitmapHandles* bitmap = iterador->bitmap;
+    while (bitmap != NULL && iterador->conteiner < bitmap->quantidade) {
+        const ConteinerBitmap* conteiner = &bitmap->conteineres[iterador->conteiner];
+        int base = (int)conteiner->chave << 16;
+        if (conteiner->bits == NULL) {
+            if (iterador->posicao < conteiner->cardinalidade) {
+                return base | conteiner->valores[iterador->posicao++];
+            }
+        } else {
+            // Procura o próximo bit ligado a partir de `posicao`
+            int p = iterador->posicao >> 6;
+            if (p < PALAVRAS_CONTEINER) {
+                uint64_t palavra = conteiner->bits[p] & (~(uint64_t)0 << (iterador->posicao & 63));
+                while (palavra == 0 && ++p < PALAVRAS_CONTEINER) {
+                    palavra = conteiner->bits[p];
+                }
+                if (palavra != 0) {
+                    int bit = (p << 6) | __builtin_ctzll(palavra);
+                    iterador->posicao = bit + 1;
+                    return base | bit;
+                }
+            }
+        }
+        iterador->conteiner++;
+        iterador->posicao = 0;
+    }
+    return -1;
+}
+
+void liberar_bitmap(BitmapHandles* bitmap) {
+    if (bitmap == NULL) {
+        return;
+    }
+    for (int c = 0; c < bitmap->quantidade; c++) {
+        free(bitmap->conteineres[c].valores);
+        free(bitmap->conteineres[c].bits);
+    }
+    free(bitmap->conteineres);
+    inicializar_bitmap(bitmap);
+}
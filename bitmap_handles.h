@@ -0,0 +1,108 @@
+#ifndef BITMAP_HANDLES_H
+#define BITMAP_HANDLES_H
+
+#include <stdint.h> // Para uint16_t e uint64_t
+
+/**
+ * @file bitmap_handles.h
+ * @brief Define um conjunto compacto de handles (inteiros não negativos) no estilo
+ * "roaring bitmap".
+ *
+ * Os handles são agrupados pelos 16 bits altos; cada grupo (contêiner) guarda os 16
+ * bits baixos de um de dois jeitos, escolhido pela quantidade de elementos:
+ * - vetor ordenado de uint16_t, enquanto tiver até LIMITE_CONTEINER_VETOR elementos
+ *   (2 bytes por elemento);
+ * - mapa de bits de 65536 bits (8 KB), quando passa desse limite.
+ * Assim, conjuntos esparsos e densos ocupam pouco espaço, a cardinalidade é mantida
+ * a cada alteração (O(1) para consultar) e interseção e união trabalham contêiner a
+ * contêiner, com operações de 64 bits nos mapas de bits.
+ */
+
+/** @brief Maior número de elementos de um contêiner em forma de vetor. */
+#define LIMITE_CONTEINER_VETOR 4096
+/** @brief Número de palavras de 64 bits de um contêiner em forma de mapa de bits. */
+#define PALAVRAS_CONTEINER 1024
+
+/**
+ * @brief Contêiner com os handles que compartilham os 16 bits altos.
+ */
+typedef struct {
+    uint16_t chave;              ///< 16 bits altos dos handles do contêiner.
+    int cardinalidade;           ///< Número de elementos do contêiner.
+    uint16_t* valores;           ///< Forma de vetor: 16 bits baixos em ordem crescente (NULL na forma de mapa).
+    int capacidade;              ///< Capacidade alocada de `valores`.
+    uint64_t* bits;              ///< Forma de mapa: PALAVRAS_CONTEINER palavras (NULL na forma de vetor).
+} ConteinerBitmap;
+
+/**
+ * @brief Conjunto de handles.
+ */
+typedef struct {
+    ConteinerBitmap* conteineres; ///< Contêineres em ordem crescente de chave (nenhum vazio).
+    int quantidade;              ///< Número de contêineres.
+    int capacidade;              ///< Capacidade alocada de `conteineres`.
+    int cardinalidade;           ///< Número total de handles no conjunto.
+} BitmapHandles;
+
+/**
+ * @brief Posição de uma iteração em ordem crescente sobre um BitmapHandles.
+ */
+typedef struct {
+    const BitmapHandles* bitmap; ///< Conjunto percorrido (não pode ser alterado durante a iteração).
+    int conteiner;               ///< Contêiner atual.
+    int posicao;                 ///< Próximo índice (forma de vetor) ou próximo bit (forma de mapa).
+} IteradorBitmap;
+
+// --- Protótipos das Funções ---
+
+/**
+ * @brief Inicializa um conjunto vazio. Nenhuma memória é alocada até a primeira inserção.
+ * @param bitmap Ponteiro para o BitmapHandles. Não deve ser NULL.
+ */
+void inicializar_bitmap(BitmapHandles* bitmap);
+
+/**
+ * @brief Insere o handle no conjunto (sem efeito se já estiver presente).
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar (o conjunto não muda).
+ */
+int adicionar_bitmap(BitmapHandles* bitmap, int handle);
+
+/**
+ * @brief Remove o handle do conjunto (sem efeito se estiver ausente).
+ */
+void remover_bitmap(BitmapHandles* bitmap, int handle);
+
+/**
+ * @brief Indica se o handle pertence ao conjunto.
+ */
+int contem_bitmap(const BitmapHandles* bitmap, int handle);
+
+/**
+ * @brief Grava em `destino` (inicializado, e diferente das entradas) a interseção de `a` e `b`.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar (o destino fica vazio).
+ */
+int intersectar_bitmaps(const BitmapHandles* a, const BitmapHandles* b, BitmapHandles* destino);
+
+/**
+ * @brief Grava em `destino` (inicializado, e diferente das entradas) a união de `a` e `b`.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar (o destino fica vazio).
+ */
+int unir_bitmaps(const BitmapHandles* a, const BitmapHandles* b, BitmapHandles* destino);
+
+/**
+ * @brief Prepara uma iteração em ordem crescente sobre o conjunto.
+ */
+void iniciar_iterador_bitmap(IteradorBitmap* iterador, const BitmapHandles* bitmap);
+
+/**
+ * @brief Retorna o próximo handle da iteração, ou -1 ao terminar.
+ */
+int proximo_bitmap(IteradorBitmap* iterador);
+
+/**
+ * @brief Libera toda a memória do conjunto e o deixa vazio (reutilizável).
+ * @param bitmap Ponteiro para o BitmapHandles. Se NULL, a função não faz nada.
+ */
+void liberar_bitmap(BitmapHandles* bitmap);
+
+#endif // BITMAP_HANDLES_H
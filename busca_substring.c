@@ -0,0 +1,144 @@
+#include <string.h> // Para memchr e memcmp
+#include "busca_substring.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BUSCA_SUBSTRING_X86 1
+#include <immintrin.h> // Intrínsecos SSE2/AVX2
+#endif
+
+/** @brief Assinatura comum das variantes da busca. */
+typedef const char* (*FuncaoBuscaSubstring)(const char*, size_t, const char*, size_t);
+
+// --- Variantes ---
+
+/**
+ * @brief Variante escalar: localiza o primeiro byte com memchr e compara o restante.
+ */
+static const char* buscar_escalar(const char* texto, size_t tamanho, const char* padrao, size_t tamanho_padrao) {
+    if (tamanho_padrao == 0) {
+        return texto;
+    }
+    const char* fim = texto + tamanho;
+    while ((size_t)(fim - texto) >= tamanho_padrao) {
+        const char* candidato = (const char*) memchr(texto, padrao[0], (size_t)(fim - texto) - tamanho_padrao + 1);
+        if (candidato == NULL) {
+            return NULL;
+        }
+        if (memcmp(candidato + 1, padrao + 1, tamanho_padrao - 1) == 0) {
+            return candidato;
+        }
+        texto = candidato + 1;
+    }
+    return NULL;
+}
+
+#ifdef BUSCA_SUBSTRING_X86
+
+/**
+ * @brief Verifica os candidatos de um bloco (bits de `mascara`) e retorna o primeiro que confere.
+ */
+static const char* verificar_mascara(const char* bloco, unsigned int mascara, const char* padrao, size_t tamanho_padrao) {
+    while (mascara != 0) {
+        int bit = __builtin_ctz(mascara);
+        // Primeiro e último byte já conferem; basta comparar o meio.
+        if (tamanho_padrao <= 2 || memcmp(bloco + bit + 1, padrao + 1, tamanho_padrao - 2) == 0) {
+            return bloco + bit;
+        }
+        mascara &= mascara - 1;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Variante SSE2: filtra 16 posições por iteração.
+ */
+__attribute__((target("sse2")))
+static const char* buscar_sse2(const char* texto, size_t tamanho, const char* padrao, size_t tamanho_padrao) {
+    if (tamanho_padrao == 0) {
+        return texto;
+    }
+    const __m128i primeiro = _mm_set1_epi8(padrao[0]);
+    const __m128i ultimo = _mm_set1_epi8(padrao[tamanho_padrao - 1]);
+    size_t i = 0;
+    for (; i + tamanho_padrao - 1 + 16 <= tamanho; i += 16) {
+        __m128i inicio_bloco = _mm_loadu_si128((const __m128i*)(texto + i));
+        __m128i fim_bloco = _mm_loadu_si128((const __m128i*)(texto + i + tamanho_padrao - 1));
+        __m128i iguais = _mm_and_si128(_mm_cmpeq_epi8(inicio_bloco, primeiro), _mm_cmpeq_epi8(fim_bloco, ultimo));
+        unsigned int mascara = (unsigned int)_mm_movemask_epi8(iguais);
+        if (mascara != 0) {
+            const char* achado = verificar_mascara(texto + i, mascara, padrao, tamanho_padrao);
+            if (achado != NULL) {
+                return achado;
+            }
+        }
+    }
+    return i < tamanho ? buscar_escalar(texto + i, tamanho - i, padrao, tamanho_padrao) : NULL;
+}
+
+/**
+ * @brief Variante AVX2: filtra 32 posições por iteração.
+ */
+__attribute__((target("avx2")))
+static const char* buscar_avx2(const char* texto, size_t tamanho, const char* padrao, size_t tamanho_padrao) {
+    if (tamanho_padrao == 0) {
+        return texto;
+    }
+    const __m256i primeiro = _mm256_set1_epi8(padrao[0]);
+    const __m256i ultimo = _mm256_set1_epi8(padrao[tamanho_padrao - 1]);
+    size_t i = 0;
+    for (; i + tamanho_padrao - 1 + 32 <= tamanho; i += 32) {
+        __m256i inicio_bloco = _mm256_loadu_si256((const __m256i*)(texto + i));
+        __m256i fim_bloco = _mm256_loadu_si256((const __m256i*)(texto + i + tamanho_padrao - 1));
+        __m256i iguais = _mm256_and_si256(_mm256_cmpeq_epi8(inicio_bloco, primeiro), _mm256_cmpeq_epi8(fim_bloco, ultimo));
+        unsigned int mascara = (unsigned int)_mm256_movemask_epi8(iguais);
+        if (mascara != 0) {
+            const char* achado = verificar_mascara(texto + i, mascara, padrao, tamanho_padrao);
+            if (achado != NULL) {
+                return achado;
+            }
+        }
+    }
+    return i < tamanho ? buscar_escalar(texto + i, tamanho - i, padrao, tamanho_padrao) : NULL;
+}
+
+#endif // BUSCA_SUBSTRING_X86
+
+// --- Seleção da variante ---
+
+static FuncaoBuscaSubstring funcao_escolhida = NULL;
+static const char* nome_escolhido = "escalar";
+
+/**
+ * @brief Escolhe a melhor variante suportada pela CPU em execução.
+ */
+static void escolher_variante(void) {
+    funcao_escolhida = buscar_escalar;
+    nome_escolhido = "escalar";
+#ifdef BUSCA_SUBSTRING_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        funcao_escolhida = buscar_avx2;
+        nome_escolhido = "avx2";
+    } else if (__builtin_cpu_supports("sse2")) {
+        funcao_escolhida = buscar_sse2;
+        nome_escolhido = "sse2";
+    }
+#endif
+}
+
+const char* buscar_substring(const char* texto, size_t tamanho, const char* padrao, size_t tamanho_padrao) {
+    if (funcao_escolhida == NULL) {
+        escolher_variante();
+    }
+    if (tamanho_padrao > tamanho) {
+        return NULL;
+    }
+    return funcao_escolhida(texto, tamanho, padrao, tamanho_padrao);
+}
+
+const char* variante_busca_substring(void) {
+    if (funcao_escolhida == NULL) {
+        escolher_variante();
+    }
+    return nome_escolhido;
+}
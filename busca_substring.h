@@ -0,0 +1,38 @@
+#ifndef BUSCA_SUBSTRING_H
+#define BUSCA_SUBSTRING_H
+
+#include <stddef.h> // Para size_t
+
+/**
+ * @file busca_substring.h
+ * @brief Define a busca de substring em blocos de memória, usada nas varreduras
+ * completas de textos (títulos na arena do armazenamento, autores no dicionário).
+ *
+ * A busca filtra 16 (SSE2) ou 32 (AVX2) posições por vez comparando o primeiro e o
+ * último byte do padrão, e só verifica o meio do padrão nas posições em que ambos
+ * coincidem. A variante usada é escolhida uma única vez, na primeira chamada, pelas
+ * capacidades da CPU em execução; fora de x86 (ou sem GCC/Clang), uma versão escalar
+ * baseada em memchr é usada.
+ */
+
+/**
+ * @brief Procura a primeira ocorrência de `padrao` em `texto[0..tamanho)`.
+ * O bloco pode conter vários textos separados por '\0': como o padrão não contém o
+ * byte nulo, uma ocorrência nunca atravessa dois textos.
+ *
+ * @param texto Início do bloco de memória.
+ * @param tamanho Número de bytes do bloco.
+ * @param padrao Bytes procurados.
+ * @param tamanho_padrao Número de bytes do padrão.
+ * @return const char* Ponteiro para a ocorrência, ou NULL se não houver nenhuma.
+ * Um padrão vazio ocorre no início do bloco.
+ */
+const char* buscar_substring(const char* texto, size_t tamanho, const char* padrao, size_t tamanho_padrao);
+
+/**
+ * @brief Retorna o nome da variante escolhida ("avx2", "sse2" ou "escalar").
+ * @return const char* Nome constante da variante.
+ */
+const char* variante_busca_substring(void);
+
+#endif // BUSCA_SUBSTRING_H
@@ -0,0 +1,229 @@
+#include <stdio.h>
+#include <stdlib.h> // Para malloc e free
+#include <string.h> // Para strcmp, strlen e memcpy
+#include "cache_consultas.h"
+#include "arena_textos.h" // Para hash_texto
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Hash da chave completa de uma pesquisa.
+ */
+static unsigned int hash_pesquisa(TipoConsultaCache tipo, int parametro, const char* chave) {
+    unsigned int hash = hash_texto(chave);
+    hash ^= (unsigned int)tipo * 0x9E3779B1u;
+    hash ^= (unsigned int)parametro * 0x85EBCA77u;
+    return hash;
+}
+
+/**
+ * @brief Retira a entrada da lista de uso.
+ */
+static void desligar_lista(CacheConsultas* cache, int e) {
+    EntradaCache* entrada = &cache->entradas[e];
+    if (entrada->anterior >= 0) {
+        cache->entradas[entrada->anterior].proxima = entrada->proxima;
+    } else {
+        cache->mais_recente = entrada->proxima;
+    }
+    if (entrada->proxima >= 0) {
+        cache->entradas[entrada->proxima].anterior = entrada->anterior;
+    } else {
+        cache->menos_recente = entrada->anterior;
+    }
+}
+
+/**
+ * @brief Coloca a entrada no início da lista de uso (a mais recente).
+ */
+static void ligar_inicio(CacheConsultas* cache, int e) {
+    EntradaCache* entrada = &cache->entradas[e];
+    entrada->anterior = -1;
+    entrada->proxima = cache->mais_recente;
+    if (cache->mais_recente >= 0) {
+        cache->entradas[cache->mais_recente].anterior = e;
+    } else {
+        cache->menos_recente = e;
+    }
+    cache->mais_recente = e;
+}
+
+/**
+ * @brief Localiza a entrada da pesquisa na tabela hash.
+ * @return int O índice da entrada, ou -1 se não estiver no cache.
+ */
+static int localizar_entrada(const CacheConsultas* cache, unsigned int hash, TipoConsultaCache tipo,
+                             int parametro, const char* chave) {
+    int e = cache->baldes[hash & (unsigned int)(cache->quantidade_baldes - 1)];
+    while (e >= 0) {
+        const EntradaCache* entrada = &cache->entradas[e];
+        if (entrada->hash == hash && entrada->tipo == tipo && entrada->parametro == parametro &&
+            strcmp(entrada->chave, chave) == 0) {
+            return e;
+        }
+        e = entrada->proxima_hash;
+    }
+    return -1;
+}
+
+/**
+ * @brief Descarta uma entrada ocupada: retira-a da tabela e da lista de uso, libera
+ * seus dados e a devolve à lista de entradas livres.
+ */
+static void descartar_entrada(CacheConsultas* cache, int e) {
+    EntradaCache* entrada = &cache->entradas[e];
+    int* elo = &cache->baldes[entrada->hash & (unsigned int)(cache->quantidade_baldes - 1)];
+    while (*elo != e) {
+        elo = &cache->entradas[*elo].proxima_hash;
+    }
+    *elo = entrada->proxima_hash;
+    desligar_lista(cache, e);
+
+    free(entrada->chave);
+    free(entrada->dados);
+    entrada->chave = NULL;
+    entrada->dados = NULL;
+    entrada->tamanho = 0;
+    entrada->proxima = cache->livre;
+    cache->livre = e;
+}
+
+/**
+ * @brief Descarta todas as entradas se a coleção mudou de geração.
+ */
+static void sincronizar_geracao(CacheConsultas* cache, unsigned long geracao) {
+    if (cache->geracao == geracao) {
+        return;
+    }
+    while (cache->mais_recente >= 0) {
+        descartar_entrada(cache, cache->mais_recente);
+    }
+    cache->geracao = geracao;
+}
+
+// --- FUNÇÕES DO CACHE ---
+
+int inicializar_cache_consultas(CacheConsultas* cache, int capacidade) {
+    if (cache == NULL || capacidade <= 0) {
+        return 0;
+    }
+    int baldes = 1;
+    while (baldes < 2 * capacidade) {
+        baldes *= 2;
+    }
+    cache->entradas = (EntradaCache*) malloc((size_t)capacidade * sizeof(EntradaCache));
+    cache->baldes = (int*) malloc((size_t)baldes * sizeof(int));
+    if (cache->entradas == NULL || cache->baldes == NULL) {
+        perror("ERRO (inicializar_cache_consultas): Falha ao alocar cache");
+        free(cache->entradas);
+        free(cache->baldes);
+        cache->entradas = NULL;
+        cache->baldes = NULL;
+        return 0;
+    }
+
+    for (int e = 0; e < capacidade; e++) {
+        cache->entradas[e].chave = NULL;
+        cache->entradas[e].dados = NULL;
+        cache->entradas[e].tamanho = 0;
+        cache->entradas[e].proxima = e + 1 < capacidade ? e + 1 : -1;
+    }
+    for (int b = 0; b < baldes; b++) {
+        cache->baldes[b] = -1;
+    }
+    cache->capacidade = capacidade;
+    cache->quantidade_baldes = baldes;
+    cache->mais_recente = -1;
+    cache->menos_recente = -1;
+    cache->livre = 0;
+    cache->geracao = 0;
+    cache->acertos = 0;
+    cache->falhas = 0;
+    return 1;
+}
+
+int buscar_cache_consultas(CacheConsultas* cache, unsigned long geracao, TipoConsultaCache tipo, int parametro,
+                           const char* chave, const void** dados, size_t* tamanho) {
+    if (cache == NULL || chave == NULL) {
+        return 0;
+    }
+    sincronizar_geracao(cache, geracao);
+
+    int e = localizar_entrada(cache, hash_pesquisa(tipo, parametro, chave), tipo, parametro, chave);
+    if (e < 0) {
+        cache->falhas++;
+        return 0;
+    }
+    desligar_lista(cache, e);
+    ligar_inicio(cache, e);
+    *dados = cache->entradas[e].dados;
+    *tamanho = cache->entradas[e].tamanho;
+    cache->acertos++;
+    return 1;
+}
+
+int guardar_cache_consultas(CacheConsultas* cache, unsigned long geracao, TipoConsultaCache tipo, int parametro,
+                            const char* chave, const void* dados, size_t tamanho) {
+    if (cache == NULL || chave == NULL) {
+        return 0;
+    }
+    sincronizar_geracao(cache, geracao);
+
+    unsigned int hash = hash_pesquisa(tipo, parametro, chave);
+    int existente = localizar_entrada(cache, hash, tipo, parametro, chave);
+    if (existente >= 0) {
+        descartar_entrada(cache, existente);
+    }
+
+    // Cópias feitas antes de ocupar a entrada: se falharem, o cache não muda.
+    size_t tamanho_chave = strlen(chave) + 1;
+    char* copia_chave = (char*) malloc(tamanho_chave);
+    void* copia_dados = tamanho > 0 ? malloc(tamanho) : NULL;
+    if (copia_chave == NULL || (tamanho > 0 && copia_dados == NULL)) {
+        perror("ERRO (guardar_cache_consultas): Falha ao alocar entrada do cache");
+        free(copia_chave);
+        free(copia_dados);
+        return 0;
+    }
+    memcpy(copia_chave, chave, tamanho_chave);
+    if (tamanho > 0) {
+        memcpy(copia_dados, dados, tamanho);
+    }
+
+    if (cache->livre < 0) {
+        descartar_entrada(cache, cache->menos_recente); // Cache cheio: sai a menos usada
+    }
+    int e = cache->livre;
+    EntradaCache* entrada = &cache->entradas[e];
+    cache->livre = entrada->proxima;
+
+    entrada->tipo = tipo;
+    entrada->parametro = parametro;
+    entrada->chave = copia_chave;
+    entrada->hash = hash;
+    entrada->dados = copia_dados;
+    entrada->tamanho = tamanho;
+    int balde = (int)(hash & (unsigned int)(cache->quantidade_baldes - 1));
+    entrada->proxima_hash = cache->baldes[balde];
+    cache->baldes[balde] = e;
+    ligar_inicio(cache, e);
+    return 1;
+}
+
+void liberar_cache_consultas(CacheConsultas* cache) {
+    if (cache == NULL || cache->entradas == NULL) {
+        return;
+    }
+    for (int e = 0; e < cache->capacidade; e++) {
+        free(cache->entradas[e].chave);
+        free(cache->entradas[e].dados);
+    }
+    free(cache->entradas);
+    free(cache->baldes);
+    cache->entradas = NULL;
+    cache->baldes = NULL;
+    cache->capacidade = 0;
+    cache->mais_recente = -1;
+    cache->menos_recente = -1;
+    cache->livre = -1;
+}
@@ -0,0 +1,104 @@
+#ifndef CACHE_CONSULTAS_H
+#define CACHE_CONSULTAS_H
+
+#include <stddef.h> // Para size_t
+
+/**
+ * @file cache_consultas.h
+ * @brief Define um cache LRU (menos recentemente usado) limitado de resultados de
+ * pesquisas, para que pesquisas repetidas entre duas alterações da coleção não sejam
+ * recalculadas.
+ *
+ * Cada entrada é identificada pelo tipo da pesquisa, por um parâmetro inteiro (ex:
+ * número de resultados pedidos) e pelo texto buscado, e guarda uma cópia dos
+ * resultados (bytes opacos para o cache). As entradas ficam em uma tabela hash
+ * encadeada, para a busca em O(1), e em uma lista duplamente encadeada em ordem de
+ * uso, para descartar a menos usada quando o cache está cheio.
+ *
+ * O cache guarda a geração da coleção (ver `geracao` em ColecaoLivros) em que seus
+ * resultados foram calculados. Toda operação informa a geração atual; se ela mudou
+ * (inserção, remoção, ordenação ou carga de arquivo), todas as entradas são
+ * descartadas antes, de modo que um resultado antigo nunca é devolvido.
+ */
+
+/** @brief Número padrão de entradas do cache. */
+#define CAPACIDADE_CACHE_PADRAO 64
+
+/**
+ * @brief Tipo de pesquisa cujos resultados estão em uma entrada.
+ */
+typedef enum {
+    CACHE_PESQUISA_TITULO,       ///< Posições dos livros cujo título contém o termo.
+    CACHE_PESQUISA_AUTOR,        ///< Posições dos livros cujo autor contém o termo.
+    CACHE_RELEVANCIA             ///< Resultados da busca por relevância.
+} TipoConsultaCache;
+
+/**
+ * @brief Entrada do cache.
+ */
+typedef struct {
+    TipoConsultaCache tipo;      ///< Tipo da pesquisa.
+    int parametro;               ///< Parâmetro inteiro da pesquisa (parte da chave).
+    char* chave;                 ///< Texto buscado (cópia própria; NULL = entrada livre).
+    unsigned int hash;           ///< Hash de (tipo, parâmetro, chave).
+    void* dados;                 ///< Cópia dos resultados (NULL se `tamanho` for 0).
+    size_t tamanho;              ///< Tamanho de `dados` em bytes.
+    int anterior;                ///< Entrada usada mais recentemente que esta (-1 = nenhuma).
+    int proxima;                 ///< Entrada usada menos recentemente (-1 = nenhuma); nas livres, a próxima livre.
+    int proxima_hash;            ///< Próxima entrada do mesmo balde da tabela hash (-1 = fim).
+} EntradaCache;
+
+/**
+ * @brief Estrutura do cache.
+ */
+typedef struct {
+    EntradaCache* entradas;      ///< Entradas (ocupadas e livres).
+    int capacidade;              ///< Número máximo de entradas.
+    int* baldes;                 ///< Tabela hash: primeira entrada de cada balde (-1 = vazio).
+    int quantidade_baldes;       ///< Número de baldes (potência de 2).
+    int mais_recente;            ///< Início da lista de uso (-1 = cache vazio).
+    int menos_recente;           ///< Fim da lista de uso; a próxima a ser descartada.
+    int livre;                   ///< Primeira entrada livre (-1 = nenhuma).
+    unsigned long geracao;       ///< Geração da coleção a que as entradas pertencem.
+    unsigned long acertos;       ///< Pesquisas atendidas pelo cache.
+    unsigned long falhas;        ///< Pesquisas não encontradas no cache.
+} CacheConsultas;
+
+// --- Protótipos das Funções ---
+
+/**
+ * @brief Inicializa um cache vazio com a capacidade informada.
+ * @param cache Ponteiro para o CacheConsultas. Não deve ser NULL.
+ * @param capacidade Número máximo de entradas (positivo).
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+int inicializar_cache_consultas(CacheConsultas* cache, int capacidade);
+
+/**
+ * @brief Procura os resultados de uma pesquisa e, se encontrados, marca a entrada
+ * como a mais recente.
+ * @param cache Ponteiro para o CacheConsultas.
+ * @param geracao Geração atual da coleção (entradas de outra geração são descartadas).
+ * @param dados Recebe os resultados (válidos até a próxima operação no cache).
+ * @param tamanho Recebe o tamanho dos resultados em bytes.
+ * @return int 1 se a pesquisa estava no cache, 0 caso contrário.
+ */
+int buscar_cache_consultas(CacheConsultas* cache, unsigned long geracao, TipoConsultaCache tipo, int parametro,
+                           const char* chave, const void** dados, size_t* tamanho);
+
+/**
+ * @brief Guarda uma cópia dos resultados de uma pesquisa, substituindo a entrada
+ * anterior da mesma pesquisa ou, com o cache cheio, a menos usada.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar (o cache continua válido,
+ * apenas sem a entrada).
+ */
+int guardar_cache_consultas(CacheConsultas* cache, unsigned long geracao, TipoConsultaCache tipo, int parametro,
+                            const char* chave, const void* dados, size_t tamanho);
+
+/**
+ * @brief Libera toda a memória do cache.
+ * @param cache Ponteiro para o CacheConsultas. Se NULL, a função não faz nada.
+ */
+void liberar_cache_consultas(CacheConsultas* cache);
+
+#endif // CACHE_CONSULTAS_H
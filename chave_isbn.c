@@ -0,0 +1,136 @@
+#include <stddef.h>
+#include "chave_isbn.h"
+
+/** @brief Maior número de dígitos de um ISBN (ISBN-13). */
+#define MAX_DIGITOS_ISBN 13
+/** @brief Valor usado para o caractere 'X' (vale 10 no dígito verificador do ISBN-10). */
+#define VALOR_X 10
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Extrai os "dígitos" do ISBN, ignorando hífens e espaços ('X'/'x' vale VALOR_X).
+ * @return int O número de dígitos extraídos, ou -1 se houver outro caractere ou
+ * mais de MAX_DIGITOS_ISBN dígitos.
+ */
+static int extrair_digitos(const char* isbn, int digitos[MAX_DIGITOS_ISBN]) {
+    int quantidade = 0;
+    for (; *isbn != '\0'; isbn++) {
+        char c = *isbn;
+        if (c == '-' || c == ' ') {
+            continue;
+        }
+        if (quantidade == MAX_DIGITOS_ISBN) {
+            return -1;
+        }
+        if (c >= '0' && c <= '9') {
+            digitos[quantidade++] = c - '0';
+        } else if (c == 'X' || c == 'x') {
+            digitos[quantidade++] = VALOR_X;
+        } else {
+            return -1;
+        }
+    }
+    return quantidade;
+}
+
+/**
+ * @brief Verifica o dígito verificador de um ISBN-10 (soma ponderada 10..1 múltipla de 11).
+ */
+static int isbn10_valido(const int digitos[]) {
+    int soma = 0;
+    for (int i = 0; i < 10; i++) {
+        if (digitos[i] == VALOR_X && i != 9) {
+            return 0; // 'X' só é permitido no dígito verificador
+        }
+        soma += (10 - i) * digitos[i];
+    }
+    return soma % 11 == 0;
+}
+
+/**
+ * @brief Verifica um ISBN-13 (prefixo 978/979 e soma ponderada 1,3,1,3... múltipla de 10).
+ */
+static int isbn13_valido(const int digitos[]) {
+    if (digitos[0] != 9 || digitos[1] != 7 || (digitos[2] != 8 && digitos[2] != 9)) {
+        return 0;
+    }
+    int soma = 0;
+    for (int i = 0; i < 13; i++) {
+        if (digitos[i] == VALOR_X) {
+            return 0;
+        }
+        soma += digitos[i] * (i % 2 == 0 ? 1 : 3);
+    }
+    return soma % 10 == 0;
+}
+
+/**
+ * @brief Chave textual: hash FNV-1a de 64 bits do texto, reduzido a 62 bits e marcado
+ * com CHAVE_ISBN_NAO_VALIDADA e CHAVE_ISBN_TEXTUAL (nunca colide com as demais chaves).
+ */
+static ChaveIsbn chave_textual(const char* isbn) {
+    ChaveIsbn hash = 0xCBF29CE484222325ull;
+    for (; *isbn != '\0'; isbn++) {
+        hash ^= (unsigned char) *isbn;
+        hash *= 0x100000001B3ull;
+    }
+    return CHAVE_ISBN_NAO_VALIDADA | CHAVE_ISBN_TEXTUAL | (hash & (CHAVE_ISBN_TEXTUAL - 1));
+}
+
+// --- FUNÇÕES DA CHAVE ---
+
+ChaveIsbn chave_isbn(const char* isbn) {
+    if (isbn == NULL) {
+        return CHAVE_ISBN_INVALIDA;
+    }
+
+    int digitos[MAX_DIGITOS_ISBN];
+    int quantidade = extrair_digitos(isbn, digitos);
+    if (quantidade <= 0) {
+        return chave_textual(isbn); // Não é um código de dígitos: o texto continua aceito
+    }
+
+    if (quantidade == 13 && isbn13_valido(digitos)) {
+        ChaveIsbn chave = 0;
+        for (int i = 0; i < 13; i++) {
+            chave = chave * 10 + (ChaveIsbn)digitos[i];
+        }
+        return chave;
+    }
+
+    if (quantidade == 10 && isbn10_valido(digitos)) {
+        // Converte para ISBN-13: prefixo 978, os 9 primeiros dígitos e um novo verificador.
+        ChaveIsbn chave = 978;
+        int soma = 9 * 1 + 7 * 3 + 8 * 1;
+        for (int i = 0; i < 9; i++) {
+            chave = chave * 10 + (ChaveIsbn)digitos[i];
+            soma += digitos[i] * ((i + 3) % 2 == 0 ? 1 : 3);
+        }
+        return chave * 10 + (ChaveIsbn)((10 - soma % 10) % 10);
+    }
+
+    // Código não validado: comprimento nos bits 48..51 e os dígitos em base 11
+    // (11^13 < 2^48), o que mantém códigos distintos com chaves distintas.
+    ChaveIsbn valor = 0;
+    for (int i = 0; i < quantidade; i++) {
+        valor = valor * 11 + (ChaveIsbn)digitos[i];
+    }
+    return CHAVE_ISBN_NAO_VALIDADA | ((ChaveIsbn)quantidade << 48) | valor;
+}
+
+int chave_isbn_validada(ChaveIsbn chave) {
+    return chave != CHAVE_ISBN_INVALIDA && (chave & CHAVE_ISBN_NAO_VALIDADA) == 0;
+}
+
+int chave_isbn_textual(ChaveIsbn chave) {
+    return (chave & (CHAVE_ISBN_NAO_VALIDADA | CHAVE_ISBN_TEXTUAL)) == (CHAVE_ISBN_NAO_VALIDADA | CHAVE_ISBN_TEXTUAL);
+}
+
+unsigned int hash_chave_isbn(ChaveIsbn chave) {
+    return (unsigned int)((chave * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+int comparar_chaves_isbn(ChaveIsbn a, ChaveIsbn b) {
+    return (a > b) - (a < b);
+}
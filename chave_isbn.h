@@ -0,0 +1,83 @@
+#ifndef CHAVE_ISBN_H
+#define CHAVE_ISBN_H
+
+#include <stdint.h> // Para uint64_t
+
+/**
+ * @file chave_isbn.h
+ * @brief Define a chave compacta de 64 bits que representa um ISBN normalizado.
+ *
+ * Na entrada de dados, o ISBN digitado (com ou sem hífens/espaços) é convertido
+ * uma única vez em um inteiro de 64 bits. A partir daí, hash, igualdade e ordenação
+ * de ISBNs são operações sobre inteiros, sem `strcmp`.
+ *
+ * - ISBN-13 válido (prefixo 978/979 e dígito verificador correto): a chave é o
+ *   próprio número de 13 dígitos.
+ * - ISBN-10 válido (dígito verificador correto, 'X' permitido na última posição):
+ *   é convertido para o ISBN-13 equivalente (prefixo 978), de modo que as duas
+ *   formas do mesmo livro têm a mesma chave.
+ * - Sequências de até 13 dígitos (e 'X') que não formam um ISBN válido continuam
+ *   aceitas (ex: códigos internos), mas recebem o bit CHAVE_ISBN_NAO_VALIDADA e
+ *   uma codificação sem colisões (comprimento + valor em base 11).
+ * - Qualquer outro texto (ex: "ABC-123", ou só hífens) também é aceito, com uma chave
+ *   textual: os bits CHAVE_ISBN_NAO_VALIDADA e CHAVE_ISBN_TEXTUAL e um hash de 62 bits
+ *   do texto. Como o hash pode colidir, quem encontra uma chave textual deve confirmar
+ *   o texto com `strcmp` (ver `localizar_livro_por_isbn` em lista_livros.h).
+ * - Apenas NULL resulta em CHAVE_ISBN_INVALIDA.
+ *
+ * A ordem numérica das chaves validadas é a ordem dos ISBN-13; chaves não
+ * validadas ficam todas depois delas, e as textuais por último (em ordem de hash).
+ */
+
+/** @brief Chave de ISBN normalizado (inteiro de 64 bits sem sinal). */
+typedef uint64_t ChaveIsbn;
+
+/** @brief Chave que indica um texto que não pode ser usado como ISBN. */
+#define CHAVE_ISBN_INVALIDA ((ChaveIsbn)0)
+
+/** @brief Bit que marca chaves de códigos aceitos sem dígito verificador válido. */
+#define CHAVE_ISBN_NAO_VALIDADA ((ChaveIsbn)1 << 63)
+
+/** @brief Bit que marca chaves textuais (hash de um texto que não é um código de dígitos). */
+#define CHAVE_ISBN_TEXTUAL ((ChaveIsbn)1 << 62)
+
+// --- Protótipos das Funções ---
+
+/**
+ * @brief Normaliza um ISBN textual em sua chave de 64 bits.
+ * Hífens e espaços são ignorados; 'x' minúsculo equivale a 'X'.
+ * @param isbn String constante com o ISBN. Se NULL, retorna CHAVE_ISBN_INVALIDA.
+ * @return ChaveIsbn A chave (textual, se o texto não for um código de dígitos), ou
+ * CHAVE_ISBN_INVALIDA se `isbn` for NULL.
+ */
+ChaveIsbn chave_isbn(const char* isbn);
+
+/**
+ * @brief Indica se a chave é textual (hash do texto, sujeita a colisões).
+ * @param chave Chave retornada por `chave_isbn`.
+ * @return int 1 se a chave é textual, 0 caso contrário.
+ */
+int chave_isbn_textual(ChaveIsbn chave);
+
+/**
+ * @brief Indica se a chave corresponde a um ISBN-10/13 com dígito verificador válido.
+ * @param chave Chave retornada por `chave_isbn`.
+ * @return int 1 se a chave é de um ISBN validado, 0 caso contrário.
+ */
+int chave_isbn_validada(ChaveIsbn chave);
+
+/**
+ * @brief Calcula o hash de 32 bits de uma chave (multiplicação de Fibonacci).
+ * Os bits altos do resultado são bem distribuídos, mesmo para chaves consecutivas.
+ * @param chave Chave de ISBN.
+ * @return unsigned int O valor do hash.
+ */
+unsigned int hash_chave_isbn(ChaveIsbn chave);
+
+/**
+ * @brief Compara duas chaves de ISBN (para uso em ordenações).
+ * @return int Negativo, zero ou positivo se `a` for menor, igual ou maior que `b`.
+ */
+int comparar_chaves_isbn(ChaveIsbn a, ChaveIsbn b);
+
+#endif // CHAVE_ISBN_H
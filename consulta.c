@@ -0,0 +1,360 @@
+#include <stdio.h>
+#include <stdlib.h> // Para malloc, free e qsort
+#include <string.h> // Para strlen e strstr
+#include "consulta.h"
+
+/**
+ * @brief Fração de livros suposta para uma substring sem índice de trigramas, usada
+ * apenas na estimativa de resultados.
+ */
+#define FRACAO_PADRAO_TEXTO 0.1
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Indica se um critério textual foi informado (não nulo e não vazio).
+ */
+static int texto_informado(const char* texto) {
+    return texto != NULL && texto[0] != '\0';
+}
+
+/**
+ * @brief Retorna uma cópia dobrada (minúsculas, sem acentos) do texto, ou NULL se o
+ * texto não foi informado. `*falhou` recebe 1 se a alocação falhar.
+ */
+static char* copiar_dobrado(const char* texto, int* falhou) {
+    if (!texto_informado(texto)) {
+        return NULL;
+    }
+    size_t tamanho = strlen(texto) + 1;
+    char* copia = (char*) malloc(tamanho);
+    if (copia == NULL) {
+        perror("ERRO (copiar_dobrado): Falha ao alocar criterio da consulta");
+        *falhou = 1;
+        return NULL;
+    }
+    dobrar_texto(texto, copia, tamanho);
+    return copia;
+}
+
+/**
+ * @brief Troca o caminho de acesso do plano se o novo entregar menos candidatos.
+ */
+static void considerar_acesso(PlanoConsulta* plano, AcessoConsulta acesso, int candidatos) {
+    if (candidatos < plano->candidatos_estimados) {
+        plano->acesso = acesso;
+        plano->candidatos_estimados = candidatos;
+    }
+}
+
+/**
+ * @brief Converte os critérios da consulta para a forma usada na verificação
+ * (chave de ISBN, ID do gênero, textos dobrados) e escolhe o plano.
+ * @return int 1 em caso de sucesso, 0 se uma alocação falhar.
+ */
+static int preparar_criterios(CursorConsulta* cursor, const ColecaoLivros* colecao, const Consulta* consulta) {
+    const ArmazemLivros* armazem = &colecao->armazem;
+    int total = armazem->quantidade;
+    int impossivel = 0;
+    int falhou = 0;
+    double fracao = 1.0; // Fração estimada de livros que satisfazem todos os critérios
+
+    cursor->chave_isbn = CHAVE_ISBN_INVALIDA;
+    cursor->id_genero = -1;
+    cursor->ano_minimo = consulta->ano_minimo;
+    cursor->ano_maximo = consulta->ano_maximo;
+    cursor->titulo_dobrado = copiar_dobrado(consulta->titulo, &falhou);
+    cursor->autor_dobrado = copiar_dobrado(consulta->autor, &falhou);
+    cursor->plano.acesso = ACESSO_VARREDURA;
+    cursor->plano.candidatos_estimados = total;
+    if (falhou) {
+        return 0;
+    }
+
+    if (texto_informado(consulta->isbn)) {
+        // Chaves textuais são confirmadas pelo texto; se o livro existe, sua chave é única
+        cursor->chave_isbn = chave_isbn(consulta->isbn);
+        if (localizar_livro_por_isbn(colecao, consulta->isbn) < 0) {
+            impossivel = 1;
+        } else {
+            considerar_acesso(&cursor->plano, ACESSO_ISBN, 1);
+            fracao *= 1.0 / total;
+        }
+    }
+
+    if (texto_informado(consulta->genero)) {
+        // O conjunto do gênero no índice de gêneros dá a contagem exata.
+        cursor->id_genero = buscar_id_texto(&armazem->generos, consulta->genero);
+        int do_genero = contar_genero(&colecao->indice_generos, cursor->id_genero);
+        if (do_genero == 0) {
+            impossivel = 1;
+        } else {
+            considerar_acesso(&cursor->plano, ACESSO_INDICE_GENEROS, do_genero);
+            fracao *= (double)do_genero / total;
+        }
+    }
+
+    if (cursor->ano_minimo != ANO_CONSULTA_MINIMO || cursor->ano_maximo != ANO_CONSULTA_MAXIMO) {
+        // O índice de anos dá a contagem exata do intervalo.
+        int no_intervalo = cursor->ano_minimo <= cursor->ano_maximo
+                               ? contar_intervalo_anos(&colecao->indice_anos, cursor->ano_minimo, cursor->ano_maximo)
+                               : 0;
+        if (no_intervalo == 0) {
+            impossivel = 1;
+        } else {
+            considerar_acesso(&cursor->plano, ACESSO_INDICE_ANOS, no_intervalo);
+            fracao *= (double)no_intervalo / total;
+        }
+    }
+
+    // Substrings: a menor lista de trigramas do termo limita os candidatos do índice.
+    const char* termos[2] = { cursor->titulo_dobrado, cursor->autor_dobrado };
+    const IndiceTrigramas* indices[2] = { colecao->indice_titulos, colecao->indice_autores };
+    const AcessoConsulta acessos[2] = { ACESSO_TRIGRAMAS_TITULO, ACESSO_TRIGRAMAS_AUTOR };
+    for (int i = 0; i < 2; i++) {
+        if (termos[i] == NULL) {
+            continue;
+        }
+        int estimativa = indices[i] != NULL ? estimar_candidatos_trigramas(indices[i], termos[i]) : -1;
+        if (estimativa == 0) {
+            impossivel = 1;
+        } else if (estimativa > 0) {
+            considerar_acesso(&cursor->plano, acessos[i], estimativa);
+            fracao *= (double)estimativa / total;
+        } else {
+            fracao *= FRACAO_PADRAO_TEXTO;
+        }
+    }
+
+    if (impossivel || total == 0) {
+        cursor->plano.acesso = ACESSO_NENHUM;
+        cursor->plano.candidatos_estimados = 0;
+        cursor->plano.resultados_estimados = 0.0;
+        return 1;
+    }
+    cursor->plano.resultados_estimados = fracao * total;
+    if (cursor->plano.resultados_estimados > cursor->plano.candidatos_estimados) {
+        cursor->plano.resultados_estimados = cursor->plano.candidatos_estimados;
+    }
+    return 1;
+}
+
+/**
+ * @brief Função de comparação para qsort de posições (inteiros em ordem crescente).
+ */
+static int comparar_posicoes_consulta(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Calcula as posições candidatas do caminho de acesso escolhido, em ordem crescente.
+ * Se os candidatos do índice não puderem ser calculados, volta para a varredura.
+ * @return int 1 em caso de sucesso, 0 se uma alocação falhar.
+ */
+static int preparar_candidatos(CursorConsulta* cursor, const ColecaoLivros* colecao) {
+    const ArmazemLivros* armazem = &colecao->armazem;
+    int* candidatos = NULL;
+    int quantidade = 0;
+
+    switch (cursor->plano.acesso) {
+        case ACESSO_ISBN:
+            candidatos = (int*) malloc(sizeof(int));
+            if (candidatos == NULL) {
+                perror("ERRO (preparar_candidatos): Falha ao alocar candidatos");
+                return 0;
+            }
+            candidatos[0] = buscar_handle_indice_isbn(&colecao->indice_isbn, cursor->chave_isbn);
+            quantidade = 1;
+            break;
+        case ACESSO_INDICE_ANOS:
+            if (!listar_intervalo_anos(&colecao->indice_anos, cursor->ano_minimo, cursor->ano_maximo,
+                                       &candidatos, &quantidade)) {
+                cursor->plano.acesso = ACESSO_VARREDURA;
+                return 1;
+            }
+            break;
+        case ACESSO_INDICE_GENEROS: {
+            const BitmapHandles* conjunto = conjunto_do_genero(&colecao->indice_generos, cursor->id_genero);
+            candidatos = (int*) malloc((size_t)conjunto->cardinalidade * sizeof(int));
+            if (candidatos == NULL) {
+                perror("ERRO (preparar_candidatos): Falha ao alocar candidatos");
+                return 0;
+            }
+            IteradorBitmap iterador;
+            iniciar_iterador_bitmap(&iterador, conjunto);
+            for (int handle = proximo_bitmap(&iterador); handle >= 0; handle = proximo_bitmap(&iterador)) {
+                candidatos[quantidade++] = handle;
+            }
+            break;
+        }
+        case ACESSO_TRIGRAMAS_TITULO:
+        case ACESSO_TRIGRAMAS_AUTOR: {
+            int titulo = cursor->plano.acesso == ACESSO_TRIGRAMAS_TITULO;
+            if (!buscar_candidatos_trigramas(titulo ? colecao->indice_titulos : colecao->indice_autores,
+                                             titulo ? cursor->titulo_dobrado : cursor->autor_dobrado,
+                                             &candidatos, &quantidade)) {
+                cursor->plano.acesso = ACESSO_VARREDURA;
+                return 1;
+            }
+            break;
+        }
+        default:
+            return 1; // Nenhum candidato, ou todas as posições
+    }
+
+    // Se o gênero é um critério residual, os candidatos fora do conjunto do gênero são
+    // descartados já aqui (E com o conjunto), sem ler os registros nem ordená-los.
+    if (cursor->id_genero >= 0 && cursor->plano.acesso != ACESSO_INDICE_GENEROS) {
+        const BitmapHandles* conjunto = conjunto_do_genero(&colecao->indice_generos, cursor->id_genero);
+        int mantidos = 0;
+        for (int i = 0; i < quantidade; i++) {
+            if (contem_bitmap(conjunto, candidatos[i])) {
+                candidatos[mantidos++] = candidatos[i];
+            }
+        }
+        quantidade = mantidos;
+    }
+
+    // Handles -> posições, na ordem da coleção (o vetor de handles é reaproveitado).
+    for (int i = 0; i < quantidade; i++) {
+        candidatos[i] = posicao_do_handle(armazem, candidatos[i]);
+    }
+    if (quantidade > 1) {
+        qsort(candidatos, (size_t)quantidade, sizeof(int), comparar_posicoes_consulta);
+    }
+    cursor->posicoes = candidatos;
+    cursor->total_posicoes = quantidade;
+    return 1;
+}
+
+/**
+ * @brief Verifica todos os critérios em um registro, dos mais baratos (comparações de
+ * inteiros) aos mais caros (substrings).
+ */
+static int registro_aceito(const CursorConsulta* cursor, const ArmazemLivros* armazem, const RegistroLivro* registro) {
+    if (cursor->chave_isbn != CHAVE_ISBN_INVALIDA && registro->chave_isbn != cursor->chave_isbn) {
+        return 0;
+    }
+    if (registro->anoPublicacao < cursor->ano_minimo || registro->anoPublicacao > cursor->ano_maximo) {
+        return 0;
+    }
+    if (cursor->id_genero >= 0 && registro->id_genero != cursor->id_genero) {
+        return 0;
+    }
+    if (cursor->titulo_dobrado != NULL && strstr(titulo_dobrado_registro(armazem, registro), cursor->titulo_dobrado) == NULL) {
+        return 0;
+    }
+    if (cursor->autor_dobrado != NULL && strstr(autor_dobrado_registro(armazem, registro), cursor->autor_dobrado) == NULL) {
+        return 0;
+    }
+    return 1;
+}
+
+// --- FUNÇÕES DA CONSULTA ---
+
+void inicializar_consulta(Consulta* consulta) {
+    consulta->isbn = NULL;
+    consulta->titulo = NULL;
+    consulta->autor = NULL;
+    consulta->genero = NULL;
+    consulta->ano_minimo = ANO_CONSULTA_MINIMO;
+    consulta->ano_maximo = ANO_CONSULTA_MAXIMO;
+}
+
+int planejar_consulta(const ColecaoLivros* colecao, const Consulta* consulta, PlanoConsulta* plano) {
+    if (colecao == NULL || consulta == NULL || plano == NULL) {
+        return 0;
+    }
+    CursorConsulta cursor;
+    cursor.posicoes = NULL;
+    int sucesso = preparar_criterios(&cursor, colecao, consulta);
+    *plano = cursor.plano;
+    encerrar_cursor_consulta(&cursor);
+    return sucesso;
+}
+
+int iniciar_cursor_consulta(CursorConsulta* cursor, const ColecaoLivros* colecao, const Consulta* consulta) {
+    if (cursor == NULL) {
+        return 0;
+    }
+    cursor->titulo_dobrado = NULL;
+    cursor->autor_dobrado = NULL;
+    cursor->posicoes = NULL;
+    cursor->total_posicoes = 0;
+    cursor->proxima = 0;
+    cursor->plano.acesso = ACESSO_NENHUM;
+    if (colecao == NULL || consulta == NULL) {
+        return 0;
+    }
+
+    if (!preparar_criterios(cursor, colecao, consulta) || !preparar_candidatos(cursor, colecao)) {
+        cursor->plano.acesso = ACESSO_NENHUM; // O cursor não entrega resultados
+        return 0;
+    }
+    return 1;
+}
+
+int proximo_resultado_consulta(const ColecaoLivros* colecao, CursorConsulta* cursor) {
+    if (colecao == NULL || cursor == NULL || cursor->plano.acesso == ACESSO_NENHUM) {
+        return HANDLE_INVALIDO;
+    }
+
+    const ArmazemLivros* armazem = &colecao->armazem;
+    int varredura = cursor->plano.acesso == ACESSO_VARREDURA;
+    int limite = varredura ? armazem->quantidade : cursor->total_posicoes;
+    while (cursor->proxima < limite) {
+        int posicao = varredura ? cursor->proxima : cursor->posicoes[cursor->proxima];
+        cursor->proxima++;
+        if (registro_aceito(cursor, armazem, &armazem->registros[posicao])) {
+            return armazem->handle_de_posicao[posicao];
+        }
+    }
+    return HANDLE_INVALIDO;
+}
+
+void encerrar_cursor_consulta(CursorConsulta* cursor) {
+    if (cursor == NULL) {
+        return;
+    }
+    free(cursor->titulo_dobrado);
+    free(cursor->autor_dobrado);
+    free(cursor->posicoes);
+    cursor->titulo_dobrado = NULL;
+    cursor->autor_dobrado = NULL;
+    cursor->posicoes = NULL;
+    cursor->total_posicoes = 0;
+}
+
+int executar_consulta(const ColecaoLivros* colecao, const Consulta* consulta, VisitanteLivro visitar, void* contexto) {
+    if (colecao == NULL || consulta == NULL || visitar == NULL) {
+        return 0;
+    }
+
+    CursorConsulta cursor;
+    iniciar_cursor_consulta(&cursor, colecao, consulta);
+    int entregues = 0;
+    int handle;
+    while ((handle = proximo_resultado_consulta(colecao, &cursor)) != HANDLE_INVALIDO) {
+        entregues++;
+        if (!visitar(&colecao->armazem, obter_registro_armazem(&colecao->armazem, handle), handle, contexto)) {
+            break; // Interrompida por quem pediu a consulta
+        }
+    }
+    encerrar_cursor_consulta(&cursor);
+    return entregues;
+}
+
+const char* descrever_acesso_consulta(AcessoConsulta acesso) {
+    switch (acesso) {
+        case ACESSO_NENHUM:           return "nenhum (criterio sem correspondencia)";
+        case ACESSO_ISBN:             return "indice de ISBN";
+        case ACESSO_INDICE_ANOS:      return "indice de anos";
+        case ACESSO_INDICE_GENEROS:   return "indice de generos";
+        case ACESSO_TRIGRAMAS_TITULO: return "indice de trigramas de titulos";
+        case ACESSO_TRIGRAMAS_AUTOR:  return "indice de trigramas de autores";
+        case ACESSO_VARREDURA:        return "varredura da colecao";
+    }
+    return "desconhecido";
+}
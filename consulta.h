@@ -0,0 +1,133 @@
+#ifndef CONSULTA_H
+#define CONSULTA_H
+
+#include <limits.h>             // Para INT_MIN e INT_MAX
+#include "lista_livros.h"       // ColecaoLivros e seus índices
+#include "pesquisa_ordenacao.h" // VisitanteLivro
+
+/**
+ * @file consulta.h
+ * @brief Define consultas com vários critérios combinados (E lógico) sobre a coleção,
+ * como "autor contém X E ano entre 1990 e 2000 E gênero = Fantasia".
+ *
+ * Um planejador simples estima, para cada critério que tem um índice disponível,
+ * quantos livros o índice entregaria (seletividade) e escolhe o caminho de acesso
+ * mais barato: o índice de ISBN, o índice de anos, o índice de gêneros, um índice de
+ * trigramas (título ou autor) ou, se nenhum ajudar, a varredura da coleção. Os demais
+ * critérios são verificados em cada candidato (filtros residuais), dos mais baratos aos
+ * mais caros; o gênero residual é testado no conjunto do índice de gêneros antes de ler
+ * o registro.
+ *
+ * Os resultados saem um a um (cursor ou função de visita), na ordem da coleção.
+ */
+
+/** @brief Valores de `ano_minimo`/`ano_maximo` que não restringem o ano. */
+#define ANO_CONSULTA_MINIMO INT_MIN
+#define ANO_CONSULTA_MAXIMO INT_MAX
+
+/**
+ * @brief Critérios de uma consulta. Critérios NULL (ou texto vazio) não restringem.
+ */
+typedef struct {
+    const char* isbn;            ///< ISBN exato (normalizado como na coleção).
+    const char* titulo;          ///< Substring do título (sem diferenciar maiúsculas nem acentos).
+    const char* autor;           ///< Substring do autor (sem diferenciar maiúsculas nem acentos).
+    const char* genero;          ///< Gênero exato (comparação literal).
+    int ano_minimo;              ///< Menor ano aceito (inclusive).
+    int ano_maximo;              ///< Maior ano aceito (inclusive).
+} Consulta;
+
+/**
+ * @brief Caminho de acesso escolhido pelo planejador.
+ */
+typedef enum {
+    ACESSO_NENHUM,               ///< Algum critério não pode ser satisfeito: nenhum livro é examinado.
+    ACESSO_ISBN,                 ///< Índice hash de ISBN (no máximo um candidato).
+    ACESSO_INDICE_ANOS,          ///< Baldes do índice de anos dentro do intervalo.
+    ACESSO_INDICE_GENEROS,       ///< Conjunto do gênero no índice de gêneros.
+    ACESSO_TRIGRAMAS_TITULO,     ///< Candidatos do índice de trigramas de títulos.
+    ACESSO_TRIGRAMAS_AUTOR,      ///< Candidatos do índice de trigramas de autores.
+    ACESSO_VARREDURA             ///< Todos os livros da coleção.
+} AcessoConsulta;
+
+/**
+ * @brief Plano de execução de uma consulta.
+ */
+typedef struct {
+    AcessoConsulta acesso;       ///< Caminho de acesso escolhido.
+    int candidatos_estimados;    ///< Livros que o caminho de acesso deve entregar (custo).
+    double resultados_estimados; ///< Estimativa de resultados (critérios supostos independentes).
+} PlanoConsulta;
+
+/**
+ * @brief Estado de uma consulta percorrida aos poucos.
+ * @warning Como o CursorPesquisa, só é válido enquanto a coleção não for modificada.
+ * Ao terminar, libere-o com `encerrar_cursor_consulta`.
+ */
+typedef struct {
+    PlanoConsulta plano;         ///< Plano escolhido em `iniciar_cursor_consulta`.
+    ChaveIsbn chave_isbn;        ///< Chave do ISBN buscado (CHAVE_ISBN_INVALIDA = qualquer).
+    int id_genero;               ///< ID do gênero buscado (-1 = qualquer).
+    int ano_minimo;              ///< Menor ano aceito.
+    int ano_maximo;              ///< Maior ano aceito.
+    char* titulo_dobrado;        ///< Substring dobrada do título (NULL = qualquer).
+    char* autor_dobrado;         ///< Substring dobrada do autor (NULL = qualquer).
+    int* posicoes;               ///< Posições candidatas em ordem crescente (NULL = todas).
+    int total_posicoes;          ///< Número de posições candidatas.
+    int proxima;                 ///< Próxima posição (ou índice em `posicoes`) a examinar.
+} CursorConsulta;
+
+// --- Protótipos das Funções ---
+
+/**
+ * @brief Inicializa uma consulta sem critérios (aceita todos os livros).
+ * @param consulta Ponteiro para a Consulta. Não deve ser NULL.
+ */
+void inicializar_consulta(Consulta* consulta);
+
+/**
+ * @brief Escolhe o caminho de acesso de uma consulta, sem executá-la.
+ * @param colecao Ponteiro constante para a ColecaoLivros.
+ * @param consulta Critérios da consulta.
+ * @param plano Recebe o plano escolhido.
+ * @return int 1 em caso de sucesso, 0 se os parâmetros forem inválidos.
+ */
+int planejar_consulta(const ColecaoLivros* colecao, const Consulta* consulta, PlanoConsulta* plano);
+
+/**
+ * @brief Planeja a consulta e prepara o cursor (os critérios são copiados).
+ * @param cursor Ponteiro para o CursorConsulta a ser inicializado.
+ * @param colecao Ponteiro constante para a ColecaoLivros consultada.
+ * @param consulta Critérios da consulta.
+ * @return int 1 em caso de sucesso, 0 se os parâmetros forem inválidos ou uma alocação
+ * falhar (o cursor fica vazio, mas pode ser encerrado normalmente).
+ */
+int iniciar_cursor_consulta(CursorConsulta* cursor, const ColecaoLivros* colecao, const Consulta* consulta);
+
+/**
+ * @brief Avança o cursor até o próximo livro que satisfaz todos os critérios.
+ * @param colecao Ponteiro constante para a mesma ColecaoLivros de `iniciar_cursor_consulta`.
+ * @param cursor Cursor inicializado.
+ * @return int O handle do livro, ou HANDLE_INVALIDO se não houver mais resultados.
+ */
+int proximo_resultado_consulta(const ColecaoLivros* colecao, CursorConsulta* cursor);
+
+/**
+ * @brief Libera a memória do cursor.
+ * @param cursor Ponteiro para o CursorConsulta. Se NULL, a função não faz nada.
+ */
+void encerrar_cursor_consulta(CursorConsulta* cursor);
+
+/**
+ * @brief Executa a consulta, entregando cada resultado à função `visitar` (na ordem
+ * da coleção) até o fim ou até `visitar` retornar 0.
+ * @return int O número de livros entregues a `visitar`.
+ */
+int executar_consulta(const ColecaoLivros* colecao, const Consulta* consulta, VisitanteLivro visitar, void* contexto);
+
+/**
+ * @brief Nome legível de um caminho de acesso (para exibir o plano).
+ */
+const char* descrever_acesso_consulta(AcessoConsulta acesso);
+
+#endif // CONSULTA_H
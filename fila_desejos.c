@@ -22,6 +22,7 @@ FilaDesejos* criar_fila_desejos() {
     fila->inicio = NULL;
     fila->fim = NULL;
     fila->quantidade = 0; // Aprimoramento: adicionar contador de elementos
+    inicializar_pool_nos(&fila->pool_nos, sizeof(NoFila), 0);
     return fila;
 }
 
@@ -57,10 +58,9 @@ void enqueue_desejo(FilaDesejos* fila, Livro livro) {
         return;
     }
 
-    NoFila* novo_no = (NoFila*) malloc(sizeof(NoFila));
+    NoFila* novo_no = (NoFila*) alocar_no_pool(&fila->pool_nos);
     if (novo_no == NULL) {
-        perror("ERRO: Falha ao alocar memoria para novo no da fila de desejos");
-        return;
+        return; // O pool já reporta a falha de alocação
     }
 
     novo_no->livro_desejado = livro; // Copia a struct inteira
@@ -119,7 +119,7 @@ int dequeue_desejo(FilaDesejos* fila, Livro* livro_removido) {
         fila->fim = NULL;
     }
 
-    free(no_removido_ptr);
+    liberar_no_pool(&fila->pool_nos, no_removido_ptr);
     fila->quantidade--; // Aprimoramento: decrementar contador
     return 1; // Sucesso
 }
@@ -154,7 +154,7 @@ int front_desejo(const FilaDesejos* fila, Livro* livro_frente) {
 /**
  * @brief Libera toda a memória alocada para a fila de desejos.
  *
- * Remove todos os elementos restantes da fila (liberando cada nó)
+ * Libera de uma só vez todos os nós restantes (blocos do pool da fila)
  * e, em seguida, libera a própria estrutura da fila.
  * Após esta chamada, o ponteiro 'fila' não deve mais ser usado.
  *
@@ -166,10 +166,7 @@ void destruir_fila_desejos(FilaDesejos* fila) {
         return;
     }
 
-    Livro livro_temp; // Variável temporária para o dequeue
-    while (!fila_desejos_vazia(fila)) {
-        dequeue_desejo(fila, &livro_temp); // Descarta o livro, apenas libera o nó
-    }
+    liberar_todos_nos_pool(&fila->pool_nos); // Descarta todos os nós sem percorrer a fila
 
     free(fila);
 }
@@ -2,6 +2,7 @@
 #define FILA_DESEJOS_H
 
 #include "livro.h" // Necessário para a definição da struct Livro
+#include "pool_nos.h" // Alocador em blocos usado para os nós da fila
 
 /**
  * @file fila_desejos.h
@@ -35,6 +36,7 @@ typedef struct {
     NoFila* inicio;      ///< Ponteiro para o primeiro nó da fila (ou NULL se vazia).
     NoFila* fim;         ///< Ponteiro para o último nó da fila (ou NULL se vazia).
     int quantidade;      ///< Número de elementos atualmente na fila.
+    PoolNos pool_nos;    ///< Pool de onde os nós da fila são alocados (liberado de uma só vez).
 } FilaDesejos;
 
 // --- Protótipos das Funções ---
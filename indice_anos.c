@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h> // Para malloc, realloc e free
+#include <string.h> // Para memmove e memcpy
+#include "indice_anos.h"
+
+/** @brief Capacidades iniciais dos vetores do índice. */
+#define CAPACIDADE_INICIAL_BALDES 16
+#define CAPACIDADE_INICIAL_BALDE 8
+#define CAPACIDADE_INICIAL_POSICOES 64
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Garante que `posicao_no_balde` tenha uma entrada para o handle.
+ */
+static int garantir_capacidade_handles(IndiceAnos* indice, int handle) {
+    if (handle < indice->capacidade_handles) {
+        return 1;
+    }
+    int nova = indice->capacidade_handles > 0 ? indice->capacidade_handles : CAPACIDADE_INICIAL_POSICOES;
+    while (nova <= handle) {
+        nova *= 2;
+    }
+    int* posicoes = (int*) realloc(indice->posicao_no_balde, (size_t)nova * sizeof(int));
+    if (posicoes == NULL) {
+        perror("ERRO (garantir_capacidade_handles): Falha ao alocar indice de anos");
+        return 0;
+    }
+    indice->posicao_no_balde = posicoes;
+    indice->capacidade_handles = nova;
+    return 1;
+}
+
+/**
+ * @brief Retorna o índice do balde do ano, criando-o na posição ordenada se preciso.
+ * @return int O índice do balde, ou -1 se a alocação falhar.
+ */
+static int obter_balde(IndiceAnos* indice, int ano) {
+    int posicao = primeiro_balde_anos(indice, ano);
+    if (posicao < indice->quantidade_baldes && indice->baldes[posicao].ano == ano) {
+        return posicao;
+    }
+
+    if (indice->quantidade_baldes == indice->capacidade_baldes) {
+        int nova = indice->capacidade_baldes > 0 ? indice->capacidade_baldes * 2 : CAPACIDADE_INICIAL_BALDES;
+        BaldeAno* baldes = (BaldeAno*) realloc(indice->baldes, (size_t)nova * sizeof(BaldeAno));
+        if (baldes == NULL) {
+            perror("ERRO (obter_balde): Falha ao alocar baldes de anos");
+            return -1;
+        }
+        indice->baldes = baldes;
+        indice->capacidade_baldes = nova;
+    }
+    memmove(&indice->baldes[posicao + 1], &indice->baldes[posicao],
+            (size_t)(indice->quantidade_baldes - posicao) * sizeof(BaldeAno));
+    indice->baldes[posicao].ano = ano;
+    indice->baldes[posicao].handles = NULL;
+    indice->baldes[posicao].quantidade = 0;
+    indice->baldes[posicao].capacidade = 0;
+    indice->quantidade_baldes++;
+    return posicao;
+}
+
+// --- FUNÇÕES DO ÍNDICE ---
+
+void inicializar_indice_anos(IndiceAnos* indice) {
+    indice->baldes = NULL;
+    indice->quantidade_baldes = 0;
+    indice->capacidade_baldes = 0;
+    indice->posicao_no_balde = NULL;
+    indice->capacidade_handles = 0;
+    indice->total = 0;
+}
+
+int primeiro_balde_anos(const IndiceAnos* indice, int ano) {
+    int inicio = 0;
+    int fim = indice->quantidade_baldes;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (indice->baldes[meio].ano < ano) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return inicio;
+}
+
+int inserir_indice_anos(IndiceAnos* indice, int ano, int handle) {
+    if (indice == NULL || handle < 0 || !garantir_capacidade_handles(indice, handle)) {
+        return 0;
+    }
+    int b = obter_balde(indice, ano);
+    if (b < 0) {
+        return 0;
+    }
+
+    BaldeAno* balde = &indice->baldes[b];
+    if (balde->quantidade == balde->capacidade) {
+        int nova = balde->capacidade > 0 ? balde->capacidade * 2 : CAPACIDADE_INICIAL_BALDE;
+        int* handles = (int*) realloc(balde->handles, (size_t)nova * sizeof(int));
+        if (handles == NULL) {
+            perror("ERRO (inserir_indice_anos): Falha ao alocar balde de ano");
+            return 0; // Um balde recém-criado fica vazio, o que é permitido
+        }
+        balde->handles = handles;
+        balde->capacidade = nova;
+    }
+    indice->posicao_no_balde[handle] = balde->quantidade;
+    balde->handles[balde->quantidade++] = handle;
+    indice->total++;
+    return 1;
+}
+
+void remover_indice_anos(IndiceAnos* indice, int ano, int handle) {
+    if (indice == NULL || handle < 0 || handle >= indice->capacidade_handles) {
+        return;
+    }
+    int b = primeiro_balde_anos(indice, ano);
+    if (b == indice->quantidade_baldes || indice->baldes[b].ano != ano) {
+        return;
+    }
+
+    BaldeAno* balde = &indice->baldes[b];
+    int posicao = indice->posicao_no_balde[handle];
+    if (posicao < 0 || posicao >= balde->quantidade || balde->handles[posicao] != handle) {
+        return; // Handle não está neste balde
+    }
+    int ultimo = balde->handles[--balde->quantidade];
+    balde->handles[posicao] = ultimo;
+    indice->posicao_no_balde[ultimo] = posicao;
+    indice->total--;
+}
+
+int contar_intervalo_anos(const IndiceAnos* indice, int ano_minimo, int ano_maximo) {
+    if (indice == NULL) {
+        return 0;
+    }
+    int total = 0;
+    for (int b = primeiro_balde_anos(indice, ano_minimo);
+         b < indice->quantidade_baldes && indice->baldes[b].ano <= ano_maximo; b++) {
+        total += indice->baldes[b].quantidade;
+    }
+    return total;
+}
+
+int listar_intervalo_anos(const IndiceAnos* indice, int ano_minimo, int ano_maximo, int** handles, int* quantidade) {
+    *handles = NULL;
+    *quantidade = 0;
+    int total = contar_intervalo_anos(indice, ano_minimo, ano_maximo);
+    if (total == 0) {
+        return 1;
+    }
+
+    int* lista = (int*) malloc((size_t)total * sizeof(int));
+    if (lista == NULL) {
+        perror("ERRO (listar_intervalo_anos): Falha ao alocar handles");
+        return 0;
+    }
+    int escritos = 0;
+    for (int b = primeiro_balde_anos(indice, ano_minimo);
+         b < indice->quantidade_baldes && indice->baldes[b].ano <= ano_maximo; b++) {
+        memcpy(&lista[escritos], indice->baldes[b].handles, (size_t)indice->baldes[b].quantidade * sizeof(int));
+        escritos += indice->baldes[b].quantidade;
+    }
+    *handles = lista;
+    *quantidade = total;
+    return 1;
+}
+
+void liberar_indice_anos(IndiceAnos* indice) {
+    if (indice == NULL) {
+        return;
+    }
+    for (int b = 0; b < indice->quantidade_baldes; b++) {
+        free(indice->baldes[b].handles);
+    }
+    free(indice->baldes);
+    free(indice->posicao_no_balde);
+    inicializar_indice_anos(indice);
+}
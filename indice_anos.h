@@ -0,0 +1,96 @@
+#ifndef INDICE_ANOS_H
+#define INDICE_ANOS_H
+
+/**
+ * @file indice_anos.h
+ * @brief Define o índice secundário ordenado por ano de publicação.
+ *
+ * O índice é um vetor de baldes, um por ano distinto, em ordem crescente de ano; cada
+ * balde guarda os handles dos livros daquele ano. Como os anos distintos são poucos
+ * (algumas centenas), inserir um ano novo desloca poucos baldes, e uma consulta por
+ * intervalo encontra o primeiro balde por busca binária e percorre apenas os baldes
+ * do intervalo: O(log A + K) para listar K livros e O(log A + anos no intervalo)
+ * para contar.
+ *
+ * Para remover um handle em O(1), o índice guarda, para cada handle, sua posição no
+ * balde; o último handle do balde ocupa o lugar do removido (a ordem dentro de um
+ * ano não é significativa).
+ */
+
+/**
+ * @brief Livros de um mesmo ano de publicação.
+ */
+typedef struct {
+    int ano;                     ///< Ano de publicação.
+    int* handles;                ///< Handles dos livros do ano (sem ordem).
+    int quantidade;              ///< Número de handles no balde.
+    int capacidade;              ///< Capacidade alocada de `handles`.
+} BaldeAno;
+
+/**
+ * @brief Estrutura do índice de anos.
+ */
+typedef struct {
+    BaldeAno* baldes;            ///< Baldes em ordem crescente de ano (baldes vazios são mantidos).
+    int quantidade_baldes;       ///< Número de anos distintos já vistos.
+    int capacidade_baldes;       ///< Capacidade alocada de `baldes`.
+    int* posicao_no_balde;       ///< Para cada handle indexado, sua posição em `handles` do balde.
+    int capacidade_handles;      ///< Capacidade alocada de `posicao_no_balde`.
+    int total;                   ///< Número de handles indexados.
+} IndiceAnos;
+
+// --- Protótipos das Funções ---
+
+/**
+ * @brief Inicializa um índice vazio. Nenhuma memória é alocada até a primeira inserção.
+ * @param indice Ponteiro para o IndiceAnos. Não deve ser NULL.
+ */
+void inicializar_indice_anos(IndiceAnos* indice);
+
+/**
+ * @brief Indexa o handle no balde do ano (criando o balde, se preciso).
+ * @param indice Ponteiro para o IndiceAnos.
+ * @param ano Ano de publicação do livro.
+ * @param handle Handle (não negativo) do registro.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar (nada é indexado).
+ */
+int inserir_indice_anos(IndiceAnos* indice, int ano, int handle);
+
+/**
+ * @brief Remove o handle do balde do ano. Handles ausentes são ignorados.
+ * @param indice Ponteiro para o IndiceAnos.
+ * @param ano Ano informado na inserção.
+ * @param handle Handle do registro removido.
+ */
+void remover_indice_anos(IndiceAnos* indice, int ano, int handle);
+
+/**
+ * @brief Primeiro balde cujo ano é maior ou igual a `ano` (busca binária).
+ * @return int O índice do balde, ou `quantidade_baldes` se todos os anos forem menores.
+ */
+int primeiro_balde_anos(const IndiceAnos* indice, int ano);
+
+/**
+ * @brief Conta os livros com ano no intervalo fechado [ano_minimo, ano_maximo].
+ * @param indice Ponteiro constante para o IndiceAnos.
+ * @return int O número de livros no intervalo.
+ */
+int contar_intervalo_anos(const IndiceAnos* indice, int ano_minimo, int ano_maximo);
+
+/**
+ * @brief Lista os handles dos livros com ano no intervalo, em ordem crescente de ano.
+ * @param indice Ponteiro constante para o IndiceAnos.
+ * @param handles Recebe um vetor alocado com os handles (ou NULL se não houver
+ * nenhum). O chamador deve liberá-lo com free.
+ * @param quantidade Recebe o número de handles.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+int listar_intervalo_anos(const IndiceAnos* indice, int ano_minimo, int ano_maximo, int** handles, int* quantidade);
+
+/**
+ * @brief Libera toda a memória do índice e o deixa vazio (reutilizável).
+ * @param indice Ponteiro para o IndiceAnos. Se NULL, a função não faz nada.
+ */
+void liberar_indice_anos(IndiceAnos* indice);
+
+#endif // INDICE_ANOS_H
@@ -0,0 +1,254 @@
+#include <stdio.h>
+#include <stdlib.h> // Para malloc, realloc e free
+#include <stdint.h> // Para uint64_t
+#include <string.h> // Para memset e strlen
+#include "indice_difuso.h"
+#include "normalizacao.h" // Divisão dos textos em termos
+
+/** @brief Capacidade inicial do vetor de nós e das listas de handles. */
+#define CAPACIDADE_INICIAL_NOS 64
+#define CAPACIDADE_INICIAL_HANDLES 4
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Termo pré-processado para o cálculo bit a bit da distância de edição
+ * (algoritmo de Myers, na variante global de Hyyrö): para cada byte, a máscara das
+ * posições do termo em que ele aparece. Termos têm no máximo TAM_TERMO - 1 = 63
+ * bytes, então cada coluna da matriz de programação dinâmica cabe em 64 bits.
+ */
+typedef struct {
+    uint64_t ocorrencias[256];   ///< Bit i ligado se o byte aparece na posição i do termo.
+    uint64_t ultimo_bit;         ///< Máscara do bit da última posição do termo.
+    int tamanho;                 ///< Comprimento do termo.
+} PadraoDistancia;
+
+/**
+ * @brief Prepara o termo que será comparado com vários outros.
+ */
+static void preparar_padrao(PadraoDistancia* padrao, const char* termo) {
+    memset(padrao->ocorrencias, 0, sizeof(padrao->ocorrencias));
+    padrao->tamanho = 0;
+    for (const unsigned char* p = (const unsigned char*)termo; *p != '\0' && padrao->tamanho < TAM_TERMO - 1; p++) {
+        padrao->ocorrencias[*p] |= (uint64_t)1 << padrao->tamanho++;
+    }
+    padrao->ultimo_bit = padrao->tamanho > 0 ? (uint64_t)1 << (padrao->tamanho - 1) : 0;
+}
+
+/**
+ * @brief Distância de edição (Levenshtein) entre o padrão e `texto`, processando uma
+ * coluna inteira da matriz por byte do texto com operações de 64 bits.
+ */
+static int distancia_ao_padrao(const PadraoDistancia* padrao, const char* texto) {
+    if (padrao->tamanho == 0) {
+        return (int)strlen(texto);
+    }
+    uint64_t positivos = ~(uint64_t)0; // Diferenças verticais +1
+    uint64_t negativos = 0;            // Diferenças verticais -1
+    int distancia = padrao->tamanho;
+    for (const unsigned char* p = (const unsigned char*)texto; *p != '\0'; p++) {
+        uint64_t iguais = padrao->ocorrencias[*p];
+        uint64_t x = iguais | negativos;
+        uint64_t diagonal = (((x & positivos) + positivos) ^ positivos) | x;
+        uint64_t horizontal_neg = positivos & diagonal;
+        uint64_t horizontal_pos = negativos | ~(positivos | diagonal);
+        distancia += (horizontal_pos & padrao->ultimo_bit) != 0;
+        distancia -= (horizontal_neg & padrao->ultimo_bit) != 0;
+        // Na variante global, a primeira linha cresce 1 por coluna (entra um +1 horizontal).
+        horizontal_pos = (horizontal_pos << 1) | 1;
+        horizontal_neg <<= 1;
+        positivos = horizontal_neg | ~(diagonal | horizontal_pos);
+        negativos = horizontal_pos & diagonal;
+    }
+    return distancia;
+}
+
+/**
+ * @brief Garante espaço para o nó do próximo termo (ID `indice->termos.quantidade`).
+ */
+static int garantir_capacidade_nos(IndiceDifuso* indice) {
+    if (indice->termos.quantidade < indice->capacidade_nos) {
+        return 1;
+    }
+    int nova = indice->capacidade_nos > 0 ? indice->capacidade_nos * 2 : CAPACIDADE_INICIAL_NOS;
+    NoTermo* nos = (NoTermo*) realloc(indice->nos, (size_t)nova * sizeof(NoTermo));
+    if (nos == NULL) {
+        perror("ERRO (garantir_capacidade_nos): Falha ao alocar nos da BK-tree");
+        return 0;
+    }
+    indice->nos = nos;
+    indice->capacidade_nos = nova;
+    return 1;
+}
+
+/**
+ * @brief Pendura o termo recém-criado `id` na BK-tree, descendo pelos filhos com a
+ * mesma distância até encontrar uma posição livre.
+ */
+static void inserir_na_arvore(IndiceDifuso* indice, int id) {
+    if (id == 0) {
+        return; // O primeiro termo é a raiz
+    }
+    PadraoDistancia padrao;
+    preparar_padrao(&padrao, texto_do_id(&indice->termos, id));
+    int atual = 0;
+    for (;;) {
+        int distancia = distancia_ao_padrao(&padrao, texto_do_id(&indice->termos, atual));
+        int filho = indice->nos[atual].primeiro_filho;
+        while (filho >= 0 && indice->nos[filho].distancia_pai != distancia) {
+            filho = indice->nos[filho].proximo_irmao;
+        }
+        if (filho < 0) {
+            indice->nos[id].distancia_pai = distancia;
+            indice->nos[id].proximo_irmao = indice->nos[atual].primeiro_filho;
+            indice->nos[atual].primeiro_filho = id;
+            return;
+        }
+        atual = filho;
+    }
+}
+
+/**
+ * @brief Retorna o ID do termo, criando-o (dicionário + nó da árvore) se necessário.
+ * @return int O ID, ou -1 se a alocação falhar.
+ */
+static int obter_termo(IndiceDifuso* indice, const char* termo) {
+    int id = buscar_id_texto(&indice->termos, termo);
+    if (id >= 0) {
+        return id;
+    }
+    if (!garantir_capacidade_nos(indice)) {
+        return -1;
+    }
+    id = internar_texto(&indice->termos, termo);
+    if (id < 0) {
+        return -1;
+    }
+    NoTermo* no = &indice->nos[id];
+    no->primeiro_filho = -1;
+    no->proximo_irmao = -1;
+    no->distancia_pai = 0;
+    no->handles = NULL;
+    no->quantidade = 0;
+    no->capacidade = 0;
+    inserir_na_arvore(indice, id);
+    return id;
+}
+
+// --- FUNÇÕES DO ÍNDICE ---
+
+void inicializar_indice_difuso(IndiceDifuso* indice) {
+    inicializar_dicionario_textos(&indice->termos);
+    indice->nos = NULL;
+    indice->capacidade_nos = 0;
+}
+
+int adicionar_texto_indice_difuso(IndiceDifuso* indice, const char* texto, int handle) {
+    if (indice == NULL || texto == NULL || handle < 0) {
+        return 0;
+    }
+
+    char termo[TAM_TERMO];
+    const char* cursor = texto;
+    while (proximo_termo(&cursor, termo, sizeof(termo)) > 0) {
+        int id = obter_termo(indice, termo);
+        if (id < 0) {
+            return 0;
+        }
+        NoTermo* no = &indice->nos[id];
+        if (no->quantidade > 0 && no->handles[no->quantidade - 1] == handle) {
+            continue; // Palavra repetida no mesmo texto
+        }
+        if (no->quantidade == no->capacidade) {
+            int nova = no->capacidade > 0 ? no->capacidade * 2 : CAPACIDADE_INICIAL_HANDLES;
+            int* handles = (int*) realloc(no->handles, (size_t)nova * sizeof(int));
+            if (handles == NULL) {
+                perror("ERRO (adicionar_texto_indice_difuso): Falha ao alocar lista de handles");
+                return 0;
+            }
+            no->handles = handles;
+            no->capacidade = nova;
+        }
+        no->handles[no->quantidade++] = handle;
+    }
+    return 1;
+}
+
+void remover_texto_indice_difuso(IndiceDifuso* indice, const char* texto, int handle) {
+    if (indice == NULL || texto == NULL) {
+        return;
+    }
+
+    char termo[TAM_TERMO];
+    const char* cursor = texto;
+    while (proximo_termo(&cursor, termo, sizeof(termo)) > 0) {
+        int id = buscar_id_texto(&indice->termos, termo);
+        if (id < 0) {
+            continue;
+        }
+        NoTermo* no = &indice->nos[id];
+        for (int i = 0; i < no->quantidade; i++) {
+            if (no->handles[i] == handle) {
+                no->handles[i] = no->handles[--no->quantidade]; // A lista não tem ordem
+                break;
+            }
+        }
+    }
+}
+
+int buscar_termos_proximos(const IndiceDifuso* indice, const char* termo, int distancia_maxima,
+                           VisitanteTermo visitar, void* contexto) {
+    if (indice == NULL || termo == NULL || visitar == NULL || indice->termos.quantidade == 0) {
+        return 1;
+    }
+    if (distancia_maxima > DISTANCIA_DIFUSA_MAXIMA) {
+        distancia_maxima = DISTANCIA_DIFUSA_MAXIMA;
+    }
+
+    // Termos buscados maiores que os indexados são truncados da mesma forma.
+    char buscado[TAM_TERMO];
+    const char* cursor = termo;
+    if (proximo_termo(&cursor, buscado, sizeof(buscado)) == 0) {
+        return 1;
+    }
+
+    // Pilha explícita de nós a visitar (no máximo um por termo).
+    int* pilha = (int*) malloc((size_t)indice->termos.quantidade * sizeof(int));
+    if (pilha == NULL) {
+        perror("ERRO (buscar_termos_proximos): Falha ao alocar pilha da busca");
+        return 0;
+    }
+    PadraoDistancia padrao;
+    preparar_padrao(&padrao, buscado);
+    int topo = 0;
+    pilha[topo++] = 0;
+    while (topo > 0) {
+        int id = pilha[--topo];
+        const NoTermo* no = &indice->nos[id];
+        int distancia = distancia_ao_padrao(&padrao, texto_do_id(&indice->termos, id));
+        if (distancia <= distancia_maxima && no->quantidade > 0) {
+            visitar(no->handles, no->quantidade, distancia, contexto);
+        }
+        // Desigualdade triangular: só os filhos com |distancia_pai - distancia| <= tolerância
+        for (int filho = no->primeiro_filho; filho >= 0; filho = indice->nos[filho].proximo_irmao) {
+            int diferenca = indice->nos[filho].distancia_pai - distancia;
+            if (diferenca >= -distancia_maxima && diferenca <= distancia_maxima) {
+                pilha[topo++] = filho;
+            }
+        }
+    }
+    free(pilha);
+    return 1;
+}
+
+void liberar_indice_difuso(IndiceDifuso* indice) {
+    if (indice == NULL) {
+        return;
+    }
+    for (int i = 0; i < indice->termos.quantidade; i++) {
+        free(indice->nos[i].handles);
+    }
+    free(indice->nos);
+    liberar_dicionario_textos(&indice->termos);
+    inicializar_indice_difuso(indice);
+}
@@ -0,0 +1,105 @@
+#ifndef INDICE_DIFUSO_H
+#define INDICE_DIFUSO_H
+
+#include "arena_textos.h" // Dicionário dos termos distintos
+
+/**
+ * @file indice_difuso.h
+ * @brief Define o índice usado na busca tolerante a erros de digitação (busca difusa).
+ *
+ * Os textos indexados (títulos dobrados) são divididos em palavras (ver
+ * `proximo_termo` em normalizacao.h). Cada termo distinto recebe um ID no dicionário
+ * e uma lista dos handles dos registros que o contêm. Os termos formam uma BK-tree
+ * pela distância de edição (Levenshtein): cada filho guarda sua distância ao pai e,
+ * pela desigualdade triangular, uma consulta com tolerância `t` só desce pelos filhos
+ * cuja distância difere em no máximo `t` da distância do termo buscado ao pai. Assim,
+ * a distância é calculada para uma pequena parte dos termos, e nunca por registro.
+ *
+ * Como no índice de trigramas, quem mantém o índice informa o texto e o handle em
+ * cada inserção e remoção. Termos que deixam de ser usados permanecem na árvore,
+ * com a lista vazia, e não são mais encontrados.
+ */
+
+/** @brief Tamanho máximo de um termo (incluindo o terminador); termos maiores são truncados. */
+#define TAM_TERMO 64
+
+/** @brief Maior distância de edição aceita nas consultas. */
+#define DISTANCIA_DIFUSA_MAXIMA 2
+
+/**
+ * @brief Nó da BK-tree. O nó de índice `i` corresponde ao termo de ID `i`; o termo
+ * de ID 0 é a raiz.
+ */
+typedef struct {
+    int primeiro_filho;          ///< ID do primeiro filho, ou -1.
+    int proximo_irmao;           ///< ID do próximo filho do mesmo pai, ou -1.
+    int distancia_pai;           ///< Distância de edição até o termo do pai.
+    int* handles;                ///< Handles dos registros que contêm o termo (sem ordem).
+    int quantidade;              ///< Número de handles em `handles`.
+    int capacidade;              ///< Capacidade alocada de `handles`.
+} NoTermo;
+
+/**
+ * @brief Estrutura do índice difuso.
+ */
+typedef struct {
+    DicionarioTextos termos;     ///< Termos distintos (ID = nó da árvore).
+    NoTermo* nos;                ///< Nós da BK-tree, um por termo.
+    int capacidade_nos;          ///< Capacidade alocada de `nos`.
+} IndiceDifuso;
+
+/**
+ * @brief Função chamada para cada termo próximo encontrado.
+ * @param handles Handles dos registros que contêm o termo.
+ * @param quantidade Número de handles.
+ * @param distancia Distância de edição entre o termo buscado e o termo encontrado.
+ * @param contexto Ponteiro repassado pelo chamador.
+ */
+typedef void (*VisitanteTermo)(const int* handles, int quantidade, int distancia, void* contexto);
+
+// --- Protótipos das Funções ---
+
+/**
+ * @brief Inicializa um índice vazio. Nenhuma memória é alocada até a primeira inserção.
+ * @param indice Ponteiro para o IndiceDifuso. Não deve ser NULL.
+ */
+void inicializar_indice_difuso(IndiceDifuso* indice);
+
+/**
+ * @brief Indexa as palavras de um texto para o handle informado.
+ * @param indice Ponteiro para o IndiceDifuso.
+ * @param texto Texto (já dobrado) do registro. Não deve ser NULL.
+ * @param handle Handle (não negativo) do registro.
+ * @return int 1 em caso de sucesso, 0 se alguma alocação falhar (nesse caso, o
+ * chamador deve desfazer com `remover_texto_indice_difuso`).
+ */
+int adicionar_texto_indice_difuso(IndiceDifuso* indice, const char* texto, int handle);
+
+/**
+ * @brief Remove o handle das listas de todas as palavras do texto.
+ * Handles ausentes de uma lista são ignorados.
+ * @param indice Ponteiro para o IndiceDifuso.
+ * @param texto Texto que foi indexado para o handle. Não deve ser NULL.
+ * @param handle Handle do registro removido.
+ */
+void remover_texto_indice_difuso(IndiceDifuso* indice, const char* texto, int handle);
+
+/**
+ * @brief Visita os termos a no máximo `distancia_maxima` edições do termo buscado.
+ * @param indice Ponteiro constante para o IndiceDifuso.
+ * @param termo Termo (já dobrado, uma palavra) buscado.
+ * @param distancia_maxima Tolerância (limitada a DISTANCIA_DIFUSA_MAXIMA).
+ * @param visitar Função chamada para cada termo encontrado que ainda está em uso.
+ * @param contexto Ponteiro repassado a `visitar` (pode ser NULL).
+ * @return int 1 em caso de sucesso, 0 se a alocação da pilha de busca falhar.
+ */
+int buscar_termos_proximos(const IndiceDifuso* indice, const char* termo, int distancia_maxima,
+                           VisitanteTermo visitar, void* contexto);
+
+/**
+ * @brief Libera toda a memória do índice e o deixa vazio (reutilizável).
+ * @param indice Ponteiro para o IndiceDifuso. Se NULL, a função não faz nada.
+ */
+void liberar_indice_difuso(IndiceDifuso* indice);
+
+#endif // INDICE_DIFUSO_H
@@ -0,0 +1,66 @@
+#include <stdio.h>
+#include <stdlib.h> // Para realloc e free
+#include "indice_generos.h"
+
+/** @brief Capacidade inicial do vetor de conjuntos. */
+#define CAPACIDADE_INICIAL_GENEROS 16
+
+// --- FUNÇÕES DO ÍNDICE ---
+
+void inicializar_indice_generos(IndiceGeneros* indice) {
+    indice->conjuntos = NULL;
+    indice->quantidade = 0;
+}
+
+int inserir_indice_generos(IndiceGeneros* indice, int id_genero, int handle) {
+    if (indice == NULL || id_genero < 0 || handle < 0) {
+        return 0;
+    }
+    if (id_genero >= indice->quantidade) {
+        int nova = indice->quantidade > 0 ? indice->quantidade : CAPACIDADE_INICIAL_GENEROS;
+        while (nova <= id_genero) {
+            nova *= 2;
+        }
+        BitmapHandles* conjuntos = (BitmapHandles*) realloc(indice->conjuntos, (size_t)nova * sizeof(BitmapHandles));
+        if (conjuntos == NULL) {
+            perror("ERRO (inserir_indice_generos): Falha ao alocar indice de generos");
+            return 0;
+        }
+        for (int g = indice->quantidade; g < nova; g++) {
+            inicializar_bitmap(&conjuntos[g]);
+        }
+        indice->conjuntos = conjuntos;
+        indice->quantidade = nova;
+    }
+    return adicionar_bitmap(&indice->conjuntos[id_genero], handle);
+}
+
+void remover_indice_generos(IndiceGeneros* indice, int id_genero, int handle) {
+    if (indice == NULL || id_genero < 0 || id_genero >= indice->quantidade) {
+        return;
+    }
+    remover_bitmap(&indice->conjuntos[id_genero], handle);
+}
+
+const BitmapHandles* conjunto_do_genero(const IndiceGeneros* indice, int id_genero) {
+    if (indice == NULL || id_genero < 0 || id_genero >= indice->quantidade) {
+        return NULL;
+    }
+    return &indice->conjuntos[id_genero];
+}
+
+int contar_genero(const IndiceGeneros* indice, int id_genero) {
+    const BitmapHandles* conjunto = conjunto_do_genero(indice, id_genero);
+    return conjunto != NULL ? conjunto->cardinalidade : 0;
+}
+
+void liberar_indice_generos(IndiceGeneros* indice) {
+    if (indice == NULL) {
+        return;
+    }
+    for (int g = 0; g < indice->quantidade; g++) {
+        liberar_bitmap(&indice->conjuntos[g]);
+    }
+    free(indice->conjuntos);
+    inicializar_indice_generos(indice);
+}
@@ -0,0 +1,64 @@
+#ifndef INDICE_GENEROS_H
+#define INDICE_GENEROS_H
+
+#include "bitmap_handles.h" // Conjunto compacto de handles por gênero
+
+/**
+ * @file indice_generos.h
+ * @brief Define o índice de gêneros: para cada ID de gênero do dicionário `generos` do
+ * armazenamento, o conjunto (BitmapHandles) dos handles dos livros daquele gênero.
+ *
+ * Como os gêneros distintos são poucas dezenas, o índice é um vetor endereçado pelo
+ * ID. A contagem de um gênero (faceta) é a cardinalidade do conjunto, lida em O(1);
+ * listar um gênero percorre só os handles dele, e combinações (gênero A OU gênero B,
+ * gênero E outro critério) usam a interseção e a união dos conjuntos.
+ */
+
+/**
+ * @brief Estrutura do índice de gêneros.
+ */
+typedef struct {
+    BitmapHandles* conjuntos;    ///< Para cada ID de gênero, os handles dos livros do gênero.
+    int quantidade;              ///< Número de IDs com conjunto alocado.
+} IndiceGeneros;
+
+// --- Protótipos das Funções ---
+
+/**
+ * @brief Inicializa um índice vazio. Nenhuma memória é alocada até a primeira inserção.
+ * @param indice Ponteiro para o IndiceGeneros. Não deve ser NULL.
+ */
+void inicializar_indice_generos(IndiceGeneros* indice);
+
+/**
+ * @brief Indexa o handle no conjunto do gênero.
+ * @param indice Ponteiro para o IndiceGeneros.
+ * @param id_genero ID do gênero no dicionário `generos` (não negativo).
+ * @param handle Handle (não negativo) do registro.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar (nada é indexado).
+ */
+int inserir_indice_generos(IndiceGeneros* indice, int id_genero, int handle);
+
+/**
+ * @brief Remove o handle do conjunto do gênero. Handles ausentes são ignorados.
+ */
+void remover_indice_generos(IndiceGeneros* indice, int id_genero, int handle);
+
+/**
+ * @brief Conjunto dos handles de um gênero.
+ * @return const BitmapHandles* O conjunto, ou NULL se nenhum livro do gênero foi indexado.
+ */
+const BitmapHandles* conjunto_do_genero(const IndiceGeneros* indice, int id_genero);
+
+/**
+ * @brief Número de livros do gênero, em O(1).
+ */
+int contar_genero(const IndiceGeneros* indice, int id_genero);
+
+/**
+ * @brief Libera toda a memória do índice e o deixa vazio (reutilizável).
+ * @param indice Ponteiro para o IndiceGeneros. Se NULL, a função não faz nada.
+ */
+void liberar_indice_generos(IndiceGeneros* indice);
+
+#endif // INDICE_GENEROS_H
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h> // Para malloc e free
+#include "indice_isbn.h"
+
+/** @brief Capacidade mínima da tabela quando ela é alocada pela primeira vez. */
+#define CAPACIDADE_MINIMA_INDICE 16
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Verifica se a tabela deve crescer para acomodar mais uma entrada.
+ * O fator de carga é mantido abaixo de 70% para que as sondagens continuem curtas.
+ */
+static int indice_precisa_crescer(const IndiceIsbn* indice, int quantidade_final) {
+    return indice->capacidade == 0 || quantidade_final * 10 > indice->capacidade * 7;
+}
+
+/**
+ * @brief Realoca a tabela com a nova capacidade e reinsere todas as entradas ocupadas.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar (a tabela antiga é preservada).
+ */
+static int redimensionar_indice(IndiceIsbn* indice, int nova_capacidade) {
+    EntradaIndiceIsbn* novas = (EntradaIndiceIsbn*) malloc((size_t)nova_capacidade * sizeof(EntradaIndiceIsbn));
+    if (novas == NULL) {
+        perror("ERRO (redimensionar_indice): Falha ao alocar tabela do indice de ISBN");
+        return 0;
+    }
+    for (int i = 0; i < nova_capacidade; i++) {
+        novas[i].handle = -1; // Entrada livre
+    }
+
+    unsigned int mascara = (unsigned int)nova_capacidade - 1;
+    for (int i = 0; i < indice->capacidade; i++) {
+        if (indice->entradas[i].handle < 0) {
+            continue;
+        }
+        unsigned int pos = hash_chave_isbn(indice->entradas[i].chave) & mascara;
+        while (novas[pos].handle >= 0) {
+            pos = (pos + 1) & mascara;
+        }
+        novas[pos] = indice->entradas[i];
+    }
+
+    free(indice->entradas);
+    indice->entradas = novas;
+    indice->capacidade = nova_capacidade;
+    return 1;
+}
+
+// --- FUNÇÕES DO ÍNDICE ---
+
+void inicializar_indice_isbn(IndiceIsbn* indice) {
+    indice->entradas = NULL;
+    indice->capacidade = 0;
+    indice->quantidade = 0;
+}
+
+int reservar_indice_isbn(IndiceIsbn* indice, int quantidade_esperada) {
+    if (indice == NULL || quantidade_esperada < 0) {
+        return 0;
+    }
+    if (!indice_precisa_crescer(indice, quantidade_esperada)) {
+        return 1; // Capacidade atual já é suficiente
+    }
+
+    int nova_capacidade = indice->capacidade > 0 ? indice->capacidade : CAPACIDADE_MINIMA_INDICE;
+    while (quantidade_esperada * 10 > nova_capacidade * 7) {
+        nova_capacidade *= 2;
+    }
+    return redimensionar_indice(indice, nova_capacidade);
+}
+
+int inserir_indice_isbn(IndiceIsbn* indice, ChaveIsbn chave, int handle) {
+    if (indice == NULL || chave == CHAVE_ISBN_INVALIDA || handle < 0) {
+        return 0;
+    }
+    if (indice_precisa_crescer(indice, indice->quantidade + 1)) {
+        int nova_capacidade = indice->capacidade > 0 ? indice->capacidade * 2 : CAPACIDADE_MINIMA_INDICE;
+        if (!redimensionar_indice(indice, nova_capacidade)) {
+            return 0;
+        }
+    }
+
+    unsigned int mascara = (unsigned int)indice->capacidade - 1;
+    unsigned int pos = hash_chave_isbn(chave) & mascara;
+    while (indice->entradas[pos].handle >= 0) {
+        pos = (pos + 1) & mascara;
+    }
+
+    indice->entradas[pos].chave = chave;
+    indice->entradas[pos].handle = handle;
+    indice->quantidade++;
+    return 1;
+}
+
+/**
+ * @brief Localiza a posição da entrada com a chave informada.
+ * @return long A posição na tabela, ou -1 se a chave não estiver indexada.
+ */
+static long localizar_entrada(const IndiceIsbn* indice, ChaveIsbn chave) {
+    if (indice == NULL || chave == CHAVE_ISBN_INVALIDA || indice->quantidade == 0) {
+        return -1;
+    }
+
+    unsigned int mascara = (unsigned int)indice->capacidade - 1;
+    unsigned int pos = hash_chave_isbn(chave) & mascara;
+    while (indice->entradas[pos].handle >= 0) {
+        if (indice->entradas[pos].chave == chave) {
+            return (long)pos;
+        }
+        pos = (pos + 1) & mascara;
+    }
+    return -1;
+}
+
+int buscar_handle_indice_isbn(const IndiceIsbn* indice, ChaveIsbn chave) {
+    long pos = localizar_entrada(indice, chave);
+    return pos < 0 ? -1 : indice->entradas[pos].handle;
+}
+
+int remover_indice_isbn(IndiceIsbn* indice, ChaveIsbn chave) {
+    long encontrado = localizar_entrada(indice, chave);
+    if (encontrado < 0) {
+        return 0;
+    }
+
+    // Remoção por deslocamento para trás: as entradas seguintes do mesmo "cluster"
+    // que puderem ocupar a posição liberada são movidas para ela, mantendo todas as
+    // cadeias de sondagem intactas sem precisar de marcadores de remoção.
+    unsigned int mascara = (unsigned int)indice->capacidade - 1;
+    unsigned int vazio = (unsigned int)encontrado;
+    unsigned int pos = (vazio + 1) & mascara;
+    while (indice->entradas[pos].handle >= 0) {
+        unsigned int ideal = hash_chave_isbn(indice->entradas[pos].chave) & mascara;
+        // A entrada em 'pos' pode ser movida se sua posição ideal não estiver
+        // no intervalo circular (vazio, pos].
+        if (((pos - ideal) & mascara) >= ((pos - vazio) & mascara)) {
+            indice->entradas[vazio] = indice->entradas[pos];
+            vazio = pos;
+        }
+        pos = (pos + 1) & mascara;
+    }
+    indice->entradas[vazio].handle = -1;
+    indice->quantidade--;
+    return 1;
+}
+
+void liberar_indice_isbn(IndiceIsbn* indice) {
+    if (indice == NULL) {
+        return;
+    }
+    free(indice->entradas);
+    inicializar_indice_isbn(indice);
+}
@@ -0,0 +1,85 @@
+#ifndef INDICE_ISBN_H
+#define INDICE_ISBN_H
+
+#include "chave_isbn.h" // Chave de 64 bits do ISBN normalizado
+
+/**
+ * @file indice_isbn.h
+ * @brief Define um índice hash (endereçamento aberto) que associa chaves de ISBN
+ * (ver chave_isbn.h) aos handles dos registros da coleção de livros, permitindo
+ * busca, verificação de duplicidade e remoção em tempo O(1) esperado.
+ *
+ * A tabela usa sondagem linear com capacidade sempre potência de 2 e remoção por
+ * deslocamento para trás (backward-shift), evitando marcadores de "apagado".
+ */
+
+/**
+ * @brief Entrada da tabela hash.
+ * Uma entrada está livre quando `handle` é negativo. A chave fica na própria entrada,
+ * de modo que a sondagem compara apenas inteiros e não acessa os registros da coleção.
+ */
+typedef struct {
+    ChaveIsbn chave;            ///< Chave do ISBN indexado.
+    int handle;                 ///< Handle do registro na coleção (negativo se a entrada estiver livre).
+} EntradaIndiceIsbn;
+
+/**
+ * @brief Estrutura do índice de ISBNs.
+ */
+typedef struct {
+    EntradaIndiceIsbn* entradas; ///< Vetor de entradas (tamanho `capacidade`).
+    int capacidade;              ///< Número de entradas da tabela (potência de 2, ou 0 se não alocada).
+    int quantidade;              ///< Número de entradas ocupadas.
+} IndiceIsbn;
+
+// --- Protótipos das Funções ---
+
+/**
+ * @brief Inicializa um índice vazio. Nenhuma memória é alocada até a primeira inserção.
+ * @param indice Ponteiro para o IndiceIsbn a ser inicializado. Não deve ser NULL.
+ */
+void inicializar_indice_isbn(IndiceIsbn* indice);
+
+/**
+ * @brief Garante capacidade para pelo menos `quantidade_esperada` entradas sem
+ * redimensionamentos posteriores.
+ * @param indice Ponteiro para o IndiceIsbn.
+ * @param quantidade_esperada Número de ISBNs que se espera armazenar.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+int reservar_indice_isbn(IndiceIsbn* indice, int quantidade_esperada);
+
+/**
+ * @brief Insere no índice a associação chave -> handle.
+ * Não verifica duplicidade; o chamador deve usar `buscar_handle_indice_isbn` antes.
+ *
+ * @param indice Ponteiro para o IndiceIsbn.
+ * @param chave Chave do ISBN do registro (diferente de CHAVE_ISBN_INVALIDA).
+ * @param handle Handle (não negativo) do registro na coleção.
+ * @return int 1 em caso de sucesso, 0 se a alocação ao crescer a tabela falhar.
+ */
+int inserir_indice_isbn(IndiceIsbn* indice, ChaveIsbn chave, int handle);
+
+/**
+ * @brief Busca o handle do registro que possui a chave informada.
+ * @param indice Ponteiro constante para o IndiceIsbn.
+ * @param chave Chave do ISBN buscado.
+ * @return int O handle encontrado, ou -1 se o ISBN não estiver indexado.
+ */
+int buscar_handle_indice_isbn(const IndiceIsbn* indice, ChaveIsbn chave);
+
+/**
+ * @brief Remove do índice a entrada com a chave informada.
+ * @param indice Ponteiro para o IndiceIsbn.
+ * @param chave Chave do ISBN a remover.
+ * @return int 1 se a entrada foi removida, 0 se não foi encontrada.
+ */
+int remover_indice_isbn(IndiceIsbn* indice, ChaveIsbn chave);
+
+/**
+ * @brief Libera a memória da tabela e deixa o índice vazio (reutilizável).
+ * @param indice Ponteiro para o IndiceIsbn. Se NULL, a função não faz nada.
+ */
+void liberar_indice_isbn(IndiceIsbn* indice);
+
+#endif // INDICE_ISBN_H
@@ -0,0 +1,209 @@
+#include <stdio.h>
+#include <stdlib.h> // Para malloc, realloc, free e qsort
+#include <string.h> // Para strcmp, strncmp e strlen
+#include "indice_prefixos.h"
+
+/** @brief Capacidade inicial do vetor de textos de exibição. */
+#define CAPACIDADE_INICIAL_EXIBICAO 64
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Par (texto, ID) usado para ordenar os IDs pendentes.
+ */
+typedef struct {
+    const char* texto;
+    int id;
+} ChavePendente;
+
+/**
+ * @brief Função de comparação para qsort de ChavePendente pelo texto.
+ */
+static int comparar_chaves_pendentes(const void* a, const void* b) {
+    return strcmp(((const ChavePendente*)a)->texto, ((const ChavePendente*)b)->texto);
+}
+
+/**
+ * @brief Ordena os IDs criados desde a última consulta e os intercala ao vetor ordenado.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar (o vetor antigo continua válido).
+ */
+static int incorporar_pendentes(IndicePrefixos* indice) {
+    int total = indice->chaves.quantidade;
+    int pendentes = total - indice->ordenados_ate;
+    if (pendentes <= 0) {
+        return 1;
+    }
+
+    ChavePendente* novos = (ChavePendente*) malloc((size_t)pendentes * sizeof(ChavePendente));
+    int* ordenados = (int*) malloc((size_t)total * sizeof(int));
+    if (novos == NULL || ordenados == NULL) {
+        perror("ERRO (incorporar_pendentes): Falha ao alocar indice de prefixos");
+        free(novos);
+        free(ordenados);
+        return 0;
+    }
+    for (int i = 0; i < pendentes; i++) {
+        novos[i].id = indice->ordenados_ate + i;
+        novos[i].texto = texto_do_id(&indice->chaves, novos[i].id);
+    }
+    qsort(novos, (size_t)pendentes, sizeof(ChavePendente), comparar_chaves_pendentes);
+
+    // Intercalação (merge) dos IDs já ordenados com os novos
+    int a = 0, b = 0, k = 0;
+    while (a < indice->ordenados_ate && b < pendentes) {
+        if (strcmp(texto_do_id(&indice->chaves, indice->ordenados[a]), novos[b].texto) <= 0) {
+            ordenados[k++] = indice->ordenados[a++];
+        } else {
+            ordenados[k++] = novos[b++].id;
+        }
+    }
+    while (a < indice->ordenados_ate) {
+        ordenados[k++] = indice->ordenados[a++];
+    }
+    while (b < pendentes) {
+        ordenados[k++] = novos[b++].id;
+    }
+
+    free(novos);
+    free(indice->ordenados);
+    indice->ordenados = ordenados;
+    indice->ordenados_ate = total;
+    return 1;
+}
+
+/**
+ * @brief Primeira posição do vetor ordenado cujo texto é >= `prefixo`.
+ * Todos os textos que começam com o prefixo ficam contíguos a partir dela.
+ */
+static int primeira_posicao_prefixo(const IndicePrefixos* indice, const char* prefixo) {
+    int inicio = 0;
+    int fim = indice->ordenados_ate;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (strcmp(texto_do_id(&indice->chaves, indice->ordenados[meio]), prefixo) < 0) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return inicio;
+}
+
+// --- FUNÇÕES DO ÍNDICE ---
+
+void inicializar_indice_prefixos(IndicePrefixos* indice) {
+    inicializar_dicionario_textos(&indice->chaves);
+    inicializar_arena_textos(&indice->exibicao);
+    indice->deslocamentos_exibicao = NULL;
+    indice->capacidade_exibicao = 0;
+    indice->ordenados = NULL;
+    indice->ordenados_ate = 0;
+}
+
+int adicionar_texto_indice_prefixos(IndicePrefixos* indice, const char* texto_dobrado, const char* texto_exibicao) {
+    if (indice == NULL || texto_dobrado == NULL || texto_exibicao == NULL) {
+        return 0;
+    }
+    if (buscar_id_texto(&indice->chaves, texto_dobrado) >= 0) {
+        // Texto já conhecido: apenas a popularidade aumenta.
+        return internar_texto(&indice->chaves, texto_dobrado) >= 0;
+    }
+
+    // Texto novo: o texto original é guardado antes de internar a chave, de modo que
+    // uma falha de alocação não deixa um ID sem texto de exibição.
+    int id = indice->chaves.quantidade;
+    if (id >= indice->capacidade_exibicao) {
+        int nova = indice->capacidade_exibicao > 0 ? indice->capacidade_exibicao * 2 : CAPACIDADE_INICIAL_EXIBICAO;
+        unsigned int* deslocamentos = (unsigned int*) realloc(indice->deslocamentos_exibicao, (size_t)nova * sizeof(unsigned int));
+        if (deslocamentos == NULL) {
+            perror("ERRO (adicionar_texto_indice_prefixos): Falha ao alocar textos de exibicao");
+            return 0;
+        }
+        indice->deslocamentos_exibicao = deslocamentos;
+        indice->capacidade_exibicao = nova;
+    }
+    if (!adicionar_texto_arena(&indice->exibicao, texto_exibicao, &indice->deslocamentos_exibicao[id])) {
+        return 0;
+    }
+    if (internar_texto(&indice->chaves, texto_dobrado) < 0) {
+        descartar_texto_arena(&indice->exibicao, indice->deslocamentos_exibicao[id]);
+        return 0;
+    }
+    return 1;
+}
+
+void remover_texto_indice_prefixos(IndicePrefixos* indice, const char* texto_dobrado) {
+    if (indice == NULL || texto_dobrado == NULL) {
+        return;
+    }
+    liberar_referencia_texto(&indice->chaves, buscar_id_texto(&indice->chaves, texto_dobrado));
+}
+
+int buscar_prefixo(IndicePrefixos* indice, const char* prefixo_dobrado, int maximo, OrdemSugestoes ordem,
+                   const char** sugestoes, int* popularidades) {
+    if (indice == NULL || prefixo_dobrado == NULL || sugestoes == NULL || maximo <= 0) {
+        return 0;
+    }
+    if (!incorporar_pendentes(indice)) {
+        return 0;
+    }
+
+    size_t tamanho_prefixo = strlen(prefixo_dobrado);
+    int* escolhidos = (int*) malloc((size_t)maximo * sizeof(int));
+    if (escolhidos == NULL) {
+        perror("ERRO (buscar_prefixo): Falha ao alocar sugestoes");
+        return 0;
+    }
+
+    int quantidade = 0;
+    for (int p = primeira_posicao_prefixo(indice, prefixo_dobrado); p < indice->ordenados_ate; p++) {
+        int id = indice->ordenados[p];
+        if (strncmp(texto_do_id(&indice->chaves, id), prefixo_dobrado, tamanho_prefixo) != 0) {
+            break; // Fim do intervalo do prefixo
+        }
+        int usos = indice->chaves.referencias[id];
+        if (usos == 0) {
+            continue; // Nenhum livro usa mais este texto
+        }
+
+        if (ordem == ORDEM_ALFABETICA) {
+            escolhidos[quantidade++] = id;
+            if (quantidade == maximo) {
+                break;
+            }
+            continue;
+        }
+
+        // Por popularidade: mantém os `maximo` mais usados, em ordem decrescente
+        // (inserção ordenada; percorrer em ordem alfabética desempata os iguais).
+        if (quantidade == maximo && usos <= indice->chaves.referencias[escolhidos[quantidade - 1]]) {
+            continue;
+        }
+        int pos = quantidade < maximo ? quantidade++ : quantidade - 1;
+        while (pos > 0 && indice->chaves.referencias[escolhidos[pos - 1]] < usos) {
+            escolhidos[pos] = escolhidos[pos - 1];
+            pos--;
+        }
+        escolhidos[pos] = id;
+    }
+
+    for (int i = 0; i < quantidade; i++) {
+        sugestoes[i] = texto_na_arena(&indice->exibicao, indice->deslocamentos_exibicao[escolhidos[i]]);
+        if (popularidades != NULL) {
+            popularidades[i] = indice->chaves.referencias[escolhidos[i]];
+        }
+    }
+    free(escolhidos);
+    return quantidade;
+}
+
+void liberar_indice_prefixos(IndicePrefixos* indice) {
+    if (indice == NULL) {
+        return;
+    }
+    liberar_dicionario_textos(&indice->chaves);
+    liberar_arena_textos(&indice->exibicao);
+    free(indice->deslocamentos_exibicao);
+    free(indice->ordenados);
+    inicializar_indice_prefixos(indice);
+}
@@ -0,0 +1,88 @@
+#ifndef INDICE_PREFIXOS_H
+#define INDICE_PREFIXOS_H
+
+#include "arena_textos.h" // Dicionário de textos distintos e arena de textos de exibição
+
+/**
+ * @file indice_prefixos.h
+ * @brief Define o índice de prefixos usado para autocompletar títulos e autores.
+ *
+ * Cada texto distinto (já dobrado: minúsculas, sem acentos) é internado em um
+ * dicionário, cujo contador de referências indica quantos livros o usam
+ * (popularidade). Um vetor com os IDs em ordem alfabética do texto permite achar,
+ * por busca binária, o intervalo contíguo de textos que começam com um prefixo.
+ *
+ * Inserir um texto novo apenas lhe atribui o próximo ID; os IDs ainda não ordenados
+ * (sempre os últimos) são ordenados e intercalados ao vetor na próxima consulta, de
+ * modo que uma importação grande custa uma única ordenação. Textos cuja popularidade
+ * chega a zero continuam no vetor, mas não são sugeridos.
+ */
+
+/**
+ * @brief Critério de ordenação das sugestões.
+ */
+typedef enum {
+    ORDEM_ALFABETICA,   ///< Em ordem alfabética (do texto dobrado).
+    ORDEM_POPULARIDADE  ///< Mais usados primeiro; empates em ordem alfabética.
+} OrdemSugestoes;
+
+/**
+ * @brief Estrutura do índice de prefixos.
+ */
+typedef struct {
+    DicionarioTextos chaves;     ///< Textos dobrados distintos; as referências são a popularidade.
+    ArenaTextos exibicao;        ///< Texto original (do primeiro livro) de cada ID, usado nas sugestões.
+    unsigned int* deslocamentos_exibicao; ///< Para cada ID, o deslocamento do texto original em `exibicao`.
+    int capacidade_exibicao;     ///< Capacidade alocada de `deslocamentos_exibicao`.
+    int* ordenados;              ///< IDs [0..ordenados_ate) em ordem alfabética do texto dobrado.
+    int ordenados_ate;           ///< IDs menores que este já estão em `ordenados`.
+} IndicePrefixos;
+
+// --- Protótipos das Funções ---
+
+/**
+ * @brief Inicializa um índice vazio.
+ * @param indice Ponteiro para o IndicePrefixos. Não deve ser NULL.
+ */
+void inicializar_indice_prefixos(IndicePrefixos* indice);
+
+/**
+ * @brief Registra mais um uso do texto (um livro com esse título ou autor).
+ * @param indice Ponteiro para o IndicePrefixos.
+ * @param texto_dobrado Texto dobrado (chave de busca).
+ * @param texto_exibicao Texto original, guardado na primeira vez que a chave aparece.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+int adicionar_texto_indice_prefixos(IndicePrefixos* indice, const char* texto_dobrado, const char* texto_exibicao);
+
+/**
+ * @brief Registra a remoção de um uso do texto.
+ * @param indice Ponteiro para o IndicePrefixos.
+ * @param texto_dobrado Texto dobrado informado na inserção.
+ */
+void remover_texto_indice_prefixos(IndicePrefixos* indice, const char* texto_dobrado);
+
+/**
+ * @brief Lista até `maximo` textos que começam com o prefixo.
+ * Em ordem alfabética, custa O(log n + maximo); por popularidade, percorre todo o
+ * intervalo do prefixo (que encolhe a cada caractere digitado).
+ *
+ * @param indice Ponteiro para o IndicePrefixos (IDs pendentes são ordenados aqui).
+ * @param prefixo_dobrado Prefixo já dobrado.
+ * @param maximo Número máximo de sugestões.
+ * @param ordem Critério de ordenação das sugestões.
+ * @param sugestoes Vetor com `maximo` posições que recebe os textos originais
+ * (válidos até a próxima inserção no índice).
+ * @param popularidades Vetor opcional (pode ser NULL) que recebe o número de livros de cada sugestão.
+ * @return int O número de sugestões gravadas.
+ */
+int buscar_prefixo(IndicePrefixos* indice, const char* prefixo_dobrado, int maximo, OrdemSugestoes ordem,
+                   const char** sugestoes, int* popularidades);
+
+/**
+ * @brief Libera toda a memória do índice e o deixa vazio (reutilizável).
+ * @param indice Ponteiro para o IndicePrefixos. Se NULL, a função não faz nada.
+ */
+void liberar_indice_prefixos(IndicePrefixos* indice);
+
+#endif // INDICE_PREFIXOS_H
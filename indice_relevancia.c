@@ -0,0 +1,472 @@
+#include <stdio.h>
+#include <stdlib.h> // Para malloc, realloc, free e qsort
+#include <string.h> // Para memmove e strcmp
+#include <limits.h> // Para INT_MAX
+#include <math.h>   // Para log
+#include "indice_relevancia.h"
+#include "normalizacao.h" // Divisão dos textos em termos
+
+/** @brief Capacidades iniciais dos vetores do índice. */
+#define CAPACIDADE_INICIAL_LISTAS 64
+#define CAPACIDADE_INICIAL_POSTAGENS 4
+#define CAPACIDADE_INICIAL_COMPRIMENTOS 64
+
+/** @brief Tamanho máximo de um termo (incluindo o terminador); termos maiores são truncados. */
+#define TAM_TERMO_RELEVANCIA 64
+
+/** @brief Número máximo de palavras distintas de um livro (título + autor + gênero). */
+#define MAX_TERMOS_LIVRO 160
+
+/** @brief Marca, em `comprimentos`, um handle não indexado. */
+#define COMPRIMENTO_AUSENTE (-1.0f)
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Termo distinto de um livro e sua frequência ponderada.
+ */
+typedef struct {
+    char texto[TAM_TERMO_RELEVANCIA];
+    float frequencia;
+} TermoLivro;
+
+/**
+ * @brief Divide os três campos em termos distintos, somando o peso do campo a cada
+ * ocorrência.
+ * @return int O número de termos distintos gravados em `termos`.
+ */
+static int coletar_termos(const char* titulo, const char* autor, const char* genero,
+                          TermoLivro* termos, float* comprimento) {
+    const char* campos[3] = { titulo, autor, genero };
+    const float pesos[3] = { PESO_RELEVANCIA_TITULO, PESO_RELEVANCIA_AUTOR, PESO_RELEVANCIA_GENERO };
+    int quantidade = 0;
+    *comprimento = 0.0f;
+
+    for (int c = 0; c < 3; c++) {
+        const char* cursor = campos[c];
+        char termo[TAM_TERMO_RELEVANCIA];
+        while (proximo_termo(&cursor, termo, sizeof(termo)) > 0) {
+            *comprimento += pesos[c];
+            int t = 0;
+            while (t < quantidade && strcmp(termos[t].texto, termo) != 0) {
+                t++;
+            }
+            if (t == quantidade) {
+                if (quantidade == MAX_TERMOS_LIVRO) {
+                    continue; // Só ocorre com campos maiores que os da struct Livro
+                }
+                strcpy(termos[quantidade].texto, termo);
+                termos[quantidade].frequencia = 0.0f;
+                quantidade++;
+            }
+            termos[t].frequencia += pesos[c];
+        }
+    }
+    return quantidade;
+}
+
+/**
+ * @brief Posição do handle na lista, ou o ponto de inserção (busca binária).
+ */
+static int localizar_postagem(const PostagensTermo* lista, int handle) {
+    int inicio = 0;
+    int fim = lista->quantidade;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (lista->handles[meio] < handle) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return inicio;
+}
+
+/**
+ * @brief Insere a postagem na posição ordenada (no fim, no caso comum de handles novos).
+ */
+static int inserir_postagem(PostagensTermo* lista, int handle, float frequencia, float comprimento) {
+    if (lista->quantidade == lista->capacidade) {
+        int nova = lista->capacidade > 0 ? lista->capacidade * 2 : CAPACIDADE_INICIAL_POSTAGENS;
+        int* handles = (int*) realloc(lista->handles, (size_t)nova * sizeof(int));
+        if (handles == NULL) {
+            perror("ERRO (inserir_postagem): Falha ao alocar postagens");
+            return 0;
+        }
+        lista->handles = handles;
+        float* frequencias = (float*) realloc(lista->frequencias, (size_t)nova * sizeof(float));
+        if (frequencias == NULL) {
+            perror("ERRO (inserir_postagem): Falha ao alocar postagens");
+            return 0;
+        }
+        lista->frequencias = frequencias;
+        lista->capacidade = nova;
+    }
+
+    int posicao = lista->quantidade;
+    if (posicao > 0 && lista->handles[posicao - 1] > handle) {
+        posicao = localizar_postagem(lista, handle); // Handle reaproveitado
+        memmove(&lista->handles[posicao + 1], &lista->handles[posicao],
+                (size_t)(lista->quantidade - posicao) * sizeof(int));
+        memmove(&lista->frequencias[posicao + 1], &lista->frequencias[posicao],
+                (size_t)(lista->quantidade - posicao) * sizeof(float));
+    }
+    lista->handles[posicao] = handle;
+    lista->frequencias[posicao] = frequencia;
+    lista->quantidade++;
+    if (frequencia > lista->frequencia_maxima) {
+        lista->frequencia_maxima = frequencia;
+    }
+    if (lista->quantidade == 1 || comprimento < lista->comprimento_minimo) {
+        lista->comprimento_minimo = comprimento;
+    }
+    return 1;
+}
+
+/**
+ * @brief Remove a postagem do handle, se existir. Os limites da lista não são
+ * recalculados: continuam limites superiores válidos.
+ */
+static void remover_postagem(PostagensTermo* lista, int handle) {
+    int posicao = localizar_postagem(lista, handle);
+    if (posicao == lista->quantidade || lista->handles[posicao] != handle) {
+        return;
+    }
+    memmove(&lista->handles[posicao], &lista->handles[posicao + 1],
+            (size_t)(lista->quantidade - posicao - 1) * sizeof(int));
+    memmove(&lista->frequencias[posicao], &lista->frequencias[posicao + 1],
+            (size_t)(lista->quantidade - posicao - 1) * sizeof(float));
+    lista->quantidade--;
+}
+
+/**
+ * @brief Garante uma lista (vazia) para cada ID de termo até `id`.
+ */
+static int garantir_listas(IndiceRelevancia* indice, int id) {
+    if (id < indice->capacidade_listas) {
+        return 1;
+    }
+    int nova = indice->capacidade_listas > 0 ? indice->capacidade_listas : CAPACIDADE_INICIAL_LISTAS;
+    while (nova <= id) {
+        nova *= 2;
+    }
+    PostagensTermo* listas = (PostagensTermo*) realloc(indice->listas, (size_t)nova * sizeof(PostagensTermo));
+    if (listas == NULL) {
+        perror("ERRO (garantir_listas): Falha ao alocar listas de postagens");
+        return 0;
+    }
+    for (int i = indice->capacidade_listas; i < nova; i++) {
+        listas[i].handles = NULL;
+        listas[i].frequencias = NULL;
+        listas[i].quantidade = 0;
+        listas[i].capacidade = 0;
+        listas[i].frequencia_maxima = 0.0f;
+        listas[i].comprimento_minimo = 0.0f;
+    }
+    indice->listas = listas;
+    indice->capacidade_listas = nova;
+    return 1;
+}
+
+/**
+ * @brief Garante uma entrada em `comprimentos` para o handle.
+ */
+static int garantir_comprimentos(IndiceRelevancia* indice, int handle) {
+    if (handle < indice->capacidade_handles) {
+        return 1;
+    }
+    int nova = indice->capacidade_handles > 0 ? indice->capacidade_handles : CAPACIDADE_INICIAL_COMPRIMENTOS;
+    while (nova <= handle) {
+        nova *= 2;
+    }
+    float* comprimentos = (float*) realloc(indice->comprimentos, (size_t)nova * sizeof(float));
+    if (comprimentos == NULL) {
+        perror("ERRO (garantir_comprimentos): Falha ao alocar comprimentos");
+        return 0;
+    }
+    for (int i = indice->capacidade_handles; i < nova; i++) {
+        comprimentos[i] = COMPRIMENTO_AUSENTE;
+    }
+    indice->comprimentos = comprimentos;
+    indice->capacidade_handles = nova;
+    return 1;
+}
+
+/**
+ * @brief Cursor sobre a lista de um termo da busca.
+ */
+typedef struct {
+    const PostagensTermo* lista; ///< Postagens do termo.
+    int posicao;                 ///< Postagem atual.
+    double idf;                  ///< idf do termo.
+    double limite;               ///< Limite superior da contribuição do termo.
+} CursorTermo;
+
+/**
+ * @brief Handle da postagem atual do cursor, ou INT_MAX se a lista acabou.
+ */
+static int handle_do_cursor(const CursorTermo* cursor) {
+    return cursor->posicao < cursor->lista->quantidade ? cursor->lista->handles[cursor->posicao] : INT_MAX;
+}
+
+/**
+ * @brief Avança o cursor até a primeira postagem com handle >= alvo: saltos
+ * exponenciais a partir da posição atual, seguidos de busca binária.
+ */
+static void avancar_cursor(CursorTermo* cursor, int alvo) {
+    const int* handles = cursor->lista->handles;
+    int quantidade = cursor->lista->quantidade;
+    int inicio = cursor->posicao;
+    int salto = 1;
+    while (inicio + salto < quantidade && handles[inicio + salto] < alvo) {
+        inicio += salto;
+        salto *= 2;
+    }
+    int fim = inicio + salto < quantidade ? inicio + salto : quantidade;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (handles[meio] < alvo) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    cursor->posicao = inicio;
+}
+
+/**
+ * @brief Contribuição BM25 de um termo com frequência `f` em um livro de comprimento `l`.
+ */
+static double pontuar_termo(double idf, double f, double l, double comprimento_medio) {
+    return idf * f * (BM25_K1 + 1.0) / (f + BM25_K1 * (1.0 - BM25_B + BM25_B * l / comprimento_medio));
+}
+
+/**
+ * @brief Indica se o resultado `a` é pior que `b` (menor pontuação; no empate, maior handle).
+ */
+static int resultado_pior(const ResultadoRelevancia* a, const ResultadoRelevancia* b) {
+    return a->pontuacao < b->pontuacao || (a->pontuacao == b->pontuacao && a->handle > b->handle);
+}
+
+/**
+ * @brief Insere no heap de mínimo dos melhores resultados (o pior no topo), substituindo
+ * o topo quando o heap está cheio.
+ */
+static void registrar_resultado(ResultadoRelevancia* heap, int* quantidade, int maximo, ResultadoRelevancia novo) {
+    int i;
+    if (*quantidade < maximo) {
+        // Sobe a partir do fim
+        i = (*quantidade)++;
+        while (i > 0 && resultado_pior(&novo, &heap[(i - 1) / 2])) {
+            heap[i] = heap[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+    } else {
+        // Desce a partir do topo
+        i = 0;
+        for (;;) {
+            int filho = 2 * i + 1;
+            if (filho >= maximo) {
+                break;
+            }
+            if (filho + 1 < maximo && resultado_pior(&heap[filho + 1], &heap[filho])) {
+                filho++;
+            }
+            if (!resultado_pior(&heap[filho], &novo)) {
+                break;
+            }
+            heap[i] = heap[filho];
+            i = filho;
+        }
+    }
+    heap[i] = novo;
+}
+
+/**
+ * @brief Função de comparação para qsort: pontuação decrescente, depois handle crescente.
+ */
+static int comparar_resultados_relevancia(const void* a, const void* b) {
+    const ResultadoRelevancia* x = (const ResultadoRelevancia*)a;
+    const ResultadoRelevancia* y = (const ResultadoRelevancia*)b;
+    return resultado_pior(x, y) - resultado_pior(y, x);
+}
+
+// --- FUNÇÕES DO ÍNDICE ---
+
+void inicializar_indice_relevancia(IndiceRelevancia* indice) {
+    inicializar_dicionario_textos(&indice->termos);
+    indice->listas = NULL;
+    indice->capacidade_listas = 0;
+    indice->comprimentos = NULL;
+    indice->capacidade_handles = 0;
+    indice->documentos = 0;
+    indice->comprimento_total = 0.0;
+}
+
+int adicionar_livro_indice_relevancia(IndiceRelevancia* indice, const char* titulo, const char* autor,
+                                      const char* genero, int handle) {
+    if (indice == NULL || handle < 0 || !garantir_comprimentos(indice, handle)) {
+        return 0;
+    }
+    if (indice->comprimentos[handle] != COMPRIMENTO_AUSENTE) {
+        return 0; // Já indexado
+    }
+
+    TermoLivro termos[MAX_TERMOS_LIVRO];
+    float comprimento;
+    int quantidade = coletar_termos(titulo, autor, genero, termos, &comprimento);
+
+    for (int t = 0; t < quantidade; t++) {
+        int id = internar_texto(&indice->termos, termos[t].texto);
+        if (id < 0 || !garantir_listas(indice, id) ||
+            !inserir_postagem(&indice->listas[id], handle, termos[t].frequencia, comprimento)) {
+            // Desfaz os termos já indexados (e a referência deste, se foi internado)
+            if (id >= 0) {
+                liberar_referencia_texto(&indice->termos, id);
+            }
+            for (int u = 0; u < t; u++) {
+                int anterior = buscar_id_texto(&indice->termos, termos[u].texto);
+                remover_postagem(&indice->listas[anterior], handle);
+                liberar_referencia_texto(&indice->termos, anterior);
+            }
+            return 0;
+        }
+    }
+
+    indice->comprimentos[handle] = comprimento;
+    indice->documentos++;
+    indice->comprimento_total += comprimento;
+    return 1;
+}
+
+void remover_livro_indice_relevancia(IndiceRelevancia* indice, const char* titulo, const char* autor,
+                                     const char* genero, int handle) {
+    if (indice == NULL || handle < 0 || handle >= indice->capacidade_handles ||
+        indice->comprimentos[handle] == COMPRIMENTO_AUSENTE) {
+        return;
+    }
+
+    TermoLivro termos[MAX_TERMOS_LIVRO];
+    float comprimento;
+    int quantidade = coletar_termos(titulo, autor, genero, termos, &comprimento);
+    for (int t = 0; t < quantidade; t++) {
+        int id = buscar_id_texto(&indice->termos, termos[t].texto);
+        if (id >= 0 && id < indice->capacidade_listas) {
+            remover_postagem(&indice->listas[id], handle);
+            liberar_referencia_texto(&indice->termos, id);
+        }
+    }
+
+    indice->documentos--;
+    indice->comprimento_total -= indice->comprimentos[handle];
+    indice->comprimentos[handle] = COMPRIMENTO_AUSENTE;
+}
+
+int buscar_relevancia(const IndiceRelevancia* indice, const char* consulta, ResultadoRelevancia* resultados, int maximo) {
+    if (indice == NULL || consulta == NULL || resultados == NULL || maximo <= 0 || indice->documentos == 0) {
+        return 0;
+    }
+
+    // 1. Termos distintos da busca que existem no índice, com idf e limite superior
+    double n = indice->documentos;
+    double comprimento_medio = indice->comprimento_total / n;
+    if (comprimento_medio <= 0.0) {
+        comprimento_medio = 1.0;
+    }
+    CursorTermo cursores[MAX_TERMOS_RELEVANCIA];
+    int termos_busca = 0;
+    const char* cursor_texto = consulta;
+    char termo[TAM_TERMO_RELEVANCIA];
+    while (termos_busca < MAX_TERMOS_RELEVANCIA && proximo_termo(&cursor_texto, termo, sizeof(termo)) > 0) {
+        int id = buscar_id_texto(&indice->termos, termo);
+        if (id < 0 || id >= indice->capacidade_listas || indice->listas[id].quantidade == 0) {
+            continue;
+        }
+        int repetido = 0;
+        for (int t = 0; t < termos_busca; t++) {
+            repetido |= cursores[t].lista == &indice->listas[id];
+        }
+        if (repetido) {
+            continue;
+        }
+        const PostagensTermo* lista = &indice->listas[id];
+        CursorTermo* c = &cursores[termos_busca++];
+        c->lista = lista;
+        c->posicao = 0;
+        c->idf = log(1.0 + (n - lista->quantidade + 0.5) / (lista->quantidade + 0.5));
+        // Margem relativa mínima contra arredondamentos: o limite nunca fica abaixo de
+        // uma pontuação real.
+        c->limite = pontuar_termo(c->idf, lista->frequencia_maxima, lista->comprimento_minimo, comprimento_medio) * (1.0 + 1e-9);
+    }
+    if (termos_busca == 0) {
+        return 0;
+    }
+
+    // 2. WAND: os cursores ficam ordenados pelo handle atual; o pivô é o primeiro
+    // cursor em que a soma dos limites supera a pior pontuação entre os melhores.
+    int encontrados = 0;
+    for (;;) {
+        for (int i = 1; i < termos_busca; i++) {
+            CursorTermo atual = cursores[i];
+            int handle_atual = handle_do_cursor(&atual);
+            int j = i - 1;
+            while (j >= 0 && handle_do_cursor(&cursores[j]) > handle_atual) {
+                cursores[j + 1] = cursores[j];
+                j--;
+            }
+            cursores[j + 1] = atual;
+        }
+
+        double limiar = encontrados == maximo ? resultados[0].pontuacao : 0.0;
+        double acumulado = 0.0;
+        int pivo = -1;
+        for (int i = 0; i < termos_busca && handle_do_cursor(&cursores[i]) != INT_MAX; i++) {
+            acumulado += cursores[i].limite;
+            if (acumulado > limiar) {
+                pivo = i;
+                break;
+            }
+        }
+        if (pivo < 0) {
+            break; // Nenhum livro restante pode entrar entre os melhores
+        }
+
+        int handle_pivo = handle_do_cursor(&cursores[pivo]);
+        if (handle_do_cursor(&cursores[0]) == handle_pivo) {
+            // Todos os cursores até o pivô estão no mesmo livro: pontuação completa
+            double comprimento = indice->comprimentos[handle_pivo];
+            double pontuacao = 0.0;
+            for (int i = 0; i < termos_busca && handle_do_cursor(&cursores[i]) == handle_pivo; i++) {
+                pontuacao += pontuar_termo(cursores[i].idf, cursores[i].lista->frequencias[cursores[i].posicao],
+                                           comprimento, comprimento_medio);
+                cursores[i].posicao++;
+            }
+            ResultadoRelevancia novo = { handle_pivo, pontuacao };
+            if (encontrados < maximo || resultado_pior(&resultados[0], &novo)) {
+                registrar_resultado(resultados, &encontrados, maximo, novo);
+            }
+        } else {
+            // Nenhum livro antes do pivô alcança o limiar: os cursores anteriores saltam até ele
+            for (int i = 0; i < pivo; i++) {
+                avancar_cursor(&cursores[i], handle_pivo);
+            }
+        }
+    }
+
+    qsort(resultados, (size_t)encontrados, sizeof(ResultadoRelevancia), comparar_resultados_relevancia);
+    return encontrados;
+}
+
+void liberar_indice_relevancia(IndiceRelevancia* indice) {
+    if (indice == NULL) {
+        return;
+    }
+    for (int i = 0; i < indice->capacidade_listas; i++) {
+        free(indice->listas[i].handles);
+        free(indice->listas[i].frequencias);
+    }
+    free(indice->listas);
+    free(indice->comprimentos);
+    liberar_dicionario_textos(&indice->termos);
+    inicializar_indice_relevancia(indice);
+}
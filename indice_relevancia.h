@@ -0,0 +1,123 @@
+#ifndef INDICE_RELEVANCIA_H
+#define INDICE_RELEVANCIA_H
+
+#include "arena_textos.h" // Dicionário dos termos distintos
+
+/**
+ * @file indice_relevancia.h
+ * @brief Define o índice invertido usado na busca por relevância (texto livre sobre
+ * título, autor e gênero), com pontuação BM25.
+ *
+ * Os textos dobrados dos três campos são divididos em palavras (ver `proximo_termo` em
+ * normalizacao.h). Cada termo distinto tem uma lista de postagens (handle e frequência
+ * do termo no livro) em ordem crescente de handle. A frequência soma as ocorrências
+ * de cada campo multiplicadas pelo peso do campo (um termo no título vale mais do que
+ * no gênero), e o comprimento do livro é a soma ponderada das palavras dos campos.
+ *
+ * A pontuação de um livro é a soma, para cada termo da busca, de
+ *     idf(t) * f * (k1 + 1) / (f + k1 * (1 - b + b * comprimento / comprimento_medio))
+ * com idf(t) = ln(1 + (N - df + 0.5) / (df + 0.5)).
+ *
+ * A busca devolve os K melhores livros sem pontuar todos os que contêm algum termo:
+ * com o algoritmo WAND, cada termo tem um limite superior da sua contribuição
+ * (calculado com a maior frequência e o menor comprimento já vistos na lista) e as
+ * listas são percorridas em conjunto; livros cuja soma dos limites não supera a
+ * pior pontuação entre os K melhores são pulados por busca nas listas, de modo que
+ * termos comuns ("de", "o") quase não custam nada depois que os K primeiros lugares
+ * estão ocupados por livros com termos raros.
+ *
+ * Como os demais índices de textos, quem mantém o índice informa os textos e o handle
+ * em cada inserção e remoção.
+ */
+
+/** @brief Parâmetros do BM25: saturação da frequência (k1) e normalização pelo comprimento (b). */
+#define BM25_K1 1.2
+#define BM25_B 0.75
+
+/** @brief Pesos dos campos na frequência dos termos e no comprimento dos livros. */
+#define PESO_RELEVANCIA_TITULO 3.0f
+#define PESO_RELEVANCIA_AUTOR 2.0f
+#define PESO_RELEVANCIA_GENERO 1.0f
+
+/** @brief Número máximo de palavras distintas consideradas em uma busca. */
+#define MAX_TERMOS_RELEVANCIA 16
+
+/**
+ * @brief Postagens de um termo: livros que o contêm, em ordem crescente de handle.
+ */
+typedef struct {
+    int* handles;                ///< Handles dos livros, em ordem crescente.
+    float* frequencias;          ///< Frequência ponderada do termo em cada livro.
+    int quantidade;              ///< Número de postagens (df do termo).
+    int capacidade;              ///< Capacidade alocada dos vetores.
+    float frequencia_maxima;     ///< Maior frequência já vista na lista (nunca diminui).
+    float comprimento_minimo;    ///< Menor comprimento de livro já visto na lista (nunca aumenta).
+} PostagensTermo;
+
+/**
+ * @brief Estrutura do índice de relevância.
+ */
+typedef struct {
+    DicionarioTextos termos;     ///< Termos distintos (ID = lista em `listas`).
+    PostagensTermo* listas;      ///< Postagens de cada termo.
+    int capacidade_listas;       ///< Capacidade alocada de `listas`.
+    float* comprimentos;         ///< Comprimento ponderado de cada handle (-1 = não indexado).
+    int capacidade_handles;      ///< Capacidade alocada de `comprimentos`.
+    int documentos;              ///< Número de livros indexados (N).
+    double comprimento_total;    ///< Soma dos comprimentos dos livros indexados.
+} IndiceRelevancia;
+
+/**
+ * @brief Livro encontrado pela busca por relevância.
+ */
+typedef struct {
+    int handle;                  ///< Handle do livro.
+    double pontuacao;            ///< Pontuação BM25 (maior = mais relevante).
+} ResultadoRelevancia;
+
+// --- Protótipos das Funções ---
+
+/**
+ * @brief Inicializa um índice vazio. Nenhuma memória é alocada até a primeira inserção.
+ * @param indice Ponteiro para o IndiceRelevancia. Não deve ser NULL.
+ */
+void inicializar_indice_relevancia(IndiceRelevancia* indice);
+
+/**
+ * @brief Indexa os campos (já dobrados) de um livro.
+ * @param indice Ponteiro para o IndiceRelevancia.
+ * @param titulo Título dobrado. Não deve ser NULL.
+ * @param autor Autor dobrado. Não deve ser NULL.
+ * @param genero Gênero dobrado. Não deve ser NULL.
+ * @param handle Handle (não negativo) do livro, ainda não indexado.
+ * @return int 1 em caso de sucesso, 0 se alguma alocação falhar (nada é indexado).
+ */
+int adicionar_livro_indice_relevancia(IndiceRelevancia* indice, const char* titulo, const char* autor,
+                                      const char* genero, int handle);
+
+/**
+ * @brief Remove um livro do índice. Os textos devem ser os mesmos da inserção.
+ * Handles não indexados são ignorados.
+ */
+void remover_livro_indice_relevancia(IndiceRelevancia* indice, const char* titulo, const char* autor,
+                                     const char* genero, int handle);
+
+/**
+ * @brief Busca os livros mais relevantes para as palavras da consulta (BM25 + WAND).
+ * @param indice Ponteiro constante para o IndiceRelevancia.
+ * @param consulta Texto da busca, já dobrado. Palavras repetidas contam uma vez;
+ * apenas as MAX_TERMOS_RELEVANCIA primeiras palavras distintas são consideradas.
+ * @param resultados Vetor com `maximo` posições que recebe os resultados, em ordem
+ * decrescente de pontuação (empates em ordem crescente de handle).
+ * @param maximo Número máximo de resultados.
+ * @return int O número de resultados gravados (0 se nenhum livro contiver as palavras).
+ */
+int buscar_relevancia(const IndiceRelevancia* indice, const char* consulta, ResultadoRelevancia* resultados, int maximo);
+
+/**
+ * @brief Libera toda a memória do índice e o deixa vazio (reutilizável).
+ * @param indice Ponteiro para o IndiceRelevancia. Se NULL, a função não faz nada.
+ */
+void liberar_indice_relevancia(IndiceRelevancia* indice);
+
+#endif // INDICE_RELEVANCIA_H
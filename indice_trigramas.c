@@ -0,0 +1,354 @@
+#include <stdio.h>
+#include <stdlib.h> // Para malloc, realloc, free e qsort
+#include <string.h> // Para strlen e memmove
+#include "indice_trigramas.h"
+
+/** @brief Capacidade mínima da tabela de trigramas na primeira alocação. */
+#define CAPACIDADE_MINIMA_TRIGRAMAS 256
+/** @brief Capacidade inicial de uma lista de postagens. */
+#define CAPACIDADE_INICIAL_POSTAGENS 4
+/** @brief Trigramas tratados com um vetor na pilha; textos maiores usam malloc. */
+#define TRIGRAMAS_NA_PILHA 128
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Espalha os bits do código do trigrama (multiplicação de Fibonacci).
+ */
+static unsigned int hash_trigrama(unsigned int trigrama) {
+    return (trigrama * 2654435769u) >> 8;
+}
+
+/**
+ * @brief Função de comparação para qsort de códigos de trigramas.
+ */
+static int comparar_codigos(const void* a, const void* b) {
+    unsigned int x = *(const unsigned int*)a;
+    unsigned int y = *(const unsigned int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Extrai os trigramas distintos do texto, em ordem crescente de código.
+ * @param texto Texto de origem.
+ * @param pilha Vetor com TRIGRAMAS_NA_PILHA posições, usado se o texto couber nele.
+ * @param codigos Recebe o vetor usado (`pilha` ou um vetor alocado, que o chamador libera).
+ * @return int O número de trigramas distintos, ou -1 se a alocação falhar.
+ */
+static int extrair_trigramas(const char* texto, unsigned int* pilha, unsigned int** codigos) {
+    size_t tamanho = strlen(texto);
+    *codigos = pilha;
+    if (tamanho < 3) {
+        return 0;
+    }
+    size_t total = tamanho - 2;
+    if (total > TRIGRAMAS_NA_PILHA) {
+        *codigos = (unsigned int*) malloc(total * sizeof(unsigned int));
+        if (*codigos == NULL) {
+            perror("ERRO (extrair_trigramas): Falha ao alocar vetor de trigramas");
+            return -1;
+        }
+    }
+
+    const unsigned char* bytes = (const unsigned char*)texto;
+    for (size_t i = 0; i < total; i++) {
+        (*codigos)[i] = ((unsigned int)bytes[i] << 16) | ((unsigned int)bytes[i + 1] << 8) | bytes[i + 2];
+    }
+    qsort(*codigos, total, sizeof(unsigned int), comparar_codigos);
+
+    int distintos = 0;
+    for (size_t i = 0; i < total; i++) {
+        if (distintos == 0 || (*codigos)[distintos - 1] != (*codigos)[i]) {
+            (*codigos)[distintos++] = (*codigos)[i];
+        }
+    }
+    return distintos;
+}
+
+/**
+ * @brief Localiza a posição da tabela onde o trigrama está (ou estaria, se ausente).
+ */
+static unsigned int localizar_trigrama(const IndiceTrigramas* indice, unsigned int trigrama) {
+    unsigned int mascara = (unsigned int)indice->capacidade - 1;
+    unsigned int pos = hash_trigrama(trigrama) & mascara;
+    while (indice->entradas[pos].trigrama != 0 && indice->entradas[pos].trigrama != trigrama) {
+        pos = (pos + 1) & mascara;
+    }
+    return pos;
+}
+
+/**
+ * @brief Retorna a lista do trigrama, ou NULL se ele não estiver na tabela.
+ */
+static const ListaPostagens* obter_lista(const IndiceTrigramas* indice, unsigned int trigrama) {
+    if (indice->capacidade == 0) {
+        return NULL;
+    }
+    unsigned int pos = localizar_trigrama(indice, trigrama);
+    return indice->entradas[pos].trigrama == 0 ? NULL : &indice->entradas[pos].lista;
+}
+
+/**
+ * @brief Dobra a tabela (fator de carga <= 50%) e reinsere as entradas existentes.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar (a tabela antiga é preservada).
+ */
+static int crescer_tabela_trigramas(IndiceTrigramas* indice) {
+    int nova_capacidade = indice->capacidade > 0 ? indice->capacidade * 2 : CAPACIDADE_MINIMA_TRIGRAMAS;
+    EntradaTrigrama* novas = (EntradaTrigrama*) calloc((size_t)nova_capacidade, sizeof(EntradaTrigrama));
+    if (novas == NULL) {
+        perror("ERRO (crescer_tabela_trigramas): Falha ao alocar tabela de trigramas");
+        return 0;
+    }
+
+    unsigned int mascara = (unsigned int)nova_capacidade - 1;
+    for (int i = 0; i < indice->capacidade; i++) {
+        if (indice->entradas[i].trigrama == 0) {
+            continue;
+        }
+        unsigned int pos = hash_trigrama(indice->entradas[i].trigrama) & mascara;
+        while (novas[pos].trigrama != 0) {
+            pos = (pos + 1) & mascara;
+        }
+        novas[pos] = indice->entradas[i];
+    }
+
+    free(indice->entradas);
+    indice->entradas = novas;
+    indice->capacidade = nova_capacidade;
+    return 1;
+}
+
+/**
+ * @brief Busca binária: primeira posição da lista com handle >= `handle`, a partir de `inicio`.
+ */
+static int limite_inferior(const int* handles, int inicio, int fim, int handle) {
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (handles[meio] < handle) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return inicio;
+}
+
+/**
+ * @brief Insere o handle na lista, mantendo a ordem crescente.
+ * Handles novos costumam ser os maiores, então o caso comum é um acréscimo no final.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+static int inserir_postagem(ListaPostagens* lista, int handle) {
+    if (lista->quantidade == lista->capacidade) {
+        int nova = lista->capacidade > 0 ? lista->capacidade * 2 : CAPACIDADE_INICIAL_POSTAGENS;
+        int* handles = (int*) realloc(lista->handles, (size_t)nova * sizeof(int));
+        if (handles == NULL) {
+            perror("ERRO (inserir_postagem): Falha ao alocar lista de postagens");
+            return 0;
+        }
+        lista->handles = handles;
+        lista->capacidade = nova;
+    }
+
+    int pos = lista->quantidade;
+    if (pos > 0 && lista->handles[pos - 1] >= handle) {
+        pos = limite_inferior(lista->handles, 0, lista->quantidade, handle);
+        if (lista->handles[pos] == handle) {
+            return 1; // Já indexado
+        }
+        memmove(&lista->handles[pos + 1], &lista->handles[pos], (size_t)(lista->quantidade - pos) * sizeof(int));
+    }
+    lista->handles[pos] = handle;
+    lista->quantidade++;
+    return 1;
+}
+
+// --- FUNÇÕES DO ÍNDICE ---
+
+void inicializar_indice_trigramas(IndiceTrigramas* indice) {
+    indice->entradas = NULL;
+    indice->capacidade = 0;
+    indice->quantidade = 0;
+}
+
+int adicionar_texto_indice_trigramas(IndiceTrigramas* indice, const char* texto, int handle) {
+    if (indice == NULL || texto == NULL || handle < 0) {
+        return 0;
+    }
+
+    unsigned int pilha[TRIGRAMAS_NA_PILHA];
+    unsigned int* codigos;
+    int quantidade = extrair_trigramas(texto, pilha, &codigos);
+    if (quantidade < 0) {
+        return 0;
+    }
+
+    int sucesso = 1;
+    for (int i = 0; i < quantidade && sucesso; i++) {
+        if ((indice->quantidade + 1) * 2 > indice->capacidade && !crescer_tabela_trigramas(indice)) {
+            sucesso = 0;
+            break;
+        }
+        unsigned int pos = localizar_trigrama(indice, codigos[i]);
+        if (indice->entradas[pos].trigrama == 0) {
+            indice->entradas[pos].trigrama = codigos[i];
+            indice->quantidade++;
+        }
+        sucesso = inserir_postagem(&indice->entradas[pos].lista, handle);
+    }
+
+    if (codigos != pilha) {
+        free(codigos);
+    }
+    return sucesso;
+}
+
+void remover_texto_indice_trigramas(IndiceTrigramas* indice, const char* texto, int handle) {
+    if (indice == NULL || texto == NULL || indice->capacidade == 0) {
+        return;
+    }
+
+    unsigned int pilha[TRIGRAMAS_NA_PILHA];
+    unsigned int* codigos;
+    int quantidade = extrair_trigramas(texto, pilha, &codigos);
+    for (int i = 0; i < quantidade; i++) {
+        unsigned int pos = localizar_trigrama(indice, codigos[i]);
+        ListaPostagens* lista = &indice->entradas[pos].lista;
+        if (indice->entradas[pos].trigrama == 0 || lista->quantidade == 0) {
+            continue;
+        }
+        int p = limite_inferior(lista->handles, 0, lista->quantidade, handle);
+        if (p < lista->quantidade && lista->handles[p] == handle) {
+            memmove(&lista->handles[p], &lista->handles[p + 1], (size_t)(lista->quantidade - p - 1) * sizeof(int));
+            lista->quantidade--;
+        }
+        // A entrada do trigrama fica na tabela mesmo com a lista vazia (sem marcadores de remoção).
+    }
+
+    if (codigos != pilha) {
+        free(codigos);
+    }
+}
+
+/**
+ * @brief Função de comparação para qsort de listas de postagens pelo tamanho.
+ */
+static int comparar_tamanho_listas(const void* a, const void* b) {
+    const ListaPostagens* x = *(const ListaPostagens* const*)a;
+    const ListaPostagens* y = *(const ListaPostagens* const*)b;
+    return (x->quantidade > y->quantidade) - (x->quantidade < y->quantidade);
+}
+
+int buscar_candidatos_trigramas(const IndiceTrigramas* indice, const char* padrao, int** candidatos, int* quantidade) {
+    if (indice == NULL || padrao == NULL || candidatos == NULL || quantidade == NULL) {
+        return 0;
+    }
+    *candidatos = NULL;
+    *quantidade = 0;
+
+    unsigned int pilha[TRIGRAMAS_NA_PILHA];
+    unsigned int* codigos;
+    int total_trigramas = extrair_trigramas(padrao, pilha, &codigos);
+    if (total_trigramas <= 0) {
+        return 0; // Padrão curto demais (ou falha de alocação): varredura completa
+    }
+
+    const ListaPostagens** listas = (const ListaPostagens**) malloc((size_t)total_trigramas * sizeof(ListaPostagens*));
+    if (listas == NULL) {
+        if (codigos != pilha) {
+            free(codigos);
+        }
+        return 0;
+    }
+
+    int vazio = 0;
+    for (int i = 0; i < total_trigramas; i++) {
+        listas[i] = obter_lista(indice, codigos[i]);
+        if (listas[i] == NULL || listas[i]->quantidade == 0) {
+            vazio = 1; // Algum trigrama do padrão não aparece em nenhum texto
+            break;
+        }
+    }
+    if (codigos != pilha) {
+        free(codigos);
+    }
+    if (vazio) {
+        free(listas);
+        return 1;
+    }
+
+    // Interseção começando pela lista mais curta: o resultado nunca é maior que ela
+    // e cada lista seguinte é consultada por busca binária avançando da última posição.
+    qsort(listas, (size_t)total_trigramas, sizeof(ListaPostagens*), comparar_tamanho_listas);
+    int* resultado = (int*) malloc((size_t)listas[0]->quantidade * sizeof(int));
+    if (resultado == NULL) {
+        perror("ERRO (buscar_candidatos_trigramas): Falha ao alocar candidatos");
+        free(listas);
+        return 0;
+    }
+    memcpy(resultado, listas[0]->handles, (size_t)listas[0]->quantidade * sizeof(int));
+    int restantes = listas[0]->quantidade;
+
+    for (int l = 1; l < total_trigramas && restantes > 0; l++) {
+        const ListaPostagens* lista = listas[l];
+        int mantidos = 0;
+        int inicio = 0;
+        for (int i = 0; i < restantes; i++) {
+            inicio = limite_inferior(lista->handles, inicio, lista->quantidade, resultado[i]);
+            if (inicio == lista->quantidade) {
+                break;
+            }
+            if (lista->handles[inicio] == resultado[i]) {
+                resultado[mantidos++] = resultado[i];
+            }
+        }
+        restantes = mantidos;
+    }
+    free(listas);
+
+    if (restantes == 0) {
+        free(resultado);
+        return 1;
+    }
+    *candidatos = resultado;
+    *quantidade = restantes;
+    return 1;
+}
+
+int estimar_candidatos_trigramas(const IndiceTrigramas* indice, const char* padrao) {
+    if (indice == NULL || padrao == NULL) {
+        return -1;
+    }
+
+    unsigned int pilha[TRIGRAMAS_NA_PILHA];
+    unsigned int* codigos;
+    int total_trigramas = extrair_trigramas(padrao, pilha, &codigos);
+    if (total_trigramas <= 0) {
+        return -1;
+    }
+
+    // A interseção nunca é maior que a lista mais curta.
+    int menor = -1;
+    for (int i = 0; i < total_trigramas && menor != 0; i++) {
+        const ListaPostagens* lista = obter_lista(indice, codigos[i]);
+        int tamanho = lista != NULL ? lista->quantidade : 0;
+        if (menor < 0 || tamanho < menor) {
+            menor = tamanho;
+        }
+    }
+    if (codigos != pilha) {
+        free(codigos);
+    }
+    return menor;
+}
+
+void liberar_indice_trigramas(IndiceTrigramas* indice) {
+    if (indice == NULL) {
+        return;
+    }
+    for (int i = 0; i < indice->capacidade; i++) {
+        free(indice->entradas[i].lista.handles);
+    }
+    free(indice->entradas);
+    inicializar_indice_trigramas(indice);
+}
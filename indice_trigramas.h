@@ -0,0 +1,106 @@
+#ifndef INDICE_TRIGRAMAS_H
+#define INDICE_TRIGRAMAS_H
+
+/**
+ * @file indice_trigramas.h
+ * @brief Define um índice invertido de trigramas (sequências de 3 bytes) usado para
+ * acelerar buscas por substring em textos dos livros (títulos e autores).
+ *
+ * Para cada trigrama presente em algum texto indexado, o índice guarda a lista
+ * ordenada dos handles dos registros cujo texto o contém. Toda ocorrência de um
+ * padrão com 3 ou mais bytes contém todos os trigramas do padrão; assim, a interseção
+ * das listas desses trigramas é um conjunto pequeno de candidatos, que depois é
+ * verificado com `strstr`. Padrões com menos de 3 bytes não podem usar o índice.
+ *
+ * O índice não conhece a coleção: quem o mantém informa o texto e o handle em cada
+ * inserção e remoção.
+ */
+
+/**
+ * @brief Lista ordenada (crescente, sem repetições) de handles que contêm um trigrama.
+ */
+typedef struct {
+    int* handles;                ///< Handles em ordem crescente.
+    int quantidade;              ///< Número de handles na lista.
+    int capacidade;              ///< Capacidade alocada de `handles`.
+} ListaPostagens;
+
+/**
+ * @brief Entrada da tabela hash de trigramas.
+ * Uma entrada está livre quando `trigrama` é 0 (nenhum trigrama de texto tem código 0,
+ * pois os textos não contêm o byte nulo).
+ */
+typedef struct {
+    unsigned int trigrama;       ///< Os 3 bytes do trigrama empacotados em um inteiro.
+    ListaPostagens lista;        ///< Handles dos registros que contêm o trigrama.
+} EntradaTrigrama;
+
+/**
+ * @brief Estrutura do índice de trigramas.
+ */
+typedef struct {
+    EntradaTrigrama* entradas;   ///< Tabela hash (sondagem linear), tamanho `capacidade`.
+    int capacidade;              ///< Número de entradas (potência de 2, ou 0 se não alocada).
+    int quantidade;              ///< Número de trigramas distintos na tabela.
+} IndiceTrigramas;
+
+// --- Protótipos das Funções ---
+
+/**
+ * @brief Inicializa um índice vazio. Nenhuma memória é alocada até a primeira inserção.
+ * @param indice Ponteiro para o IndiceTrigramas. Não deve ser NULL.
+ */
+void inicializar_indice_trigramas(IndiceTrigramas* indice);
+
+/**
+ * @brief Indexa os trigramas de um texto para o handle informado.
+ * @param indice Ponteiro para o IndiceTrigramas.
+ * @param texto Texto do registro. Não deve ser NULL.
+ * @param handle Handle (não negativo) do registro.
+ * @return int 1 em caso de sucesso, 0 se alguma alocação falhar (nesse caso, o
+ * chamador deve desfazer com `remover_texto_indice_trigramas`).
+ */
+int adicionar_texto_indice_trigramas(IndiceTrigramas* indice, const char* texto, int handle);
+
+/**
+ * @brief Remove o handle das listas de todos os trigramas do texto.
+ * Handles ausentes de uma lista são ignorados.
+ * @param indice Ponteiro para o IndiceTrigramas.
+ * @param texto Texto que foi indexado para o handle. Não deve ser NULL.
+ * @param handle Handle do registro removido.
+ */
+void remover_texto_indice_trigramas(IndiceTrigramas* indice, const char* texto, int handle);
+
+/**
+ * @brief Calcula os candidatos a conter o padrão: os handles presentes nas listas
+ * de todos os trigramas do padrão.
+ *
+ * @param indice Ponteiro constante para o IndiceTrigramas.
+ * @param padrao Texto buscado.
+ * @param candidatos Recebe um vetor alocado com os handles candidatos, em ordem
+ * crescente (ou NULL se não houver candidatos). O chamador deve liberá-lo com free.
+ * @param quantidade Recebe o número de candidatos.
+ * @return int 1 se o índice pôde ser usado; 0 se o padrão tiver menos de 3 bytes ou se
+ * uma alocação falhar (o chamador deve então examinar todos os registros).
+ * @note Os candidatos ainda precisam ser verificados: conter todos os trigramas não
+ * garante conter o padrão.
+ */
+int buscar_candidatos_trigramas(const IndiceTrigramas* indice, const char* padrao, int** candidatos, int* quantidade);
+
+/**
+ * @brief Estima, sem alocar candidatos, quantos registros `buscar_candidatos_trigramas`
+ * retornaria: o tamanho da menor lista entre os trigramas do padrão (um limite superior).
+ * @param indice Ponteiro constante para o IndiceTrigramas.
+ * @param padrao Texto buscado.
+ * @return int O limite estimado, ou -1 se o índice não puder ser usado (padrão com
+ * menos de 3 bytes ou falha de alocação).
+ */
+int estimar_candidatos_trigramas(const IndiceTrigramas* indice, const char* padrao);
+
+/**
+ * @brief Libera toda a memória do índice e o deixa vazio (reutilizável).
+ * @param indice Ponteiro para o IndiceTrigramas. Se NULL, a função não faz nada.
+ */
+void liberar_indice_trigramas(IndiceTrigramas* indice);
+
+#endif // INDICE_TRIGRAMAS_H
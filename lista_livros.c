@@ -1,12 +1,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include "lista_livros.h" // Assume que define ColecaoLivros, NoLista e Livro, e protótipo de exibir_livro
+#include "lista_livros.h" // Assume que define ColecaoLivros e Livro, e protótipo de exibir_livro
+#include "normalizacao.h" // Dobra do gênero para o índice de relevância
 
 // --- FUNÇÕES IMPLEMENTADAS E APRIMORADAS ---
 
 /**
- * @brief Cria e inicializa uma nova coleção de livros (lista encadeada).
+ * @brief Cria e inicializa uma nova coleção de livros (armazenamento contíguo vazio).
  * @return ColecaoLivros* Um ponteiro para a nova coleção alocada, ou NULL se a alocação falhar.
  */
 ColecaoLivros* criar_colecao() {
@@ -17,23 +18,289 @@ ColecaoLivros* criar_colecao() {
         return NULL;
     }
 
-    nova_colecao->inicio = NULL;
-    nova_colecao->quantidade = 0;
+    inicializar_armazem(&nova_colecao->armazem);
+    inicializar_indice_isbn(&nova_colecao->indice_isbn);
+    inicializar_indice_anos(&nova_colecao->indice_anos);
+    inicializar_indice_generos(&nova_colecao->indice_generos);
+    nova_colecao->indice_titulos = NULL; // Índices de trigramas desativados por padrão
+    nova_colecao->indice_autores = NULL;
+    nova_colecao->prefixos_titulos = NULL; // Índices de prefixos (autocompletar) também
+    nova_colecao->prefixos_autores = NULL;
+    nova_colecao->indice_difuso = NULL;
+    nova_colecao->indice_relevancia = NULL;
+    nova_colecao->cache_consultas = NULL;
+    nova_colecao->visoes = NULL;
+    nova_colecao->ordem_atual = ORDEM_INDEFINIDA; // Nenhuma ordenação feita ainda
+    nova_colecao->armazem_em_ordem = 0;
+    nova_colecao->geracao = 0;
 
     return nova_colecao;
 }
 
 /**
- * @brief Adiciona um novo livro à coleção (lista encadeada).
- * O novo livro é adicionado no início da lista para eficiência (O(1)).
- * Uma cópia dos dados de 'novo_livro_dados' é armazenada na lista.
+ * @brief Remove o registro dos índices de trigramas ativos (se houver).
+ */
+static void desindexar_trigramas(ColecaoLivros* colecao, const RegistroLivro* registro, int handle) {
+    if (colecao->indice_titulos != NULL) {
+        remover_texto_indice_trigramas(colecao->indice_titulos, titulo_dobrado_registro(&colecao->armazem, registro), handle);
+    }
+    if (colecao->indice_autores != NULL) {
+        remover_texto_indice_trigramas(colecao->indice_autores, autor_dobrado_registro(&colecao->armazem, registro), handle);
+    }
+}
+
+/**
+ * @brief Indexa título e autor do registro nos índices de trigramas ativos (se houver).
+ * @return int 1 em caso de sucesso, 0 se alguma alocação falhar (o registro é então
+ * retirado de ambos os índices).
+ */
+static int indexar_trigramas(ColecaoLivros* colecao, const RegistroLivro* registro, int handle) {
+    int sucesso = 1;
+    if (colecao->indice_titulos != NULL) {
+        sucesso = adicionar_texto_indice_trigramas(colecao->indice_titulos, titulo_dobrado_registro(&colecao->armazem, registro), handle);
+    }
+    if (sucesso && colecao->indice_autores != NULL) {
+        sucesso = adicionar_texto_indice_trigramas(colecao->indice_autores, autor_dobrado_registro(&colecao->armazem, registro), handle);
+    }
+    if (!sucesso) {
+        desindexar_trigramas(colecao, registro, handle);
+    }
+    return sucesso;
+}
+
+/**
+ * @brief Retira um uso do título e do autor do registro dos índices de prefixos (se ativos).
+ */
+static void desindexar_prefixos(ColecaoLivros* colecao, const RegistroLivro* registro) {
+    if (colecao->prefixos_titulos == NULL) {
+        return;
+    }
+    remover_texto_indice_prefixos(colecao->prefixos_titulos, titulo_dobrado_registro(&colecao->armazem, registro));
+    remover_texto_indice_prefixos(colecao->prefixos_autores, autor_dobrado_registro(&colecao->armazem, registro));
+}
+
+/**
+ * @brief Registra o título e o autor do registro nos índices de prefixos (se ativos).
+ * @return int 1 em caso de sucesso, 0 se alguma alocação falhar (nada fica registrado).
+ */
+static int indexar_prefixos(ColecaoLivros* colecao, const RegistroLivro* registro) {
+    if (colecao->prefixos_titulos == NULL) {
+        return 1;
+    }
+    const char* titulo_dobrado = titulo_dobrado_registro(&colecao->armazem, registro);
+    if (!adicionar_texto_indice_prefixos(colecao->prefixos_titulos, titulo_dobrado, titulo_registro(&colecao->armazem, registro))) {
+        return 0;
+    }
+    if (!adicionar_texto_indice_prefixos(colecao->prefixos_autores, autor_dobrado_registro(&colecao->armazem, registro),
+                                         autor_registro(&colecao->armazem, registro))) {
+        remover_texto_indice_prefixos(colecao->prefixos_titulos, titulo_dobrado);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Indexa título, autor e gênero do registro no índice de relevância (se ativo).
+ * O gênero é o único campo sem versão dobrada no armazenamento.
+ */
+static int indexar_relevancia(ColecaoLivros* colecao, const RegistroLivro* registro, int handle) {
+    if (colecao->indice_relevancia == NULL) {
+        return 1;
+    }
+    char genero[TAM_GENERO];
+    dobrar_texto(genero_registro(&colecao->armazem, registro), genero, sizeof(genero));
+    return adicionar_livro_indice_relevancia(colecao->indice_relevancia, titulo_dobrado_registro(&colecao->armazem, registro),
+                                             autor_dobrado_registro(&colecao->armazem, registro), genero, handle);
+}
+
+/**
+ * @brief Remove o registro do índice de relevância (se ativo).
+ */
+static void desindexar_relevancia(ColecaoLivros* colecao, const RegistroLivro* registro, int handle) {
+    if (colecao->indice_relevancia == NULL) {
+        return;
+    }
+    char genero[TAM_GENERO];
+    dobrar_texto(genero_registro(&colecao->armazem, registro), genero, sizeof(genero));
+    remover_livro_indice_relevancia(colecao->indice_relevancia, titulo_dobrado_registro(&colecao->armazem, registro),
+                                    autor_dobrado_registro(&colecao->armazem, registro), genero, handle);
+}
+
+/**
+ * @brief Remove o registro de todos os índices de textos ativos (se houver).
+ * Deve ser chamada enquanto o registro ainda está no armazenamento.
+ */
+static void desindexar_textos(ColecaoLivros* colecao, int handle) {
+    const RegistroLivro* registro = obter_registro_armazem(&colecao->armazem, handle);
+    if (registro == NULL) {
+        return;
+    }
+    desindexar_trigramas(colecao, registro, handle);
+    desindexar_prefixos(colecao, registro);
+    if (colecao->indice_difuso != NULL) {
+        remover_texto_indice_difuso(colecao->indice_difuso, titulo_dobrado_registro(&colecao->armazem, registro), handle);
+    }
+    desindexar_relevancia(colecao, registro, handle);
+}
+
+/**
+ * @brief Indexa os textos do registro em todos os índices de textos ativos (se houver).
+ * @return int 1 em caso de sucesso, 0 se alguma alocação falhar (o registro é então
+ * retirado de todos os índices).
+ */
+static int indexar_textos(ColecaoLivros* colecao, int handle) {
+    const RegistroLivro* registro = obter_registro_armazem(&colecao->armazem, handle);
+    if (!indexar_trigramas(colecao, registro, handle)) {
+        return 0;
+    }
+    if (!indexar_prefixos(colecao, registro)) {
+        desindexar_trigramas(colecao, registro, handle);
+        return 0;
+    }
+    if (colecao->indice_difuso != NULL &&
+        !adicionar_texto_indice_difuso(colecao->indice_difuso, titulo_dobrado_registro(&colecao->armazem, registro), handle)) {
+        desindexar_textos(colecao, handle);
+        return 0;
+    }
+    if (!indexar_relevancia(colecao, registro, handle)) {
+        desindexar_textos(colecao, handle); // Ignora o próprio índice de relevância (não indexado)
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Insere o livro nas visões ordenadas (se ativas).
+ * @return int 1 em caso de sucesso, 0 se alguma alocação falhar (nada fica inserido).
+ */
+static int inserir_visoes(ColecaoLivros* colecao, int handle) {
+    if (colecao->visoes == NULL) {
+        return 1;
+    }
+    for (int v = 0; v < QUANTIDADE_VISOES; v++) {
+        if (!inserir_visao_ordenada(&colecao->visoes[v], &colecao->armazem, handle)) {
+            while (--v >= 0) {
+                remover_visao_ordenada(&colecao->visoes[v], &colecao->armazem, handle);
+            }
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Remove o livro das visões ordenadas (se ativas).
+ * Deve ser chamada enquanto o registro ainda está no armazenamento.
+ */
+static void remover_visoes(ColecaoLivros* colecao, int handle) {
+    if (colecao->visoes == NULL) {
+        return;
+    }
+    for (int v = 0; v < QUANTIDADE_VISOES; v++) {
+        remover_visao_ordenada(&colecao->visoes[v], &colecao->armazem, handle);
+    }
+}
+
+/**
+ * @brief Confere se o livro na posição informada está em ordem com os vizinhos, na
+ * ordem registrada da coleção; se não estiver, o armazenamento deixa de estar em ordem.
+ * Chamada para a posição de cada livro que chega ao armazenamento (inserção no final
+ * ou último livro trazido para o lugar de um removido).
+ */
+static void conferir_ordem_armazem(ColecaoLivros* colecao, int posicao) {
+    if (colecao->ordem_atual == ORDEM_INDEFINIDA || !colecao->armazem_em_ordem) {
+        return;
+    }
+    const ArmazemLivros* armazem = &colecao->armazem;
+    TipoVisao tipo = (TipoVisao) colecao->ordem_atual;
+    const RegistroLivro* registro = &armazem->registros[posicao];
+    if ((posicao > 0 && comparar_chaves_visao(tipo, armazem, &armazem->registros[posicao - 1], registro) > 0) ||
+        (posicao + 1 < armazem->quantidade &&
+         comparar_chaves_visao(tipo, armazem, registro, &armazem->registros[posicao + 1]) > 0)) {
+        colecao->armazem_em_ordem = 0;
+    }
+}
+
+/**
+ * @brief Insere um livro (lido por ponteiro) no armazenamento e no índice de ISBN.
+ * Compartilhada pela inserção unitária e pela inserção em lote.
+ *
+ * @param colecao Ponteiro para a ColecaoLivros (não nulo).
+ * @param livro Livro a ser inserido.
+ * @param quantidade_antes_lote Quantidade de livros da coleção antes do lote atual;
+ * um ISBN já indexado em posição igual ou posterior foi inserido pelo próprio lote.
+ * @return ResultadoInsercao O resultado da inserção.
+ */
+static ResultadoInsercao inserir_livro(ColecaoLivros* colecao, const Livro* livro, int quantidade_antes_lote) {
+    // O ISBN é normalizado uma única vez; daqui em diante só a chave é comparada.
+    ChaveIsbn chave = chave_isbn(livro->isbn);
+    if (chave == CHAVE_ISBN_INVALIDA) {
+        return INSERCAO_ISBN_INVALIDO;
+    }
+
+    int existente = buscar_handle_indice_isbn(&colecao->indice_isbn, chave);
+    if (existente >= 0) {
+        if (chave_isbn_textual(chave) &&
+            strcmp(obter_registro_armazem(&colecao->armazem, existente)->isbn, livro->isbn) != 0) {
+            return INSERCAO_COLISAO_ISBN; // Textos diferentes com o mesmo hash
+        }
+        return posicao_do_handle(&colecao->armazem, existente) >= quantidade_antes_lote
+                   ? INSERCAO_DUPLICADO_LOTE
+                   : INSERCAO_DUPLICADO_COLECAO;
+    }
+
+    int handle = inserir_registro_armazem(&colecao->armazem, livro, chave);
+    if (handle == HANDLE_INVALIDO) {
+        return INSERCAO_FALHA_MEMORIA; // O armazenamento já reporta o erro
+    }
+
+    if (!inserir_indice_isbn(&colecao->indice_isbn, chave, handle)) {
+        remover_registro_armazem(&colecao->armazem, handle);
+        return INSERCAO_FALHA_MEMORIA;
+    }
+    if (!inserir_indice_anos(&colecao->indice_anos, livro->anoPublicacao, handle)) {
+        remover_indice_isbn(&colecao->indice_isbn, chave);
+        remover_registro_armazem(&colecao->armazem, handle);
+        return INSERCAO_FALHA_MEMORIA;
+    }
+    int id_genero = obter_registro_armazem(&colecao->armazem, handle)->id_genero;
+    if (!inserir_indice_generos(&colecao->indice_generos, id_genero, handle)) {
+        remover_indice_anos(&colecao->indice_anos, livro->anoPublicacao, handle);
+        remover_indice_isbn(&colecao->indice_isbn, chave);
+        remover_registro_armazem(&colecao->armazem, handle);
+        return INSERCAO_FALHA_MEMORIA;
+    }
+    if (!indexar_textos(colecao, handle)) {
+        remover_indice_generos(&colecao->indice_generos, id_genero, handle);
+        remover_indice_anos(&colecao->indice_anos, livro->anoPublicacao, handle);
+        remover_indice_isbn(&colecao->indice_isbn, chave);
+        remover_registro_armazem(&colecao->armazem, handle);
+        return INSERCAO_FALHA_MEMORIA;
+    }
+    if (!inserir_visoes(colecao, handle)) {
+        desindexar_textos(colecao, handle);
+        remover_indice_generos(&colecao->indice_generos, id_genero, handle);
+        remover_indice_anos(&colecao->indice_anos, livro->anoPublicacao, handle);
+        remover_indice_isbn(&colecao->indice_isbn, chave);
+        remover_registro_armazem(&colecao->armazem, handle);
+        return INSERCAO_FALHA_MEMORIA;
+    }
+    conferir_ordem_armazem(colecao, colecao->armazem.quantidade - 1);
+    colecao->geracao++;
+    return INSERCAO_SUCESSO;
+}
+
+/**
+ * @brief Adiciona um novo livro à coleção.
+ * O novo livro é copiado para o final do vetor denso do armazenamento (O(1) amortizado)
+ * e seu ISBN é registrado no índice hash.
  *
  * @param colecao Ponteiro para a ColecaoLivros onde o livro será adicionado.
  * @param novo_livro_dados Struct Livro contendo os dados do livro a ser adicionado.
  * @return int 1 se o livro foi adicionado com sucesso, 0 em caso de falha
- * (coleção nula ou falha de alocação de memória para o novo nó).
- * @note Esta função permite a adição de livros com ISBNs duplicados.
- * Para inserção ordenada ou no final, funções adicionais seriam necessárias.
+ * (coleção nula, ISBN duplicado ou falha de alocação de memória).
+ * @note O ISBN identifica o livro de forma única: a checagem de duplicidade usa o
+ * índice hash e custa O(1) esperado, de modo que N inserções custam O(N).
  */
 int adicionar_livro_colecao(ColecaoLivros* colecao, Livro novo_livro_dados) {
     if (colecao == NULL) {
@@ -41,24 +308,343 @@ int adicionar_livro_colecao(ColecaoLivros* colecao, Livro novo_livro_dados) {
         return 0; // Falha: coleção nula
     }
 
-    NoLista* novo_no = (NoLista*) malloc(sizeof(NoLista));
-    if (novo_no == NULL) {
-        perror("ERRO: Falha ao alocar memoria para novo no da lista de livros");
-        return 0; // Falha: alocação do nó
+    // Falha se o ISBN for inválido ou já estiver cadastrado, ou se alguma alocação falhar
+    return inserir_livro(colecao, &novo_livro_dados, colecao->armazem.quantidade) == INSERCAO_SUCESSO;
+}
+
+/**
+ * @brief Reserva espaço na coleção para pelo menos `quantidade_total` livros.
+ * @param colecao Ponteiro para a ColecaoLivros.
+ * @param quantidade_total Número total de livros esperado.
+ * @return int 1 em caso de sucesso, 0 se a coleção for nula ou a alocação falhar.
+ */
+int reservar_colecao(ColecaoLivros* colecao, int quantidade_total) {
+    if (colecao == NULL) {
+        return 0;
+    }
+    return reservar_armazem(&colecao->armazem, quantidade_total) &&
+           reservar_indice_isbn(&colecao->indice_isbn, quantidade_total);
+}
+
+/**
+ * @brief Adiciona um lote de livros à coleção, com reserva prévia de espaço e
+ * descarte de ISBNs duplicados (na coleção e dentro do lote) em uma única passada.
+ *
+ * @param colecao Ponteiro para a ColecaoLivros.
+ * @param livros Vetor constante com os livros do lote.
+ * @param quantidade Número de livros no vetor.
+ * @param quantidade_esperada Livros ainda por adicionar, incluindo este lote (0 se desconhecido).
+ * @param resultados Vetor opcional que recebe o resultado de cada livro.
+ * @return int O número de livros efetivamente adicionados.
+ */
+int adicionar_livros_em_lote(ColecaoLivros* colecao, const Livro* livros, int quantidade,
+                             int quantidade_esperada, ResultadoInsercao* resultados) {
+    if (colecao == NULL || livros == NULL || quantidade <= 0) {
+        if (colecao == NULL) {
+            fprintf(stderr, "ERRO: Colecao nao pode ser NULA para adicionar livros em lote.\n");
+        }
+        return 0;
     }
 
-    novo_no->dadosLivro = novo_livro_dados; // Copia a struct Livro inteira
-    novo_no->proximo = colecao->inicio;
-    colecao->inicio = novo_no;
-    colecao->quantidade++;
+    // Uma única reserva para todo o volume esperado evita realocações repetidas
+    // do vetor denso e do índice durante a importação.
+    int quantidade_antes_lote = colecao->armazem.quantidade;
+    int reserva = quantidade_esperada > quantidade ? quantidade_esperada : quantidade;
+    reservar_colecao(colecao, quantidade_antes_lote + reserva); // Em caso de falha, as inserções crescem sob demanda
 
-    return 1; // Sucesso
+    int adicionados = 0;
+    for (int i = 0; i < quantidade; i++) {
+        ResultadoInsercao resultado = inserir_livro(colecao, &livros[i], quantidade_antes_lote);
+        if (resultado == INSERCAO_SUCESSO) {
+            adicionados++;
+        }
+        if (resultados != NULL) {
+            resultados[i] = resultado;
+        }
+    }
+    return adicionados;
+}
+
+/**
+ * @brief Ativa os índices de trigramas de títulos e autores, indexando os livros já presentes.
+ * @param colecao Ponteiro para a ColecaoLivros.
+ * @return int 1 em caso de sucesso (ou se já estavam ativos), 0 se a alocação falhar.
+ */
+int ativar_indices_trigramas(ColecaoLivros* colecao) {
+    if (colecao == NULL) {
+        return 0;
+    }
+    if (colecao->indice_titulos != NULL) {
+        return 1; // Já ativos
+    }
+
+    colecao->indice_titulos = (IndiceTrigramas*) malloc(sizeof(IndiceTrigramas));
+    colecao->indice_autores = (IndiceTrigramas*) malloc(sizeof(IndiceTrigramas));
+    if (colecao->indice_titulos == NULL || colecao->indice_autores == NULL) {
+        perror("ERRO: Falha ao alocar indices de trigramas");
+        free(colecao->indice_titulos);
+        free(colecao->indice_autores);
+        colecao->indice_titulos = NULL;
+        colecao->indice_autores = NULL;
+        return 0;
+    }
+    inicializar_indice_trigramas(colecao->indice_titulos);
+    inicializar_indice_trigramas(colecao->indice_autores);
+
+    for (int i = 0; i < colecao->armazem.quantidade; i++) {
+        int handle = colecao->armazem.handle_de_posicao[i];
+        if (!indexar_trigramas(colecao, obter_registro_armazem(&colecao->armazem, handle), handle)) {
+            desativar_indices_trigramas(colecao);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Desativa e libera os índices de trigramas.
+ * @param colecao Ponteiro para a ColecaoLivros. Se NULL, a função não faz nada.
+ */
+void desativar_indices_trigramas(ColecaoLivros* colecao) {
+    if (colecao == NULL || colecao->indice_titulos == NULL) {
+        return;
+    }
+    liberar_indice_trigramas(colecao->indice_titulos);
+    liberar_indice_trigramas(colecao->indice_autores);
+    free(colecao->indice_titulos);
+    free(colecao->indice_autores);
+    colecao->indice_titulos = NULL;
+    colecao->indice_autores = NULL;
+}
+
+/**
+ * @brief Ativa os índices de prefixos (autocompletar) de títulos e autores,
+ * registrando os livros já presentes.
+ * @param colecao Ponteiro para a ColecaoLivros.
+ * @return int 1 em caso de sucesso (ou se já estavam ativos), 0 se a alocação falhar.
+ */
+int ativar_indices_prefixos(ColecaoLivros* colecao) {
+    if (colecao == NULL) {
+        return 0;
+    }
+    if (colecao->prefixos_titulos != NULL) {
+        return 1; // Já ativos
+    }
+
+    colecao->prefixos_titulos = (IndicePrefixos*) malloc(sizeof(IndicePrefixos));
+    colecao->prefixos_autores = (IndicePrefixos*) malloc(sizeof(IndicePrefixos));
+    if (colecao->prefixos_titulos == NULL || colecao->prefixos_autores == NULL) {
+        perror("ERRO: Falha ao alocar indices de prefixos");
+        free(colecao->prefixos_titulos);
+        free(colecao->prefixos_autores);
+        colecao->prefixos_titulos = NULL;
+        colecao->prefixos_autores = NULL;
+        return 0;
+    }
+    inicializar_indice_prefixos(colecao->prefixos_titulos);
+    inicializar_indice_prefixos(colecao->prefixos_autores);
+
+    for (int i = 0; i < colecao->armazem.quantidade; i++) {
+        if (!indexar_prefixos(colecao, obter_registro_armazem(&colecao->armazem, colecao->armazem.handle_de_posicao[i]))) {
+            desativar_indices_prefixos(colecao);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Desativa e libera os índices de prefixos.
+ * @param colecao Ponteiro para a ColecaoLivros. Se NULL, a função não faz nada.
+ */
+void desativar_indices_prefixos(ColecaoLivros* colecao) {
+    if (colecao == NULL || colecao->prefixos_titulos == NULL) {
+        return;
+    }
+    liberar_indice_prefixos(colecao->prefixos_titulos);
+    liberar_indice_prefixos(colecao->prefixos_autores);
+    free(colecao->prefixos_titulos);
+    free(colecao->prefixos_autores);
+    colecao->prefixos_titulos = NULL;
+    colecao->prefixos_autores = NULL;
+}
+
+/**
+ * @brief Ativa o índice difuso dos termos dos títulos, indexando os livros já presentes.
+ * @param colecao Ponteiro para a ColecaoLivros.
+ * @return int 1 em caso de sucesso (ou se já estava ativo), 0 se a alocação falhar.
+ */
+int ativar_indice_difuso(ColecaoLivros* colecao) {
+    if (colecao == NULL) {
+        return 0;
+    }
+    if (colecao->indice_difuso != NULL) {
+        return 1; // Já ativo
+    }
+
+    colecao->indice_difuso = (IndiceDifuso*) malloc(sizeof(IndiceDifuso));
+    if (colecao->indice_difuso == NULL) {
+        perror("ERRO: Falha ao alocar indice difuso");
+        return 0;
+    }
+    inicializar_indice_difuso(colecao->indice_difuso);
+
+    for (int i = 0; i < colecao->armazem.quantidade; i++) {
+        int handle = colecao->armazem.handle_de_posicao[i];
+        const RegistroLivro* registro = obter_registro_armazem(&colecao->armazem, handle);
+        if (!adicionar_texto_indice_difuso(colecao->indice_difuso, titulo_dobrado_registro(&colecao->armazem, registro), handle)) {
+            desativar_indice_difuso(colecao);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Desativa e libera o índice difuso.
+ * @param colecao Ponteiro para a ColecaoLivros. Se NULL, a função não faz nada.
+ */
+void desativar_indice_difuso(ColecaoLivros* colecao) {
+    if (colecao == NULL || colecao->indice_difuso == NULL) {
+        return;
+    }
+    liberar_indice_difuso(colecao->indice_difuso);
+    free(colecao->indice_difuso);
+    colecao->indice_difuso = NULL;
+}
+
+/**
+ * @brief Ativa o índice de relevância, indexando os livros já presentes.
+ * @param colecao Ponteiro para a ColecaoLivros.
+ * @return int 1 em caso de sucesso (ou se já estava ativo), 0 se a alocação falhar.
+ */
+int ativar_indice_relevancia(ColecaoLivros* colecao) {
+    if (colecao == NULL) {
+        return 0;
+    }
+    if (colecao->indice_relevancia != NULL) {
+        return 1; // Já ativo
+    }
+
+    colecao->indice_relevancia = (IndiceRelevancia*) malloc(sizeof(IndiceRelevancia));
+    if (colecao->indice_relevancia == NULL) {
+        perror("ERRO: Falha ao alocar indice de relevancia");
+        return 0;
+    }
+    inicializar_indice_relevancia(colecao->indice_relevancia);
+
+    for (int i = 0; i < colecao->armazem.quantidade; i++) {
+        int handle = colecao->armazem.handle_de_posicao[i];
+        if (!indexar_relevancia(colecao, obter_registro_armazem(&colecao->armazem, handle), handle)) {
+            desativar_indice_relevancia(colecao);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Desativa e libera o índice de relevância.
+ * @param colecao Ponteiro para a ColecaoLivros. Se NULL, a função não faz nada.
+ */
+void desativar_indice_relevancia(ColecaoLivros* colecao) {
+    if (colecao == NULL || colecao->indice_relevancia == NULL) {
+        return;
+    }
+    liberar_indice_relevancia(colecao->indice_relevancia);
+    free(colecao->indice_relevancia);
+    colecao->indice_relevancia = NULL;
+}
+
+/**
+ * @brief Ativa o cache de resultados de pesquisas.
+ * @param colecao Ponteiro para a ColecaoLivros.
+ * @param capacidade Número máximo de pesquisas guardadas.
+ * @return int 1 em caso de sucesso (ou se já estava ativo), 0 se a alocação falhar.
+ */
+int ativar_cache_consultas(ColecaoLivros* colecao, int capacidade) {
+    if (colecao == NULL) {
+        return 0;
+    }
+    if (colecao->cache_consultas != NULL) {
+        return 1; // Já ativo
+    }
+
+    colecao->cache_consultas = (CacheConsultas*) malloc(sizeof(CacheConsultas));
+    if (colecao->cache_consultas == NULL) {
+        perror("ERRO: Falha ao alocar cache de pesquisas");
+        return 0;
+    }
+    if (!inicializar_cache_consultas(colecao->cache_consultas, capacidade)) {
+        free(colecao->cache_consultas);
+        colecao->cache_consultas = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Desativa e libera o cache de resultados de pesquisas.
+ * @param colecao Ponteiro para a ColecaoLivros. Se NULL, a função não faz nada.
+ */
+void desativar_cache_consultas(ColecaoLivros* colecao) {
+    if (colecao == NULL || colecao->cache_consultas == NULL) {
+        return;
+    }
+    liberar_cache_consultas(colecao->cache_consultas);
+    free(colecao->cache_consultas);
+    colecao->cache_consultas = NULL;
+}
+
+/**
+ * @brief Ativa as visões ordenadas por título, autor e ano.
+ * @param colecao Ponteiro para a ColecaoLivros.
+ * @return int 1 em caso de sucesso (ou se já estavam ativas), 0 se a alocação falhar.
+ */
+int ativar_visoes_ordenadas(ColecaoLivros* colecao) {
+    if (colecao == NULL) {
+        return 0;
+    }
+    if (colecao->visoes != NULL) {
+        return 1; // Já ativas
+    }
+
+    colecao->visoes = (VisaoOrdenada*) malloc(QUANTIDADE_VISOES * sizeof(VisaoOrdenada));
+    if (colecao->visoes == NULL) {
+        perror("ERRO: Falha ao alocar visoes ordenadas");
+        return 0;
+    }
+    for (int v = 0; v < QUANTIDADE_VISOES; v++) {
+        inicializar_visao_ordenada(&colecao->visoes[v], (TipoVisao) v);
+    }
+    for (int v = 0; v < QUANTIDADE_VISOES; v++) {
+        if (!construir_visao_ordenada(&colecao->visoes[v], &colecao->armazem)) {
+            desativar_visoes_ordenadas(colecao);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Desativa e libera as visões ordenadas.
+ * @param colecao Ponteiro para a ColecaoLivros. Se NULL, a função não faz nada.
+ */
+void desativar_visoes_ordenadas(ColecaoLivros* colecao) {
+    if (colecao == NULL || colecao->visoes == NULL) {
+        return;
+    }
+    for (int v = 0; v < QUANTIDADE_VISOES; v++) {
+        liberar_visao_ordenada(&colecao->visoes[v]);
+    }
+    free(colecao->visoes);
+    colecao->visoes = NULL;
 }
 
 /**
  * @brief Remove um livro da coleção com base no ISBN.
- * Percorre a lista, encontra o livro com o ISBN correspondente e o remove,
- * liberando a memória do nó.
+ * Localiza o handle pelo índice de ISBN e remove o registro do armazenamento
+ * (o último registro ocupa a posição liberada). Custo O(1) esperado.
  *
  * @param colecao Ponteiro para a ColecaoLivros.
  * @param isbn String constante contendo o ISBN do livro a ser removido.
@@ -66,48 +652,44 @@ int adicionar_livro_colecao(ColecaoLivros* colecao, Livro novo_livro_dados) {
  * a coleção é nula/vazia ou o ISBN é nulo.
  */
 int remover_livro_colecao(ColecaoLivros* colecao, const char* isbn) {
-    if (colecao == NULL || colecao->inicio == NULL || isbn == NULL || colecao->quantidade == 0) {
+    if (colecao == NULL || isbn == NULL || colecao->armazem.quantidade == 0) {
         if (colecao == NULL || isbn == NULL) {
             fprintf(stderr, "ERRO: Colecao ou ISBN nulos para remocao.\n");
-        } else if (colecao->inicio == NULL) {
+        } else {
             //fprintf(stderr, "AVISO: Tentativa de remover de colecao vazia.\n");
         }
         return 0; // Nada a remover ou parâmetros inválidos
     }
 
-    NoLista* atual = colecao->inicio;
-    NoLista* anterior = NULL;
-
-    // Percorrer a lista para encontrar o livro
-    while (atual != NULL && strcmp(atual->dadosLivro.isbn, isbn) != 0) {
-        anterior = atual;
-        atual = atual->proximo;
-    }
+    // Localizar o registro pelo índice em vez de percorrer a coleção
+    int handle = localizar_livro_por_isbn(colecao, isbn);
 
     // Se o livro não for encontrado
-    if (atual == NULL) {
+    if (handle < 0) {
         return 0; // Livro não encontrado
     }
 
-    // Remover o livro
-    if (anterior == NULL) { // O livro a ser removido é o primeiro da lista
-        colecao->inicio = atual->proximo;
-    } else { // O livro a ser removido está no meio ou no fim da lista
-        anterior->proximo = atual->proximo;
-    }
-
-    // Liberar a memória do nó removido
+    const RegistroLivro* registro = obter_registro_armazem(&colecao->armazem, handle);
+    remover_indice_isbn(&colecao->indice_isbn, registro->chave_isbn);
+    remover_indice_anos(&colecao->indice_anos, registro->anoPublicacao, handle);
+    remover_indice_generos(&colecao->indice_generos, registro->id_genero, handle);
+    desindexar_textos(colecao, handle);
+    remover_visoes(colecao, handle);
+    int posicao = posicao_do_handle(&colecao->armazem, handle);
     // Se Livro tivesse campos alocados dinamicamente, precisariam ser liberados aqui primeiro.
-    free(atual);
-    colecao->quantidade--;
+    remover_registro_armazem(&colecao->armazem, handle);
+    if (posicao < colecao->armazem.quantidade) {
+        conferir_ordem_armazem(colecao, posicao); // O último livro ocupou a posição liberada
+    }
+    colecao->geracao++;
 
     return 1; // Sucesso
 }
 
 /**
  * @brief Lista todos os livros presentes na coleção, exibindo seus detalhes.
- * Utiliza a função 'exibir_livro' (supostamente definida em outro lugar)
- * para formatar a saída de cada livro.
+ * Percorre o vetor denso em ordem de posição, reconstrói cada livro a partir do
+ * registro compacto e utiliza a função 'exibir_livro' para formatar a saída.
  *
  * @param colecao Ponteiro constante para a ColecaoLivros.
  */
@@ -117,50 +699,77 @@ void listar_todos_livros(const ColecaoLivros* colecao) {
         return;
     }
 
-    if (colecao->quantidade == 0) { // ou colecao->inicio == NULL
+    int quantidade = colecao->armazem.quantidade;
+    if (quantidade == 0) {
         printf("A colecao de livros esta vazia.\n");
         return;
     }
 
-    printf("\n--- Listando Todos os Livros (%d) ---\n", colecao->quantidade);
-    NoLista* atual = colecao->inicio;
-
-    int contador = 1;
-    while (atual != NULL) {
-        printf("Livro %d:\n", contador++);
-        exibir_livro(&(atual->dadosLivro)); // Assumindo que exibir_livro() existe e lida bem com const Livro* se necessário
+    printf("\n--- Listando Todos os Livros (%d) ---\n", quantidade);
+    Livro livro; // Reutilizado para reconstruir cada registro compacto
+    const VisaoOrdenada* visao = NULL;
+    if (colecao->ordem_atual != ORDEM_INDEFINIDA && !colecao->armazem_em_ordem && colecao->visoes != NULL) {
+        visao = &colecao->visoes[colecao->ordem_atual]; // Ordem registrada, mantida pela visão
+    }
+    int bloco = 0;
+    int dentro = 0;
+    for (int i = 0; i < quantidade; i++) {
+        const RegistroLivro* registro = &colecao->armazem.registros[i];
+        if (visao != NULL) {
+            if (dentro == visao->blocos[bloco]->quantidade) {
+                bloco++;
+                dentro = 0;
+            }
+            registro = obter_registro_armazem(&colecao->armazem, visao->blocos[bloco]->handles[dentro++]);
+        }
+        printf("Livro %d:\n", i + 1);
+        materializar_livro(&colecao->armazem, registro, &livro);
+        exibir_livro(&livro);
         printf("---\n");
-        atual = atual->proximo;
     }
-    printf("--- Fim da Lista (%d livros listados) ---\n", colecao->quantidade);
+    printf("--- Fim da Lista (%d livros listados) ---\n", quantidade);
 }
 
 /**
- * @brief Busca um livro na coleção pelo ISBN.
+ * @brief Busca um livro na coleção pelo ISBN, consultando o índice hash (O(1) esperado).
  *
  * @param colecao Ponteiro constante para a ColecaoLivros.
  * @param isbn String constante contendo o ISBN do livro a ser buscado.
- * @return const Livro* Um ponteiro constante para a struct Livro encontrada (dentro do nó da lista),
- * ou NULL se o livro não for encontrado ou se a coleção/ISBN forem inválidos.
- * @warning O ponteiro retornado aponta para dados internos da lista.
- * Não modifique o conteúdo apontado (o tipo de retorno `const Livro*` ajuda a impor isso)
- * e não libere este ponteiro. Ele se torna inválido se o livro for removido
- * ou a coleção destruída.
- */
-const Livro* buscar_livro_por_isbn_na_colecao(const ColecaoLivros* colecao, const char* isbn) {
+ * @param livro_encontrado Ponteiro para a struct Livro que receberá os dados do livro
+ * encontrado (reconstruídos do registro compacto), ou NULL se só a existência importar.
+ * @return int 1 se o livro foi encontrado, 0 caso contrário ou se a coleção/ISBN forem inválidos.
+ */
+int buscar_livro_por_isbn_na_colecao(const ColecaoLivros* colecao, const char* isbn, Livro* livro_encontrado) {
     if (colecao == NULL || isbn == NULL) {
-        return NULL;
+        return 0;
     }
 
-    NoLista* atual = colecao->inicio;
-    while (atual != NULL) {
-        if (strcmp(atual->dadosLivro.isbn, isbn) == 0) {
-            return &(atual->dadosLivro); // Retorna ponteiro para o livro dentro do nó
-        }
-        atual = atual->proximo;
+    const RegistroLivro* registro = obter_registro_armazem(&colecao->armazem, localizar_livro_por_isbn(colecao, isbn));
+    if (registro == NULL) {
+        return 0; // Livro não encontrado
     }
+    if (livro_encontrado != NULL) {
+        materializar_livro(&colecao->armazem, registro, livro_encontrado);
+    }
+    return 1;
+}
 
-    return NULL; // Livro não encontrado
+/**
+ * @brief Localiza o handle do livro com o ISBN informado (índice hash; chaves textuais
+ * são confirmadas comparando o texto, pois o hash pode colidir).
+ * @return int O handle, ou -1 se não houver livro com esse ISBN.
+ */
+int localizar_livro_por_isbn(const ColecaoLivros* colecao, const char* isbn) {
+    if (colecao == NULL || isbn == NULL) {
+        return -1;
+    }
+    ChaveIsbn chave = chave_isbn(isbn);
+    int handle = buscar_handle_indice_isbn(&colecao->indice_isbn, chave);
+    if (handle >= 0 && chave_isbn_textual(chave) &&
+        strcmp(obter_registro_armazem(&colecao->armazem, handle)->isbn, isbn) != 0) {
+        return -1; // Outro texto com o mesmo hash
+    }
+    return handle;
 }
 
 /**
@@ -172,11 +781,11 @@ int tamanho_colecao(const ColecaoLivros* colecao) {
     if (colecao == NULL) {
         return 0;
     }
-    return colecao->quantidade;
+    return colecao->armazem.quantidade;
 }
 
 /**
- * @brief Libera toda a memória alocada para a coleção de livros, incluindo todos os nós e a própria estrutura da coleção.
+ * @brief Libera toda a memória alocada para a coleção de livros, incluindo o armazenamento, o índice e a própria estrutura da coleção.
  * Após chamar esta função, o ponteiro para 'colecao' no código chamador se tornará um "dangling pointer"
  * e deve, idealmente, ser atribuído a NULL pelo chamador para evitar seu uso acidental.
  *
@@ -189,21 +798,21 @@ void destruir_colecao(ColecaoLivros* colecao) {
         return;
     }
 
-    NoLista* atual = colecao->inicio;
-    NoLista* proximo_no;
-
-    while (atual != NULL) {
-        proximo_no = atual->proximo;
-        // Se 'dadosLivro' dentro de 'NoLista' contivesse ponteiros que também precisassem
-        // ser liberados (ex: se Livro tivesse campos alocados dinamicamente que a struct 'Livro' "possui"),
-        // seria necessário liberá-los aqui primeiro, antes de liberar 'atual'.
-        // Assumindo que a struct Livro em si não gerencia memória dinâmica dessa forma.
-        free(atual);
-        atual = proximo_no;
-    }
+    // Os registros compactos não possuem memória própria: vetor denso, arena de
+    // títulos e dicionários são liberados de uma só vez pelo armazenamento.
+    liberar_armazem(&colecao->armazem);
+    liberar_indice_isbn(&colecao->indice_isbn);
+    liberar_indice_anos(&colecao->indice_anos);
+    liberar_indice_generos(&colecao->indice_generos);
+    desativar_indices_trigramas(colecao);
+    desativar_indices_prefixos(colecao);
+    desativar_indice_difuso(colecao);
+    desativar_indice_relevancia(colecao);
+    desativar_cache_consultas(colecao);
+    desativar_visoes_ordenadas(colecao);
 
     // Finalmente, liberar a própria estrutura da coleção.
     free(colecao);
     // O chamador é responsável por atribuir seu ponteiro original para NULL, se desejar.
     // Ex: colecao_ptr = NULL; após chamar destruir_colecao(colecao_ptr);
-}
\ No newline at end of file
+}
@@ -2,58 +2,260 @@
 #define LISTA_LIVROS_H
 
 #include "livro.h" // Necessário para a definição da struct Livro
+#include "armazem_livros.h" // Armazenamento contíguo dos registros, endereçados por handles
+#include "indice_isbn.h"    // Índice hash de ISBNs mantido junto do armazenamento
+#include "indice_anos.h"    // Índice ordenado por ano de publicação
+#include "indice_generos.h" // Conjuntos de handles por gênero
+#include "indice_trigramas.h" // Índices opcionais de trigramas (títulos e autores)
+#include "indice_prefixos.h"  // Índices opcionais de prefixos (autocompletar)
+#include "indice_difuso.h"    // Índice opcional de termos dos títulos (busca difusa)
+#include "indice_relevancia.h" // Índice invertido opcional (busca por relevância, BM25)
+#include "cache_consultas.h"   // Cache opcional de resultados de pesquisas
+#include "visoes_ordenadas.h"  // Visões opcionais por título, autor e ano
 
 /**
  * @file lista_livros.h
- * @brief Define as estruturas de dados e protótipos de funções para uma coleção de livros
- * implementada como uma lista encadeada.
+ * @brief Define as estruturas de dados e protótipos de funções para a coleção de livros.
+ *
+ * Os livros ficam em um armazenamento contíguo (ver armazem_livros.h): a coleção é
+ * percorrida em ordem pela posição no vetor denso (0..quantidade-1), o que torna as
+ * varreduras completas leituras sequenciais da memória. Cada livro também tem um
+ * handle estável, usado pelos índices da coleção.
  */
 
-/**
- * @brief Nó da lista encadeada de livros.
- * Cada nó armazena os dados de um livro e um ponteiro para o próximo nó na lista.
- */
-typedef struct NoLista {
-    Livro dadosLivro;          ///< Os dados do livro armazenados neste nó.
-    struct NoLista* proximo;   ///< Ponteiro para o próximo nó na lista (Referenciamento à memória - Ponteiros).
-} NoLista;
+/** @brief Valor de `ordem_atual` quando a coleção não está em nenhuma ordem conhecida. */
+#define ORDEM_INDEFINIDA (-1)
 
 /**
  * @brief Estrutura da coleção de livros.
- * Representa uma lista encadeada de livros, mantendo um ponteiro para o início
- * da lista e a quantidade total de livros.
+ * Mantém o armazenamento dos registros, um índice hash dos ISBNs, um índice
+ * ordenado dos anos de publicação e um índice de gêneros, mantidos sincronizados em
+ * todas as inserções e remoções. Os ISBNs são comparados
+ * pela chave normalizada de 64 bits (chave_isbn.h): hífens e espaços são ignorados
+ * e um ISBN-10 é o mesmo livro que o ISBN-13 equivalente. ISBNs com outros caracteres
+ * usam uma chave textual (hash), confirmada pelo texto em `localizar_livro_por_isbn`.
+ *
+ * Os índices de trigramas, de prefixos, difuso e de relevância e as visões ordenadas
+ * são opcionais (NULL quando desativados);
+ * quando ativos, também são mantidos em todas as inserções e remoções.
+ *
+ * A coleção lembra a ordem deixada pela última ordenação por título, autor ou ano
+ * (`ordem_atual`, um TipoVisao), que passa a ser mantida pela visão ordenada desse tipo
+ * (as visões são ativadas pela ordenação, se preciso): inserções e remoções atualizam
+ * a visão em O(log N) e o armazenamento continua sem deslocamentos (inserção no final,
+ * remoção trazendo o último livro para o buraco). `armazem_em_ordem` diz se o próprio
+ * armazenamento ainda está nessa ordem, conferido em O(1) a cada alteração pelos
+ * vizinhos do livro afetado. A listagem segue a visão, sem ordenar nada; uma nova
+ * ordenação pela mesma chave não faz nada se o armazenamento ainda estiver em ordem e,
+ * se não estiver, copia a ordem da visão em O(N) em vez de comparar os livros de novo.
+ *
+ * A geração é incrementada a cada alteração do conteúdo ou da ordem dos livros
+ * (inserção, remoção, ordenação e, por consequência, carga de arquivo). Resultados
+ * calculados em uma geração, como os do cache de pesquisas, só valem nessa geração.
  */
 typedef struct {
-    NoLista* inicio;           ///< Ponteiro para o primeiro nó da lista (ou NULL se a lista estiver vazia).
-    int quantidade;            ///< Número total de livros na coleção.
+    ArmazemLivros armazem;     ///< Registros dos livros (vetor denso + handles estáveis).
+    IndiceIsbn indice_isbn;    ///< Índice ISBN -> handle, usado em buscas, remoções e checagem de duplicidade.
+    IndiceAnos indice_anos;    ///< Índice ano -> handles, usado em consultas por intervalo de anos.
+    IndiceGeneros indice_generos; ///< Índice ID de gênero -> conjunto de handles (facetas e listagens).
+    IndiceTrigramas* indice_titulos; ///< Trigramas dos títulos (NULL se desativado).
+    IndiceTrigramas* indice_autores; ///< Trigramas dos autores (NULL se desativado).
+    IndicePrefixos* prefixos_titulos; ///< Títulos distintos para autocompletar (NULL se desativado).
+    IndicePrefixos* prefixos_autores; ///< Autores distintos para autocompletar (NULL se desativado).
+    IndiceDifuso* indice_difuso;     ///< BK-tree dos termos dos títulos (NULL se desativado).
+    IndiceRelevancia* indice_relevancia; ///< Postagens de título, autor e gênero (NULL se desativado).
+    CacheConsultas* cache_consultas; ///< Resultados de pesquisas recentes (NULL se desativado).
+    VisaoOrdenada* visoes;     ///< Visões por título, autor e ano (QUANTIDADE_VISOES; NULL se desativadas).
+    int ordem_atual;           ///< TipoVisao da ordem do armazenamento, ou ORDEM_INDEFINIDA.
+    int armazem_em_ordem;      ///< 1 se todo o armazenamento está em `ordem_atual`.
+    unsigned long geracao;     ///< Contador de alterações da coleção.
 } ColecaoLivros;
 
+/**
+ * @brief Resultado da inserção de um livro, informado por registro na inserção em lote.
+ */
+typedef enum {
+    INSERCAO_SUCESSO = 0,           ///< O livro foi adicionado à coleção.
+    INSERCAO_DUPLICADO_COLECAO,     ///< Ignorado: o ISBN já existia na coleção antes do lote.
+    INSERCAO_DUPLICADO_LOTE,        ///< Ignorado: o ISBN já apareceu antes no mesmo lote.
+    INSERCAO_ISBN_INVALIDO,         ///< Ignorado: o ISBN é nulo (ver chave_isbn.h).
+    INSERCAO_COLISAO_ISBN,          ///< Ignorado: outro ISBN textual já usa a mesma chave (hash).
+    INSERCAO_FALHA_MEMORIA          ///< Falha de alocação; o livro não foi adicionado.
+} ResultadoInsercao;
+
 // --- Protótipos das Funções para Manipular a Coleção de Livros ---
 // (Estrutura Complexa - Listas)
 
 /**
  * @brief Cria e inicializa uma nova coleção de livros vazia.
- * Aloca memória para a estrutura ColecaoLivros e define seus campos iniciais
- * (início como NULL e quantidade como 0).
+ * Aloca memória para a estrutura ColecaoLivros e inicializa o armazenamento e o
+ * índice vazios (nenhum registro é alocado até a primeira inserção).
  * @return ColecaoLivros* Um ponteiro para a nova coleção alocada, ou NULL se a alocação de memória falhar.
  */
 ColecaoLivros* criar_colecao();
 
 /**
  * @brief Adiciona um novo livro à coleção.
- * O livro é tipicamente adicionado no início da lista para maior eficiência (O(1)).
- * Uma cópia da struct Livro fornecida é armazenada na lista.
+ * O livro é adicionado ao final do armazenamento contíguo (O(1) amortizado). Se a
+ * coleção tiver uma ordem registrada (ver `ordem_atual`), ele entra na sua posição da
+ * visão correspondente em O(log N), em vez de exigir uma nova ordenação.
+ * Uma cópia da struct Livro fornecida é armazenada e seu ISBN é indexado.
  *
  * @param colecao Ponteiro para a ColecaoLivros onde o livro será adicionado.
  * @param novo_livro A struct Livro contendo os dados do livro a ser adicionado.
  * @return int 1 se o livro foi adicionado com sucesso, 0 em caso de falha
- * (coleção nula ou falha de alocação de memória para o novo nó).
+ * (coleção nula, ISBN nulo, já existente ou colidindo com outro ISBN textual, ou falha de
+ * alocação de memória).
  */
 int adicionar_livro_colecao(ColecaoLivros* colecao, Livro novo_livro);
 
+/**
+ * @brief Reserva, de uma só vez, espaço para que a coleção comporte pelo menos
+ * `quantidade_total` livros (armazenamento e índice de ISBN) sem realocações.
+ * Útil antes de importações grandes cujo tamanho é conhecido ou estimável.
+ *
+ * @param colecao Ponteiro para a ColecaoLivros.
+ * @param quantidade_total Número total de livros esperado na coleção após a importação.
+ * @return int 1 em caso de sucesso, 0 se a coleção for nula ou a alocação falhar.
+ */
+int reservar_colecao(ColecaoLivros* colecao, int quantidade_total);
+
+/**
+ * @brief Adiciona um lote de livros à coleção em uma única passada.
+ * Antes de inserir, reserva espaço para `quantidade_esperada` livros adicionais
+ * (ou para o tamanho do lote, se for maior). Os livros são lidos por ponteiro,
+ * sem cópias intermediárias das structs. ISBNs repetidos são descartados tanto em
+ * relação ao conteúdo anterior da coleção quanto dentro do próprio lote (vale a
+ * primeira ocorrência), com uma única consulta ao índice por livro.
+ *
+ * Para importar um fluxo (ex: arquivo lido em blocos), chame esta função para cada
+ * bloco, passando em `quantidade_esperada` o número de livros ainda por vir.
+ *
+ * @param colecao Ponteiro para a ColecaoLivros onde os livros serão adicionados.
+ * @param livros Vetor constante com os livros do lote.
+ * @param quantidade Número de livros no vetor.
+ * @param quantidade_esperada Número total de livros que ainda serão adicionados
+ * (incluindo este lote); use 0 se desconhecido.
+ * @param resultados Vetor opcional (pode ser NULL) com `quantidade` posições, que
+ * recebe o resultado da inserção de cada livro.
+ * @return int O número de livros efetivamente adicionados.
+ */
+int adicionar_livros_em_lote(ColecaoLivros* colecao, const Livro* livros, int quantidade,
+                             int quantidade_esperada, ResultadoInsercao* resultados);
+
+/**
+ * @brief Ativa os índices de trigramas de títulos e autores, indexando os livros
+ * já presentes. A partir daí, os índices são mantidos a cada inserção e remoção, e as
+ * buscas por substring (ver pesquisa_ordenacao.h) examinam apenas os candidatos.
+ * Custa memória proporcional ao total de caracteres de títulos e autores.
+ *
+ * @param colecao Ponteiro para a ColecaoLivros.
+ * @return int 1 em caso de sucesso (ou se já estavam ativos), 0 se a alocação falhar
+ * (os índices continuam desativados).
+ */
+int ativar_indices_trigramas(ColecaoLivros* colecao);
+
+/**
+ * @brief Desativa e libera os índices de trigramas; as buscas voltam a examinar
+ * todos os livros.
+ * @param colecao Ponteiro para a ColecaoLivros. Se NULL, a função não faz nada.
+ */
+void desativar_indices_trigramas(ColecaoLivros* colecao);
+
+/**
+ * @brief Ativa os índices de prefixos de títulos e autores, registrando os livros já
+ * presentes. A partir daí, os índices são mantidos a cada inserção e remoção e
+ * alimentam o autocompletar (ver `sugerir_completamentos` em pesquisa_ordenacao.h).
+ * Custa memória proporcional ao total de caracteres dos títulos e autores distintos.
+ *
+ * @param colecao Ponteiro para a ColecaoLivros.
+ * @return int 1 em caso de sucesso (ou se já estavam ativos), 0 se a alocação falhar
+ * (os índices continuam desativados).
+ */
+int ativar_indices_prefixos(ColecaoLivros* colecao);
+
+/**
+ * @brief Desativa e libera os índices de prefixos.
+ * @param colecao Ponteiro para a ColecaoLivros. Se NULL, a função não faz nada.
+ */
+void desativar_indices_prefixos(ColecaoLivros* colecao);
+
+/**
+ * @brief Ativa o índice difuso (BK-tree dos termos dos títulos), indexando os livros
+ * já presentes. A partir daí, o índice é mantido a cada inserção e remoção e permite
+ * a busca tolerante a erros de digitação (ver `pesquisar_titulos_aproximados` em
+ * pesquisa_ordenacao.h).
+ *
+ * @param colecao Ponteiro para a ColecaoLivros.
+ * @return int 1 em caso de sucesso (ou se já estava ativo), 0 se a alocação falhar
+ * (o índice continua desativado).
+ */
+int ativar_indice_difuso(ColecaoLivros* colecao);
+
+/**
+ * @brief Desativa e libera o índice difuso.
+ * @param colecao Ponteiro para a ColecaoLivros. Se NULL, a função não faz nada.
+ */
+void desativar_indice_difuso(ColecaoLivros* colecao);
+
+/**
+ * @brief Ativa o índice de relevância (postagens dos termos de título, autor e gênero),
+ * indexando os livros já presentes. A partir daí, o índice é mantido a cada inserção e
+ * remoção e permite a busca por relevância (ver `pesquisar_por_relevancia` em
+ * pesquisa_ordenacao.h).
+ *
+ * @param colecao Ponteiro para a ColecaoLivros.
+ * @return int 1 em caso de sucesso (ou se já estava ativo), 0 se a alocação falhar
+ * (o índice continua desativado).
+ */
+int ativar_indice_relevancia(ColecaoLivros* colecao);
+
+/**
+ * @brief Desativa e libera o índice de relevância.
+ * @param colecao Ponteiro para a ColecaoLivros. Se NULL, a função não faz nada.
+ */
+void desativar_indice_relevancia(ColecaoLivros* colecao);
+
+/**
+ * @brief Ativa o cache LRU de resultados de pesquisas (por título, por autor e por
+ * relevância). Pesquisas repetidas sem alterações da coleção entre elas são
+ * atendidas pelo cache; qualquer alteração (ver `geracao`) descarta os resultados.
+ *
+ * @param colecao Ponteiro para a ColecaoLivros.
+ * @param capacidade Número máximo de pesquisas guardadas (ex: CAPACIDADE_CACHE_PADRAO).
+ * @return int 1 em caso de sucesso (ou se já estava ativo), 0 se a alocação falhar
+ * (o cache continua desativado).
+ */
+int ativar_cache_consultas(ColecaoLivros* colecao, int capacidade);
+
+/**
+ * @brief Desativa e libera o cache de pesquisas.
+ * @param colecao Ponteiro para a ColecaoLivros. Se NULL, a função não faz nada.
+ */
+void desativar_cache_consultas(ColecaoLivros* colecao);
+
+/**
+ * @brief Ativa as visões ordenadas por título, autor e ano (ver visoes_ordenadas.h),
+ * construídas uma vez a partir dos livros atuais e depois mantidas a cada inserção e
+ * remoção. Com elas, a coleção pode ser listada em qualquer dessas ordens sem ser
+ * ordenada e sem alterar a ordem do armazenamento.
+ *
+ * @param colecao Ponteiro para a ColecaoLivros.
+ * @return int 1 em caso de sucesso (ou se já estavam ativas), 0 se a alocação falhar
+ * (as visões continuam desativadas).
+ */
+int ativar_visoes_ordenadas(ColecaoLivros* colecao);
+
+/**
+ * @brief Desativa e libera as visões ordenadas.
+ * @param colecao Ponteiro para a ColecaoLivros. Se NULL, a função não faz nada.
+ */
+void desativar_visoes_ordenadas(ColecaoLivros* colecao);
+
 /**
  * @brief Remove um livro da coleção com base no seu ISBN.
- * Procura o livro pelo ISBN e, se encontrado, remove-o da lista e libera a memória do nó.
+ * Localiza o registro pelo índice de ISBN e, se encontrado, remove-o do armazenamento
+ * em tempo O(1) esperado. O último livro da coleção passa a ocupar a posição liberada.
  *
  * @param colecao Ponteiro para a ColecaoLivros de onde o livro será removido.
  * @param isbn String constante contendo o ISBN do livro a ser removido.
@@ -65,6 +267,8 @@ int remover_livro_colecao(ColecaoLivros* colecao, const char* isbn);
 /**
  * @brief Lista todos os livros presentes na coleção.
  * Exibe os detalhes de cada livro na coleção no console, utilizando a função `exibir_livro`.
+ * Com uma ordem registrada (ver `ordem_atual`), os livros saem nessa ordem, lida da
+ * visão ordenada quando o armazenamento não está mais nela.
  *
  * @param colecao Ponteiro constante para a ColecaoLivros a ser listada.
  * A coleção não é modificada por esta função.
@@ -72,23 +276,34 @@ int remover_livro_colecao(ColecaoLivros* colecao, const char* isbn);
 void listar_todos_livros(const ColecaoLivros* colecao);
 
 /**
- * @brief Busca um livro na coleção pelo seu ISBN.
+ * @brief Busca um livro na coleção pelo seu ISBN, em tempo O(1) esperado (via índice hash).
+ * Como a coleção guarda os livros em formato compacto, os dados do livro encontrado
+ * são reconstruídos e copiados para a struct apontada por 'livro_encontrado'.
  *
  * @param colecao Ponteiro constante para a ColecaoLivros onde a busca será realizada.
  * @param isbn String constante contendo o ISBN do livro a ser buscado.
- * @return const Livro* Um ponteiro constante para a struct Livro encontrada dentro da lista.
- * Retorna NULL se o livro não for encontrado, ou se a coleção/ISBN forem inválidos.
- * @warning O ponteiro retornado aponta para dados internos da lista. Este ponteiro
- * não deve ser usado para modificar os dados do livro (o tipo `const Livro*` ajuda a
- * impor isso) e não deve ser liberado pelo chamador. O ponteiro se torna inválido
- * se o livro for removido da coleção ou se a coleção for destruída.
+ * @param livro_encontrado Ponteiro para uma struct Livro onde os dados do livro
+ * encontrado serão armazenados. Pode ser NULL se só a existência importar.
+ * @return int 1 se o livro foi encontrado, 0 se não foi encontrado ou se a
+ * coleção/ISBN forem inválidos.
+ */
+int buscar_livro_por_isbn_na_colecao(const ColecaoLivros* colecao, const char* isbn, Livro* livro_encontrado);
+
+/**
+ * @brief Localiza o handle do livro com o ISBN informado, em tempo O(1) esperado.
+ * As chaves textuais (ver chave_isbn.h) são confirmadas comparando o texto do ISBN.
+ *
+ * @param colecao Ponteiro constante para a ColecaoLivros.
+ * @param isbn String constante contendo o ISBN.
+ * @return int O handle do livro, ou -1 se não houver livro com esse ISBN (ou se a
+ * coleção/ISBN forem nulos).
  */
-const Livro* buscar_livro_por_isbn_na_colecao(const ColecaoLivros* colecao, const char* isbn);
+int localizar_livro_por_isbn(const ColecaoLivros* colecao, const char* isbn);
 
 /**
  * @brief Libera toda a memória alocada para a coleção de livros.
- * Percorre a lista, liberando cada nó individualmente, e depois libera a própria
- * estrutura da coleção.
+ * Libera de uma só vez o armazenamento contíguo e o índice de ISBN, e depois
+ * libera a própria estrutura da coleção.
  *
  * @param colecao Ponteiro para a ColecaoLivros a ser destruída.
  * Se `colecao` for NULL, a função não faz nada.
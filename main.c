@@ -10,10 +10,18 @@
 #include "fila_desejos.h"
 #include "arquivos.h"
 #include "pesquisa_ordenacao.h"
+#include "consulta.h"
+#include "ordenacao_externa.h"
 
 // --- Constantes Globais ---
 #define ARQUIVO_BINARIO "biblioteca.dat"
 #define ARQUIVO_TEXTO "biblioteca.txt"
+#define ARQUIVO_BINARIO_ORDENADO "biblioteca_ordenada.dat"
+#define RESULTADOS_POR_PAGINA 5
+#define MAX_SUGESTOES 8
+#define MAX_GENEROS_LISTADOS 64
+#define MAX_PRIMEIROS_LIVROS 100
+#define MAX_RESULTADOS_RELEVANCIA 10
 
 // --- Protótipos das Funções de Gerenciamento do Menu ---
 void limpar_tela();
@@ -23,6 +31,15 @@ void gerenciar_adicao_livro(ColecaoLivros* colecao, PilhaHistorico* historico);
 void gerenciar_remocao_livro(ColecaoLivros* colecao);
 void gerenciar_busca_isbn(const ColecaoLivros* colecao, PilhaHistorico* historico);
 void gerenciar_busca_titulo(const ColecaoLivros* colecao, PilhaHistorico* historico);
+void gerenciar_busca_autor(const ColecaoLivros* colecao, PilhaHistorico* historico);
+void gerenciar_consulta_combinada(const ColecaoLivros* colecao, PilhaHistorico* historico);
+void gerenciar_listagem_por_ano(const ColecaoLivros* colecao);
+void gerenciar_listagem_por_genero(const ColecaoLivros* colecao);
+void gerenciar_primeiros_livros(const ColecaoLivros* colecao);
+void gerenciar_busca_relevancia(const ColecaoLivros* colecao, PilhaHistorico* historico);
+void gerenciar_ordenacao_por_criterios(ColecaoLivros* colecao);
+void gerenciar_listagem_ordenada(const ColecaoLivros* colecao);
+void gerenciar_ordenacao_externa();
 void gerenciar_adicao_desejo(FilaDesejos* fila);
 void gerenciar_processar_desejo(FilaDesejos* fila);
 void gerenciar_ver_historico(const PilhaHistorico* historico);
@@ -61,6 +78,15 @@ void exibir_menu_completo() {
     printf("13. Carregar Colecao de Arquivo Texto\n");
     printf("14. Salvar Colecao em Arquivo Binario\n");
     printf("15. Carregar Colecao de Arquivo Binario\n");
+    printf("16. Buscar Livro por Autor\n");
+    printf("17. Consulta Combinada (titulo, autor, ano, genero, ISBN)\n");
+    printf("18. Listar Livros por Intervalo de Anos\n");
+    printf("19. Generos: Contagens e Listagem\n");
+    printf("20. Ver Primeiros Livros por Titulo, Autor ou Ano (sem reordenar)\n");
+    printf("21. Busca por Relevancia (titulo, autor e genero)\n");
+    printf("22. Ordenar Colecao por Varios Criterios (ex: autor, ano, titulo)\n");
+    printf("23. Listar em Ordem de Titulo, Autor ou Ano (sem reordenar)\n");
+    printf("24. Ordenar Arquivo Binario em Disco (acervos maiores que a memoria)\n");
     printf("0. Sair\n");
     printf("Escolha uma opcao: ");
 }
@@ -85,18 +111,21 @@ void gerenciar_adicao_livro(ColecaoLivros* colecao, PilhaHistorico* historico) {
     Livro livro_temp; // Cria uma struct Livro temporária na stack
     printf("--- Adicionar Novo Livro ---\n");
     if (ler_dados_livro_teclado(&livro_temp)) { // Usa a função centralizada para ler dados
-        // Verifica se já existe livro com este ISBN
-        if (buscar_livro_por_isbn_na_colecao(colecao, livro_temp.isbn) != NULL) {
+        // Verifica se já existe livro com o ISBN
+        if (buscar_livro_por_isbn_na_colecao(colecao, livro_temp.isbn, NULL)) {
             printf("ERRO: Ja existe um livro com o ISBN '%s'.\n", livro_temp.isbn);
         } else {
-            // A função adicionar_livro_colecao cria o nó dinamicamente (malloc)
-            // e copia os dados da nossa 'livro_temp'.
+            // A função adicionar_livro_colecao converte 'livro_temp' para o
+            // formato compacto e o guarda no armazenamento da coleção.
             if (adicionar_livro_colecao(colecao, livro_temp)) {
                 printf("Livro '%s' adicionado com sucesso! 👍\n", livro_temp.titulo);
+                if (!chave_isbn_validada(chave_isbn(livro_temp.isbn))) {
+                    printf("AVISO: '%s' nao e um ISBN-10/13 valido (digito verificador); cadastrado como codigo.\n", livro_temp.isbn);
+                }
                 // Adiciona ao histórico a operação bem-sucedida
                 push_historico(historico, livro_temp.isbn);
             } else {
-                printf("ERRO: Nao foi possivel adicionar o livro (falha de memoria?).\n");
+                printf("ERRO: Nao foi possivel adicionar o livro (colisao de ISBN ou falha de memoria).\n");
             }
         }
     } else {
@@ -109,11 +138,11 @@ void gerenciar_remocao_livro(ColecaoLivros* colecao) {
     printf("Digite o ISBN do livro a remover: ");
     ler_string_segura(buffer_isbn, sizeof(buffer_isbn));
 
-    const Livro* livro_para_remover = buscar_livro_por_isbn_na_colecao(colecao, buffer_isbn);
+    Livro livro_para_remover;
 
-    if (livro_para_remover != NULL) {
+    if (buscar_livro_por_isbn_na_colecao(colecao, buffer_isbn, &livro_para_remover)) {
         char confirmacao_buffer[4];
-        printf("Voce tem certeza que deseja remover o livro '%s'? (S/N): ", livro_para_remover->titulo);
+        printf("Voce tem certeza que deseja remover o livro '%s'? (S/N): ", livro_para_remover.titulo);
         ler_string_segura(confirmacao_buffer, sizeof(confirmacao_buffer));
 
         if (confirmacao_buffer[0] == 'S' || confirmacao_buffer[0] == 's') {
@@ -134,27 +163,441 @@ void gerenciar_busca_isbn(const ColecaoLivros* colecao, PilhaHistorico* historic
     char buffer_isbn[TAM_ISBN];
     printf("Digite o ISBN a buscar: ");
     ler_string_segura(buffer_isbn, sizeof(buffer_isbn));
-    const Livro* encontrado = buscar_livro_por_isbn_na_colecao(colecao, buffer_isbn);
-    if (encontrado) {
+    Livro encontrado;
+    if (buscar_livro_por_isbn_na_colecao(colecao, buffer_isbn, &encontrado)) {
         printf("Livro encontrado: 🔍\n");
-        exibir_livro(encontrado);
-        push_historico(historico, encontrado->isbn);
+        exibir_livro(&encontrado);
+        push_historico(historico, encontrado.isbn);
     } else {
         printf("Livro com ISBN '%s' nao encontrado.\n", buffer_isbn);
     }
 }
 
+/**
+ * @brief Exibe, em páginas, todos os livros cujo campo contém o termo buscado.
+ * O cursor continua a varredura de onde a página anterior parou.
+ * @return int O número de livros exibidos.
+ */
+static int exibir_resultados_pesquisa(const ColecaoLivros* colecao, PilhaHistorico* historico, CampoPesquisa campo, const char* termo) {
+    CursorPesquisa cursor;
+    iniciar_cursor_pesquisa(&cursor, campo, termo, 0, -1);
+    Livro encontrado;
+    int total = 0;
+    int handle = proximo_resultado_pesquisa(colecao, &cursor);
+    while (handle != HANDLE_INVALIDO) {
+        for (int i = 0; i < RESULTADOS_POR_PAGINA && handle != HANDLE_INVALIDO; i++) {
+            materializar_livro(&colecao->armazem, obter_registro_armazem(&colecao->armazem, handle), &encontrado);
+            printf("Resultado %d: 🔍\n", ++total);
+            exibir_livro(&encontrado);
+            printf("---\n");
+            if (total == 1) {
+                push_historico(historico, encontrado.isbn); // O primeiro resultado entra no histórico
+            }
+            handle = proximo_resultado_pesquisa(colecao, &cursor);
+        }
+        if (handle != HANDLE_INVALIDO) {
+            char resposta[4];
+            printf("Mostrar mais resultados? (S/N): ");
+            ler_string_segura(resposta, sizeof(resposta));
+            if (resposta[0] != 'S' && resposta[0] != 's') {
+                break;
+            }
+        }
+    }
+    encerrar_cursor_pesquisa(&cursor);
+    return total;
+}
+
+/**
+ * @brief Lê o termo de uma busca, oferecendo autocompletar: um termo terminado em '*'
+ * lista os títulos/autores que começam com ele (autores, os com mais livros primeiro),
+ * e o usuário escolhe uma sugestão pelo número ou digita outro termo.
+ */
+static void ler_termo_com_sugestoes(const ColecaoLivros* colecao, CampoPesquisa campo, const char* rotulo,
+                                    char* buffer, int tamanho) {
+    printf("%s (termine com * para ver sugestoes): ", rotulo);
+    ler_string_segura(buffer, tamanho);
+
+    size_t comprimento = strlen(buffer);
+    while (comprimento > 0 && buffer[comprimento - 1] == '*') {
+        buffer[comprimento - 1] = '\0';
+        const char* sugestoes[MAX_SUGESTOES];
+        int popularidades[MAX_SUGESTOES];
+        OrdemSugestoes ordem = campo == CAMPO_AUTOR ? ORDEM_POPULARIDADE : ORDEM_ALFABETICA;
+        int quantidade = sugerir_completamentos(colecao, campo, buffer, MAX_SUGESTOES, ordem, sugestoes, popularidades);
+        if (quantidade == 0) {
+            printf("Nenhuma sugestao para '%s'.\n", buffer);
+            return; // Busca o termo como digitado
+        }
+
+        for (int i = 0; i < quantidade; i++) {
+            printf("  %d. %s (%d livro%s)\n", i + 1, sugestoes[i], popularidades[i], popularidades[i] == 1 ? "" : "s");
+        }
+        char resposta[TAM_TITULO];
+        printf("Escolha uma sugestao (1-%d) ou digite outro termo: ", quantidade);
+        ler_string_segura(resposta, sizeof(resposta));
+
+        char* fim;
+        long escolha = strtol(resposta, &fim, 10);
+        if (fim != resposta && *fim == '\0' && escolha >= 1 && escolha <= quantidade) {
+            strncpy(buffer, sugestoes[escolha - 1], tamanho - 1);
+            buffer[tamanho - 1] = '\0';
+            return;
+        }
+        strncpy(buffer, resposta, tamanho - 1);
+        buffer[tamanho - 1] = '\0';
+        comprimento = strlen(buffer);
+    }
+}
+
 void gerenciar_busca_titulo(const ColecaoLivros* colecao, PilhaHistorico* historico) {
     char buffer_titulo[TAM_TITULO];
-    printf("Digite parte do Titulo a buscar: ");
-    ler_string_segura(buffer_titulo, sizeof(buffer_titulo));
-    const Livro* encontrado = pesquisar_livro_por_titulo(colecao, buffer_titulo);
-    if (encontrado) {
-        printf("Primeiro livro encontrado: 🔍\n");
-        exibir_livro(encontrado);
-        push_historico(historico, encontrado->isbn);
-    } else {
+    ler_termo_com_sugestoes(colecao, CAMPO_TITULO, "Digite parte do Titulo a buscar", buffer_titulo, sizeof(buffer_titulo));
+    if (exibir_resultados_pesquisa(colecao, historico, CAMPO_TITULO, buffer_titulo) == 0) {
         printf("Nenhum livro encontrado com o titulo contendo '%s'.\n", buffer_titulo);
+
+        // Sem resultados exatos: sugere títulos parecidos (erros de digitação)
+        ResultadoDifuso parecidos[RESULTADOS_POR_PAGINA];
+        int quantidade = pesquisar_titulos_aproximados(colecao, buffer_titulo, DISTANCIA_DIFUSA_MAXIMA,
+                                                       parecidos, RESULTADOS_POR_PAGINA);
+        if (quantidade > 0) {
+            printf("Voce quis dizer:\n");
+            for (int i = 0; i < quantidade; i++) {
+                const RegistroLivro* registro = obter_registro_armazem(&colecao->armazem, parecidos[i].handle);
+                printf("  %d. %s - %s (ISBN: %s)\n", i + 1, titulo_registro(&colecao->armazem, registro),
+                       autor_registro(&colecao->armazem, registro), registro->isbn);
+            }
+        }
+    }
+}
+
+void gerenciar_busca_autor(const ColecaoLivros* colecao, PilhaHistorico* historico) {
+    char buffer_autor[TAM_AUTOR];
+    ler_termo_com_sugestoes(colecao, CAMPO_AUTOR, "Digite parte do Autor a buscar", buffer_autor, sizeof(buffer_autor));
+    if (exibir_resultados_pesquisa(colecao, historico, CAMPO_AUTOR, buffer_autor) == 0) {
+        printf("Nenhum livro encontrado com o autor contendo '%s'.\n", buffer_autor);
+    }
+}
+
+/**
+ * @brief Lê um ano opcional; uma linha vazia (ou inválida) mantém `padrao`.
+ */
+static int ler_ano_opcional(const char* rotulo, int padrao) {
+    char buffer[16];
+    printf("%s (Enter para qualquer): ", rotulo);
+    ler_string_segura(buffer, sizeof(buffer));
+    if (buffer[0] == '\0') {
+        return padrao;
+    }
+    char* fim;
+    errno = 0;
+    long ano = strtol(buffer, &fim, 10);
+    if (fim == buffer || *fim != '\0' || errno == ERANGE || ano < ANO_CONSULTA_MINIMO || ano > ANO_CONSULTA_MAXIMO) {
+        printf("Ano invalido; o criterio sera ignorado.\n");
+        return padrao;
+    }
+    return (int)ano;
+}
+
+void gerenciar_consulta_combinada(const ColecaoLivros* colecao, PilhaHistorico* historico) {
+    char titulo[TAM_TITULO], autor[TAM_AUTOR], genero[TAM_GENERO], isbn[TAM_ISBN];
+    Consulta consulta;
+    inicializar_consulta(&consulta);
+
+    printf("--- Consulta Combinada (deixe em branco para ignorar um criterio) ---\n");
+    printf("Titulo contem: ");
+    ler_string_segura(titulo, sizeof(titulo));
+    printf("Autor contem: ");
+    ler_string_segura(autor, sizeof(autor));
+    printf("Genero (exato): ");
+    ler_string_segura(genero, sizeof(genero));
+    printf("ISBN: ");
+    ler_string_segura(isbn, sizeof(isbn));
+    consulta.ano_minimo = ler_ano_opcional("Ano minimo", ANO_CONSULTA_MINIMO);
+    consulta.ano_maximo = ler_ano_opcional("Ano maximo", ANO_CONSULTA_MAXIMO);
+    consulta.titulo = titulo;
+    consulta.autor = autor;
+    consulta.genero = genero;
+    consulta.isbn = isbn;
+
+    CursorConsulta cursor;
+    iniciar_cursor_consulta(&cursor, colecao, &consulta);
+    printf("Plano: %s (~%d livros examinados, ~%.0f resultados esperados)\n",
+           descrever_acesso_consulta(cursor.plano.acesso), cursor.plano.candidatos_estimados,
+           cursor.plano.resultados_estimados);
+
+    Livro encontrado;
+    int total = 0;
+    int handle = proximo_resultado_consulta(colecao, &cursor);
+    while (handle != HANDLE_INVALIDO) {
+        for (int i = 0; i < RESULTADOS_POR_PAGINA && handle != HANDLE_INVALIDO; i++) {
+            materializar_livro(&colecao->armazem, obter_registro_armazem(&colecao->armazem, handle), &encontrado);
+            printf("Resultado %d: 🔍\n", ++total);
+            exibir_livro(&encontrado);
+            printf("---\n");
+            if (total == 1) {
+                push_historico(historico, encontrado.isbn); // O primeiro resultado entra no histórico
+            }
+            handle = proximo_resultado_consulta(colecao, &cursor);
+        }
+        if (handle != HANDLE_INVALIDO) {
+            char resposta[4];
+            printf("Mostrar mais resultados? (S/N): ");
+            ler_string_segura(resposta, sizeof(resposta));
+            if (resposta[0] != 'S' && resposta[0] != 's') {
+                break;
+            }
+        }
+    }
+    encerrar_cursor_consulta(&cursor);
+    if (total == 0) {
+        printf("Nenhum livro satisfaz todos os criterios.\n");
+    }
+}
+
+/**
+ * @brief VisitanteLivro das listagens por ano e por gênero: exibe o livro e, a cada página, pergunta
+ * se deve continuar. O contexto é o contador de livros exibidos.
+ */
+static int exibir_livro_paginado(const ArmazemLivros* armazem, const RegistroLivro* registro, int handle, void* contexto) {
+    (void)handle;
+    int* exibidos = (int*)contexto;
+    if (*exibidos > 0 && *exibidos % RESULTADOS_POR_PAGINA == 0) {
+        char resposta[4];
+        printf("Mostrar mais resultados? (S/N): ");
+        ler_string_segura(resposta, sizeof(resposta));
+        if (resposta[0] != 'S' && resposta[0] != 's') {
+            return 0;
+        }
+    }
+    Livro livro;
+    materializar_livro(armazem, registro, &livro);
+    printf("Resultado %d:\n", ++*exibidos);
+    exibir_livro(&livro);
+    printf("---\n");
+    return 1;
+}
+
+void gerenciar_listagem_por_ano(const ColecaoLivros* colecao) {
+    int ano_minimo = ler_ano_opcional("Ano inicial", ANO_CONSULTA_MINIMO);
+    int ano_maximo = ler_ano_opcional("Ano final", ANO_CONSULTA_MAXIMO);
+    int total = contar_livros_por_ano(colecao, ano_minimo, ano_maximo);
+    printf("%d livro(s) no intervalo (em ordem de ano). 📅\n", total);
+    int exibidos = 0;
+    pesquisar_livros_por_ano(colecao, ano_minimo, ano_maximo, 0, -1, exibir_livro_paginado, &exibidos);
+}
+
+void gerenciar_listagem_por_genero(const ColecaoLivros* colecao) {
+    ContagemGenero contagens[MAX_GENEROS_LISTADOS];
+    int quantidade = histograma_generos(colecao, contagens, MAX_GENEROS_LISTADOS);
+    if (quantidade == 0) {
+        printf("A colecao de livros esta vazia.\n");
+        return;
+    }
+    printf("--- Livros por Genero 🏷️ ---\n");
+    for (int i = 0; i < quantidade; i++) {
+        printf("%5d  %s\n", contagens[i].quantidade, contagens[i].genero);
+    }
+
+    // Vários gêneros separados por vírgula são listados juntos (qualquer um deles).
+    char entrada[TAM_GENERO * 4];
+    printf("Genero(s) a listar, separados por virgula (vazio para voltar): ");
+    ler_string_segura(entrada, sizeof(entrada));
+    const char* generos[MAX_GENEROS_LISTADOS];
+    int quantidade_generos = 0;
+    for (char* genero = strtok(entrada, ","); genero != NULL && quantidade_generos < MAX_GENEROS_LISTADOS;
+         genero = strtok(NULL, ",")) {
+        while (*genero == ' ') {
+            genero++;
+        }
+        char* fim = genero + strlen(genero);
+        while (fim > genero && fim[-1] == ' ') {
+            *--fim = '\0';
+        }
+        if (*genero != '\0') {
+            generos[quantidade_generos++] = genero;
+        }
+    }
+    if (quantidade_generos == 0) {
+        return;
+    }
+    int exibidos = 0;
+    if (pesquisar_livros_por_generos(colecao, generos, quantidade_generos, 0, -1, exibir_livro_paginado, &exibidos) == 0) {
+        printf("Nenhum livro encontrado nesse(s) genero(s).\n");
+    }
+}
+
+void gerenciar_primeiros_livros(const ColecaoLivros* colecao) {
+    char entrada[16];
+    printf("Criterio: 1-Titulo  2-Autor  3-Mais antigos  4-Mais recentes: ");
+    ler_string_segura(entrada, sizeof(entrada));
+    int opcao = atoi(entrada);
+    if (opcao < 1 || opcao > 4) {
+        printf("Criterio invalido.\n");
+        return;
+    }
+    const CriterioOrdenacao criterios[4] = { CRITERIO_TITULO, CRITERIO_AUTOR, CRITERIO_ANO_CRESCENTE, CRITERIO_ANO_DECRESCENTE };
+
+    printf("Quantos livros (1 a %d): ", MAX_PRIMEIROS_LIVROS);
+    ler_string_segura(entrada, sizeof(entrada));
+    int k = atoi(entrada);
+    if (k < 1 || k > MAX_PRIMEIROS_LIVROS) {
+        printf("Quantidade invalida.\n");
+        return;
+    }
+
+    // Apenas os k livros pedidos são selecionados; a ordem da coleção não muda.
+    int handles[MAX_PRIMEIROS_LIVROS];
+    int encontrados = selecionar_primeiros_livros(colecao, criterios[opcao - 1], k, handles);
+    if (encontrados == 0) {
+        printf("A colecao de livros esta vazia.\n");
+        return;
+    }
+    Livro livro;
+    for (int i = 0; i < encontrados; i++) {
+        materializar_livro(&colecao->armazem, obter_registro_armazem(&colecao->armazem, handles[i]), &livro);
+        printf("Livro %d:\n", i + 1);
+        exibir_livro(&livro);
+        printf("---\n");
+    }
+}
+
+/**
+ * @brief Lê do teclado os critérios de uma ordenação por vários critérios.
+ * Critérios separados por vírgula, do mais importante ao menos importante;
+ * um '-' no final do nome inverte o sentido (ex: "autor, ano-, titulo").
+ * @return int O número de critérios lidos, ou 0 se a entrada for vazia ou inválida.
+ */
+static int ler_criterios_ordenacao(ChaveOrdenacao chaves[QUANTIDADE_CAMPOS_ORDENACAO]) {
+    const char* nomes[QUANTIDADE_CAMPOS_ORDENACAO] = { "titulo", "autor", "ano", "genero", "isbn" };
+    char entrada[128];
+    printf("Criterios (titulo, autor, ano, genero, isbn), separados por virgula;\n");
+    printf("'-' no final = decrescente (ex: autor, ano-, titulo): ");
+    ler_string_segura(entrada, sizeof(entrada));
+
+    int quantidade_chaves = 0;
+    for (char* criterio = strtok(entrada, ","); criterio != NULL; criterio = strtok(NULL, ",")) {
+        while (*criterio == ' ') {
+            criterio++;
+        }
+        char* fim = criterio + strlen(criterio);
+        while (fim > criterio && fim[-1] == ' ') {
+            *--fim = '\0';
+        }
+        int decrescente = 0;
+        if (fim > criterio && fim[-1] == '-') {
+            decrescente = 1;
+            *--fim = '\0';
+        }
+        int campo = 0;
+        while (campo < QUANTIDADE_CAMPOS_ORDENACAO && strcmp(criterio, nomes[campo]) != 0) {
+            campo++;
+        }
+        if (campo == QUANTIDADE_CAMPOS_ORDENACAO || quantidade_chaves == QUANTIDADE_CAMPOS_ORDENACAO) {
+            printf("Criterio invalido: '%s'.\n", criterio);
+            return 0;
+        }
+        chaves[quantidade_chaves].campo = (CampoOrdenacao) campo;
+        chaves[quantidade_chaves].decrescente = decrescente;
+        quantidade_chaves++;
+    }
+    return quantidade_chaves;
+}
+
+void gerenciar_ordenacao_por_criterios(ColecaoLivros* colecao) {
+    if (tamanho_colecao(colecao) == 0) {
+        printf("Colecao vazia, nada para ordenar.\n");
+        return;
+    }
+    ChaveOrdenacao chaves[QUANTIDADE_CAMPOS_ORDENACAO];
+    int quantidade_chaves = ler_criterios_ordenacao(chaves);
+    if (quantidade_chaves == 0) {
+        return;
+    }
+    if (!ordenar_colecao_por_chaves(colecao, chaves, quantidade_chaves)) {
+        printf("Nao foi possivel ordenar (criterio repetido ou falta de memoria).\n");
+        return;
+    }
+    printf("Colecao ordenada.\n");
+    listar_todos_livros(colecao);
+}
+
+void gerenciar_ordenacao_externa() {
+    // O arquivo é lido e ordenado em disco, aos blocos: a coleção em memória não é usada.
+    printf("Ordena o arquivo '%s' como esta em disco (use a opcao 14 antes para incluir\n", ARQUIVO_BINARIO);
+    printf("as alteracoes desta sessao), sem carrega-lo inteiro na memoria.\n");
+    ChaveOrdenacao chaves[QUANTIDADE_CAMPOS_ORDENACAO];
+    int quantidade_chaves = ler_criterios_ordenacao(chaves);
+    if (quantidade_chaves == 0) {
+        return;
+    }
+
+    char arquivo_saida[256];
+    printf("Arquivo de saida [%s]: ", ARQUIVO_BINARIO_ORDENADO);
+    ler_string_segura(arquivo_saida, sizeof(arquivo_saida));
+    if (arquivo_saida[0] == '\0') {
+        strcpy(arquivo_saida, ARQUIVO_BINARIO_ORDENADO);
+    }
+    char buffer_memoria[16];
+    printf("Memoria maxima em MB [%d]: ", (int)(ORCAMENTO_ORDENACAO_EXTERNA_PADRAO / (1024 * 1024)));
+    ler_string_segura(buffer_memoria, sizeof(buffer_memoria));
+    long megabytes = strtol(buffer_memoria, NULL, 10);
+    size_t orcamento = megabytes > 0 ? (size_t)megabytes * 1024 * 1024 : 0; // 0 = padrão
+
+    EstatisticasOrdenacaoExterna estatisticas;
+    if (!ordenar_arquivo_binario_externo(ARQUIVO_BINARIO, arquivo_saida, chaves, quantidade_chaves,
+                                         orcamento, &estatisticas)) {
+        printf("Nao foi possivel ordenar o arquivo '%s'.\n", ARQUIVO_BINARIO);
+        return;
+    }
+    printf("%ld livros ordenados em '%s' (%d sequencias ordenadas, %d passagens de intercalacao).\n",
+           estatisticas.livros, arquivo_saida, estatisticas.sequencias, estatisticas.passagens);
+}
+
+void gerenciar_listagem_ordenada(const ColecaoLivros* colecao) {
+    if (colecao->visoes == NULL) {
+        printf("Listagens ordenadas indisponiveis (visoes desativadas).\n");
+        return;
+    }
+    if (tamanho_colecao(colecao) == 0) {
+        printf("A colecao de livros esta vazia.\n");
+        return;
+    }
+    char entrada[16];
+    printf("Ordem: 1-Titulo  2-Autor  3-Ano (mais antigos)  4-Ano (mais recentes): ");
+    ler_string_segura(entrada, sizeof(entrada));
+    int opcao = atoi(entrada);
+    if (opcao < 1 || opcao > 4) {
+        printf("Ordem invalida.\n");
+        return;
+    }
+    const TipoVisao visoes[4] = { VISAO_TITULO, VISAO_AUTOR, VISAO_ANO, VISAO_ANO };
+
+    // A visão já está ordenada: a listagem só percorre os handles, sem ordenar nada.
+    int exibidos = 0;
+    percorrer_visao_ordenada(colecao, visoes[opcao - 1], opcao == 4, 0, -1, exibir_livro_paginado, &exibidos);
+}
+
+void gerenciar_busca_relevancia(const ColecaoLivros* colecao, PilhaHistorico* historico) {
+    char buffer_busca[TAM_BUSCA_RELEVANCIA];
+    printf("Digite as palavras a buscar (titulo, autor ou genero): ");
+    ler_string_segura(buffer_busca, sizeof(buffer_busca));
+
+    ResultadoRelevancia resultados[MAX_RESULTADOS_RELEVANCIA];
+    int quantidade = pesquisar_por_relevancia(colecao, buffer_busca, resultados, MAX_RESULTADOS_RELEVANCIA);
+    if (quantidade == 0) {
+        printf("Nenhum livro encontrado para '%s'.\n", buffer_busca);
+        return;
+    }
+    Livro encontrado;
+    for (int i = 0; i < quantidade; i++) {
+        materializar_livro(&colecao->armazem, obter_registro_armazem(&colecao->armazem, resultados[i].handle), &encontrado);
+        printf("Resultado %d (relevancia %.2f): 🔍\n", i + 1, resultados[i].pontuacao);
+        exibir_livro(&encontrado);
+        printf("---\n");
+        if (i == 0) {
+            push_historico(historico, encontrado.isbn); // O primeiro resultado entra no histórico
+        }
     }
 }
 
@@ -203,6 +646,32 @@ int main() {
         return 1;
     }
 
+    // Índices de trigramas para as buscas por título e autor (sem eles, as buscas
+    // examinam todos os livros)
+    if (!ativar_indices_trigramas(minha_colecao)) {
+        fprintf(stderr, "AVISO: Indices de busca desativados por falta de memoria.\n");
+    }
+    // Índice difuso para sugerir títulos quando a busca não encontra nada
+    if (!ativar_indice_difuso(minha_colecao)) {
+        fprintf(stderr, "AVISO: Busca aproximada desativada por falta de memoria.\n");
+    }
+    // Índices de prefixos para o autocompletar dos termos de busca
+    if (!ativar_indices_prefixos(minha_colecao)) {
+        fprintf(stderr, "AVISO: Sugestoes de busca desativadas por falta de memoria.\n");
+    }
+    // Índice invertido para a busca por relevância
+    if (!ativar_indice_relevancia(minha_colecao)) {
+        fprintf(stderr, "AVISO: Busca por relevancia desativada por falta de memoria.\n");
+    }
+    // Cache dos resultados de pesquisas repetidas (descartado a cada alteração)
+    if (!ativar_cache_consultas(minha_colecao, CAPACIDADE_CACHE_PADRAO)) {
+        fprintf(stderr, "AVISO: Cache de pesquisas desativado por falta de memoria.\n");
+    }
+    // Visões por título, autor e ano (listagens ordenadas sem reordenar a coleção)
+    if (!ativar_visoes_ordenadas(minha_colecao)) {
+        fprintf(stderr, "AVISO: Listagens ordenadas desativadas por falta de memoria.\n");
+    }
+
     limpar_tela();
     // Tenta carregar dados do arquivo binário ao iniciar
     if (carregar_colecao_binario(minha_colecao, ARQUIVO_BINARIO)) {
@@ -271,6 +740,15 @@ int main() {
                 if (carregar_colecao_binario(minha_colecao, ARQUIVO_BINARIO)) printf("Colecao carregada/incrementada de %s ✅\n", ARQUIVO_BINARIO);
                 else printf("ERRO ou arquivo %s nao encontrado. 💾\n", ARQUIVO_BINARIO);
                 break;
+            case 16: gerenciar_busca_autor(minha_colecao, meu_historico); break;
+            case 17: gerenciar_consulta_combinada(minha_colecao, meu_historico); break;
+            case 18: gerenciar_listagem_por_ano(minha_colecao); break;
+            case 19: gerenciar_listagem_por_genero(minha_colecao); break;
+            case 20: gerenciar_primeiros_livros(minha_colecao); break;
+            case 21: gerenciar_busca_relevancia(minha_colecao, meu_historico); break;
+            case 22: gerenciar_ordenacao_por_criterios(minha_colecao); break;
+            case 23: gerenciar_listagem_ordenada(minha_colecao); break;
+            case 24: gerenciar_ordenacao_externa(); break;
             case 0:
                 printf("Salvando dados antes de sair...\n");
                 // Tenta salvar em binário por padrão
@@ -0,0 +1,68 @@
+#include "normalizacao.h"
+
+/**
+ * @brief Dobra dos caracteres U+00C0..U+00FF (segundo byte 0x80..0xBF após 0xC3).
+ * NULL indica um caractere sem letra-base (×, ÷, Þ, þ), que é copiado sem alteração.
+ */
+static const char* const DOBRA_LATIN1[64] = {
+    "a", "a", "a", "a", "a", "a", "ae", "c",   // À Á Â Ã Ä Å Æ Ç
+    "e", "e", "e", "e", "i", "i", "i", "i",    // È É Ê Ë Ì Í Î Ï
+    "d", "n", "o", "o", "o", "o", "o", NULL,   // Ð Ñ Ò Ó Ô Õ Ö ×
+    "o", "u", "u", "u", "u", "y", NULL, "ss",  // Ø Ù Ú Û Ü Ý Þ ß
+    "a", "a", "a", "a", "a", "a", "ae", "c",   // à á â ã ä å æ ç
+    "e", "e", "e", "e", "i", "i", "i", "i",    // è é ê ë ì í î ï
+    "d", "n", "o", "o", "o", "o", "o", NULL,   // ð ñ ò ó ô õ ö ÷
+    "o", "u", "u", "u", "u", "y", NULL, "y"    // ø ù ú û ü ý þ ÿ
+};
+
+size_t dobrar_texto(const char* origem, char* destino, size_t tamanho_destino) {
+    if (tamanho_destino == 0) {
+        return 0;
+    }
+
+    const unsigned char* p = (const unsigned char*)origem;
+    size_t escrito = 0;
+    size_t limite = tamanho_destino - 1; // Reserva espaço para o terminador
+    while (*p != '\0' && escrito < limite) {
+        if (*p < 0x80) {
+            unsigned char c = *p++;
+            destino[escrito++] = (char)(c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c);
+        } else if (*p == 0xC3 && p[1] >= 0x80 && p[1] <= 0xBF && DOBRA_LATIN1[p[1] - 0x80] != NULL) {
+            const char* base = DOBRA_LATIN1[p[1] - 0x80];
+            p += 2;
+            while (*base != '\0' && escrito < limite) {
+                destino[escrito++] = *base++;
+            }
+        } else {
+            destino[escrito++] = (char)*p++; // Outros bytes UTF-8 são copiados como estão
+        }
+    }
+    destino[escrito] = '\0';
+    return escrito;
+}
+
+/**
+ * @brief Indica se o byte faz parte de uma palavra (letra, dígito ou byte não ASCII).
+ */
+static int byte_de_palavra(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c >= 0x80;
+}
+
+size_t proximo_termo(const char** cursor, char* termo, size_t tamanho_termo) {
+    const unsigned char* p = (const unsigned char*)*cursor;
+    while (*p != '\0' && !byte_de_palavra(*p)) {
+        p++;
+    }
+
+    size_t escrito = 0;
+    for (; byte_de_palavra(*p); p++) {
+        if (escrito + 1 < tamanho_termo) {
+            termo[escrito++] = (char)*p;
+        }
+    }
+    if (tamanho_termo > 0) {
+        termo[escrito] = '\0';
+    }
+    *cursor = (const char*)p;
+    return escrito;
+}
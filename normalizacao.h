@@ -0,0 +1,40 @@
+#ifndef NORMALIZACAO_H
+#define NORMALIZACAO_H
+
+#include <stddef.h> // Para size_t
+
+/**
+ * @file normalizacao.h
+ * @brief Define a "dobra" de textos usada nas buscas: conversão para minúsculas e
+ * remoção de acentos, para que "senhor dos aneis" encontre "O Senhor dos Anéis".
+ *
+ * A dobra trata letras ASCII e as letras acentuadas do bloco Latin-1 codificadas em
+ * UTF-8 (À..ÿ, bytes 0xC3 0x80..0xBF). Outras sequências UTF-8 são copiadas sem
+ * alteração. O texto dobrado nunca é mais longo que o original.
+ */
+
+// --- Protótipos das Funções ---
+
+/**
+ * @brief Grava em `destino` a versão dobrada (minúsculas, sem acentos) de `origem`.
+ * @param origem String UTF-8 terminada em nulo. Não deve ser NULL.
+ * @param destino Buffer de saída. Um buffer com strlen(origem) + 1 bytes sempre basta.
+ * @param tamanho_destino Tamanho do buffer de saída (incluindo o terminador nulo).
+ * @return size_t O comprimento do texto dobrado (sem o terminador). Se o buffer for
+ * pequeno demais, o texto é truncado, mas sempre terminado em nulo.
+ */
+size_t dobrar_texto(const char* origem, char* destino, size_t tamanho_destino);
+
+/**
+ * @brief Extrai a próxima palavra (termo) de um texto já dobrado.
+ * Palavras são sequências de letras, dígitos ou bytes não ASCII (o restante de
+ * caracteres UTF-8 que a dobra não trata); qualquer outro byte é separador.
+ *
+ * @param cursor Ponteiro para a posição atual no texto; é avançado para depois da palavra.
+ * @param termo Buffer que recebe a palavra, terminada em nulo.
+ * @param tamanho_termo Tamanho do buffer; palavras maiores são truncadas (o restante é descartado).
+ * @return size_t O comprimento da palavra gravada, ou 0 se não houver mais palavras.
+ */
+size_t proximo_termo(const char** cursor, char* termo, size_t tamanho_termo);
+
+#endif // NORMALIZACAO_H
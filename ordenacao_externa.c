@@ -0,0 +1,403 @@
+#include <stdio.h>
+#include <stdlib.h> // Para malloc, realloc, free e qsort
+#include <string.h> // Para strncmp e strcmp
+#include "ordenacao_externa.h"
+#include "livro.h"      // Para struct Livro (formato do arquivo binário)
+#include "chave_isbn.h" // ISBN comparado pela chave normalizada, como na coleção
+
+// Critérios da ordenação em andamento, usados pela comparação do qsort (que não
+// recebe contexto). Valem apenas durante uma chamada de ordenar_arquivo_binario_externo.
+static const ChaveOrdenacao* criterios_atuais = NULL;
+static int quantidade_criterios_atuais = 0;
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Compara dois livros pelos critérios atuais, na mesma ordem de
+ * `ordenar_colecao_por_chaves` (textos case-sensitive, ISBN pela chave normalizada).
+ * @return int <0, 0 ou >0, como `strcmp`.
+ */
+static int comparar_livros_por_criterios(const Livro* a, const Livro* b) {
+    for (int c = 0; c < quantidade_criterios_atuais; c++) {
+        int comparacao = 0;
+        switch (criterios_atuais[c].campo) {
+            case CAMPO_ORDENACAO_TITULO:
+                comparacao = strncmp(a->titulo, b->titulo, TAM_TITULO);
+                break;
+            case CAMPO_ORDENACAO_AUTOR:
+                comparacao = strncmp(a->autor, b->autor, TAM_AUTOR);
+                break;
+            case CAMPO_ORDENACAO_ANO:
+                comparacao = (a->anoPublicacao > b->anoPublicacao) - (a->anoPublicacao < b->anoPublicacao);
+                break;
+            case CAMPO_ORDENACAO_GENERO:
+                comparacao = strncmp(a->genero, b->genero, TAM_GENERO);
+                break;
+            case CAMPO_ORDENACAO_ISBN: {
+                // Campos gravados sem terminador (arquivo corrompido) não são lidos além do fim
+                char isbn_a[TAM_ISBN];
+                char isbn_b[TAM_ISBN];
+                memcpy(isbn_a, a->isbn, TAM_ISBN);
+                memcpy(isbn_b, b->isbn, TAM_ISBN);
+                isbn_a[TAM_ISBN - 1] = '\0';
+                isbn_b[TAM_ISBN - 1] = '\0';
+                ChaveIsbn chave_a = chave_isbn(isbn_a);
+                ChaveIsbn chave_b = chave_isbn(isbn_b);
+                comparacao = (chave_a > chave_b) - (chave_a < chave_b);
+                break;
+            }
+            default:
+                break;
+        }
+        if (comparacao != 0) {
+            comparacao = comparacao > 0 ? 1 : -1;
+            return criterios_atuais[c].decrescente ? -comparacao : comparacao;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Função de comparação para qsort de ponteiros para livros de um mesmo bloco:
+ * critérios e, em empate, o endereço (a ordem do bloco, ou seja, a do arquivo).
+ */
+static int comparar_ponteiros_livros(const void* a, const void* b) {
+    const Livro* livro_a = *(const Livro* const*) a;
+    const Livro* livro_b = *(const Livro* const*) b;
+    int comparacao = comparar_livros_por_criterios(livro_a, livro_b);
+    if (comparacao != 0) {
+        return comparacao;
+    }
+    return (livro_a > livro_b) - (livro_a < livro_b);
+}
+
+/**
+ * @brief Ordena um bloco de livros lido do arquivo e grava-o, já ordenado, em `destino`.
+ * @return int 1 em caso de sucesso, 0 se a escrita falhar.
+ */
+static int gravar_bloco_ordenado(const Livro* bloco, const Livro** ponteiros, size_t quantidade, FILE* destino) {
+    for (size_t i = 0; i < quantidade; i++) {
+        ponteiros[i] = &bloco[i];
+    }
+    qsort(ponteiros, quantidade, sizeof(const Livro*), comparar_ponteiros_livros);
+    for (size_t i = 0; i < quantidade; i++) {
+        if (fwrite(ponteiros[i], sizeof(Livro), 1, destino) != 1) {
+            perror("ERRO (ordenacao externa): Falha ao gravar sequencia ordenada");
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Fecha (e assim apaga) os arquivos temporários das sequências e libera o vetor.
+ */
+static void descartar_sequencias(FILE** sequencias, int quantidade) {
+    for (int i = 0; i < quantidade; i++) {
+        if (sequencias[i] != NULL) {
+            fclose(sequencias[i]);
+        }
+    }
+    free(sequencias);
+}
+
+/**
+ * @brief Acrescenta uma sequência ao vetor de sequências, dobrando-o se preciso.
+ * @return int 1 em caso de sucesso, 0 se a realocação falhar.
+ */
+static int acrescentar_sequencia(FILE*** sequencias, int* quantidade, int* capacidade, FILE* sequencia) {
+    if (*quantidade == *capacidade) {
+        int nova = *capacidade > 0 ? *capacidade * 2 : 16;
+        FILE** maior = (FILE**) realloc(*sequencias, (size_t)nova * sizeof(FILE*));
+        if (maior == NULL) {
+            perror("ERRO (ordenacao externa): Falha ao alocar lista de sequencias");
+            return 0;
+        }
+        *sequencias = maior;
+        *capacidade = nova;
+    }
+    (*sequencias)[(*quantidade)++] = sequencia;
+    return 1;
+}
+
+/**
+ * @brief Estado de uma via da intercalação: a sequência e o trecho dela já lido.
+ */
+typedef struct {
+    FILE* arquivo;               ///< Sequência ordenada (posicionada depois do trecho lido).
+    Livro* buffer;               ///< Trecho lido da sequência.
+    size_t lidos;                ///< Livros no buffer.
+    size_t proximo;              ///< Próximo livro do buffer a sair.
+} ViaIntercalacao;
+
+/**
+ * @brief Diz se a via `a` deve sair antes da via `b`: o livro atual de `a` vem antes,
+ * ou é igual e `a` é uma sequência mais antiga (estabilidade).
+ */
+static int via_vem_antes(const ViaIntercalacao* vias, int a, int b) {
+    int comparacao = comparar_livros_por_criterios(&vias[a].buffer[vias[a].proximo],
+                                                   &vias[b].buffer[vias[b].proximo]);
+    return comparacao < 0 || (comparacao == 0 && a < b);
+}
+
+/**
+ * @brief Desce a via da posição `i` do heap de mínimo até restaurar a propriedade do heap.
+ */
+static void descer_no_heap(int* heap, int tamanho, const ViaIntercalacao* vias, int i) {
+    for (;;) {
+        int menor = i;
+        int esquerda = 2 * i + 1;
+        int direita = esquerda + 1;
+        if (esquerda < tamanho && via_vem_antes(vias, heap[esquerda], heap[menor])) {
+            menor = esquerda;
+        }
+        if (direita < tamanho && via_vem_antes(vias, heap[direita], heap[menor])) {
+            menor = direita;
+        }
+        if (menor == i) {
+            return;
+        }
+        int temporario = heap[i];
+        heap[i] = heap[menor];
+        heap[menor] = temporario;
+        i = menor;
+    }
+}
+
+/**
+ * @brief Intercala `quantidade` sequências ordenadas (no máximo MAX_VIAS_INTERCALACAO,
+ * posicionadas no início) em `destino`, usando `memoria` (com espaço para
+ * `capacidade` livros) como buffers: um por via e um para a saída.
+ * @return int 1 em caso de sucesso, 0 se a leitura ou a escrita falhar.
+ */
+static int intercalar_sequencias(FILE** sequencias, int quantidade, FILE* destino,
+                                 Livro* memoria, size_t capacidade) {
+    ViaIntercalacao vias[MAX_VIAS_INTERCALACAO];
+    int heap[MAX_VIAS_INTERCALACAO];
+    int tamanho_heap = 0;
+    size_t por_buffer = capacidade / (size_t)(quantidade + 1);
+    Livro* saida = memoria + (size_t)quantidade * por_buffer;
+    size_t na_saida = 0;
+
+    for (int v = 0; v < quantidade; v++) {
+        vias[v].arquivo = sequencias[v];
+        vias[v].buffer = memoria + (size_t)v * por_buffer;
+        vias[v].lidos = fread(vias[v].buffer, sizeof(Livro), por_buffer, sequencias[v]);
+        vias[v].proximo = 0;
+        if (vias[v].lidos > 0) {
+            heap[tamanho_heap++] = v;
+        }
+    }
+    for (int i = tamanho_heap / 2 - 1; i >= 0; i--) {
+        descer_no_heap(heap, tamanho_heap, vias, i);
+    }
+
+    while (tamanho_heap > 0) {
+        ViaIntercalacao* via = &vias[heap[0]];
+        saida[na_saida++] = via->buffer[via->proximo++];
+        if (na_saida == por_buffer) {
+            if (fwrite(saida, sizeof(Livro), na_saida, destino) != na_saida) {
+                perror("ERRO (ordenacao externa): Falha ao gravar intercalacao");
+                return 0;
+            }
+            na_saida = 0;
+        }
+        if (via->proximo == via->lidos) {
+            // Trecho da via esgotado: lê o próximo, ou tira a via do heap no fim da sequência
+            via->lidos = fread(via->buffer, sizeof(Livro), por_buffer, via->arquivo);
+            via->proximo = 0;
+            if (via->lidos == 0) {
+                if (ferror(via->arquivo)) {
+                    perror("ERRO (ordenacao externa): Falha ao ler sequencia ordenada");
+                    return 0;
+                }
+                heap[0] = heap[--tamanho_heap];
+            }
+        }
+        descer_no_heap(heap, tamanho_heap, vias, 0);
+    }
+    if (na_saida > 0 && fwrite(saida, sizeof(Livro), na_saida, destino) != na_saida) {
+        perror("ERRO (ordenacao externa): Falha ao gravar intercalacao");
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Primeira fase: lê a entrada em blocos de até `capacidade` livros, ordena cada
+ * bloco e grava-o em um arquivo temporário.
+ * @return int 1 em caso de sucesso, 0 em caso de falha (as sequências já criadas
+ * continuam no vetor, para serem descartadas pelo chamador).
+ */
+static int gerar_sequencias(FILE* entrada, size_t capacidade, FILE*** sequencias, int* quantidade,
+                            long* livros) {
+    Livro* bloco = (Livro*) malloc(capacidade * sizeof(Livro));
+    const Livro** ponteiros = (const Livro**) malloc(capacidade * sizeof(const Livro*));
+    if (bloco == NULL || ponteiros == NULL) {
+        perror("ERRO (ordenacao externa): Falha ao alocar bloco de ordenacao");
+        free(bloco);
+        free(ponteiros);
+        return 0;
+    }
+
+    int capacidade_sequencias = 0;
+    int sucesso = 1;
+    size_t lidos;
+    while (sucesso && (lidos = fread(bloco, sizeof(Livro), capacidade, entrada)) > 0) {
+        *livros += (long) lidos;
+        FILE* sequencia = tmpfile();
+        if (sequencia == NULL) {
+            perror("ERRO (ordenacao externa): Falha ao criar arquivo temporario");
+            sucesso = 0;
+        } else if (!acrescentar_sequencia(sequencias, quantidade, &capacidade_sequencias, sequencia)) {
+            fclose(sequencia);
+            sucesso = 0;
+        } else {
+            sucesso = gravar_bloco_ordenado(bloco, ponteiros, lidos, sequencia);
+        }
+    }
+    if (sucesso && ferror(entrada)) {
+        perror("ERRO (ordenacao externa): Falha ao ler arquivo de entrada");
+        sucesso = 0;
+    }
+
+    free(bloco);
+    free(ponteiros);
+    return sucesso;
+}
+
+// --- ORDENAÇÃO EXTERNA ---
+
+int ordenar_arquivo_binario_externo(const char* arquivo_entrada, const char* arquivo_saida,
+                                    const ChaveOrdenacao* chaves, int quantidade_chaves,
+                                    size_t orcamento_memoria, EstatisticasOrdenacaoExterna* estatisticas) {
+    if (arquivo_entrada == NULL || arquivo_saida == NULL || chaves == NULL ||
+        quantidade_chaves < 1 || quantidade_chaves > QUANTIDADE_CAMPOS_ORDENACAO) {
+        fprintf(stderr, "ERRO (ordenar_arquivo_binario_externo): Parametros invalidos.\n");
+        return 0;
+    }
+    int campo_usado[QUANTIDADE_CAMPOS_ORDENACAO] = { 0 };
+    for (int c = 0; c < quantidade_chaves; c++) {
+        if (chaves[c].campo < 0 || chaves[c].campo >= QUANTIDADE_CAMPOS_ORDENACAO || campo_usado[chaves[c].campo]) {
+            fprintf(stderr, "ERRO (ordenar_arquivo_binario_externo): Criterios invalidos.\n");
+            return 0;
+        }
+        campo_usado[chaves[c].campo] = 1;
+    }
+    if (strcmp(arquivo_entrada, arquivo_saida) == 0) {
+        fprintf(stderr, "ERRO (ordenar_arquivo_binario_externo): A saida deve ser diferente da entrada.\n");
+        return 0;
+    }
+    if (orcamento_memoria == 0) {
+        orcamento_memoria = ORCAMENTO_ORDENACAO_EXTERNA_PADRAO;
+    } else if (orcamento_memoria < ORCAMENTO_ORDENACAO_EXTERNA_MINIMO) {
+        orcamento_memoria = ORCAMENTO_ORDENACAO_EXTERNA_MINIMO;
+    }
+
+    FILE* entrada = fopen(arquivo_entrada, "rb");
+    if (entrada == NULL) {
+        perror("ERRO (ordenar_arquivo_binario_externo): Falha ao abrir arquivo de entrada");
+        return 0;
+    }
+    criterios_atuais = chaves;
+    quantidade_criterios_atuais = quantidade_chaves;
+
+    // Livros no arquivo, pelo tamanho: arquivos pequenos não alocam o orçamento inteiro
+    long bytes_arquivo = -1;
+    if (fseek(entrada, 0, SEEK_END) == 0) {
+        bytes_arquivo = ftell(entrada); // -1 se o tamanho não puder ser obtido
+    }
+    rewind(entrada);
+    size_t capacidade_bloco = orcamento_memoria / (sizeof(Livro) + sizeof(const Livro*));
+    size_t livros_estimados = bytes_arquivo >= 0 ? (size_t)bytes_arquivo / sizeof(Livro) + 1 : capacidade_bloco;
+
+    // 1. Sequências ordenadas: cada bloco ocupa o orçamento (o livro e um ponteiro por livro)
+    FILE** sequencias = NULL;
+    int quantidade_sequencias = 0;
+    long livros = 0;
+    int sucesso = gerar_sequencias(entrada, capacidade_bloco < livros_estimados ? capacidade_bloco : livros_estimados,
+                                   &sequencias, &quantidade_sequencias, &livros);
+    fclose(entrada);
+    int sequencias_iniciais = quantidade_sequencias;
+    int passagens = 0;
+
+    // 2. Intercalações: o orçamento inteiro vira buffers (um por via e um de saída)
+    size_t capacidade = orcamento_memoria / sizeof(Livro);
+    if (capacidade > 2 * livros_estimados + 2) {
+        capacidade = 2 * livros_estimados + 2; // Buffers maiores que a entrada não seriam usados
+    }
+    Livro* memoria = sucesso ? (Livro*) malloc(capacidade * sizeof(Livro)) : NULL;
+    if (sucesso && memoria == NULL) {
+        perror("ERRO (ordenar_arquivo_binario_externo): Falha ao alocar buffers de intercalacao");
+        sucesso = 0;
+    }
+    int vias_maximas = capacidade - 1 < MAX_VIAS_INTERCALACAO ? (int)(capacidade - 1) : MAX_VIAS_INTERCALACAO;
+    for (int v = 0; v < quantidade_sequencias; v++) {
+        rewind(sequencias[v]);
+    }
+
+    // Passagens intermediárias: grupos de sequências vizinhas viram uma sequência cada
+    while (sucesso && quantidade_sequencias > vias_maximas) {
+        int novas = 0;
+        for (int inicio = 0; sucesso && inicio < quantidade_sequencias; inicio += vias_maximas) {
+            int grupo = quantidade_sequencias - inicio < vias_maximas ? quantidade_sequencias - inicio : vias_maximas;
+            FILE* intercalada = tmpfile();
+            if (intercalada == NULL) {
+                perror("ERRO (ordenar_arquivo_binario_externo): Falha ao criar arquivo temporario");
+                sucesso = 0;
+                break;
+            }
+            sucesso = intercalar_sequencias(&sequencias[inicio], grupo, intercalada, memoria, capacidade);
+            for (int v = inicio; v < inicio + grupo; v++) {
+                fclose(sequencias[v]);
+                sequencias[v] = NULL;
+            }
+            rewind(intercalada);
+            sequencias[novas++] = intercalada; // novas <= inicio: a posição já foi consumida
+        }
+        if (!sucesso) {
+            // Compacta o vetor (sem buracos) para que todas as sequências abertas sejam fechadas
+            int abertas = 0;
+            for (int v = 0; v < quantidade_sequencias; v++) {
+                if (sequencias[v] != NULL) {
+                    sequencias[abertas++] = sequencias[v];
+                }
+            }
+            quantidade_sequencias = abertas;
+            break;
+        }
+        quantidade_sequencias = novas;
+        passagens++;
+    }
+
+    // Última intercalação, direto no arquivo de saída
+    if (sucesso) {
+        FILE* saida = fopen(arquivo_saida, "wb");
+        if (saida == NULL) {
+            perror("ERRO (ordenar_arquivo_binario_externo): Falha ao abrir arquivo de saida");
+            sucesso = 0;
+        } else {
+            if (quantidade_sequencias > 0) {
+                sucesso = intercalar_sequencias(sequencias, quantidade_sequencias, saida, memoria, capacidade);
+                if (quantidade_sequencias > 1) {
+                    passagens++;
+                }
+            }
+            if (fclose(saida) != 0) {
+                perror("ERRO (ordenar_arquivo_binario_externo): Falha ao gravar arquivo de saida");
+                sucesso = 0;
+            }
+        }
+    }
+
+    free(memoria);
+    descartar_sequencias(sequencias, quantidade_sequencias);
+    criterios_atuais = NULL;
+    quantidade_criterios_atuais = 0;
+    if (sucesso && estatisticas != NULL) {
+        estatisticas->livros = livros;
+        estatisticas->sequencias = sequencias_iniciais;
+        estatisticas->passagens = passagens;
+    }
+    return sucesso;
+}
@@ -0,0 +1,67 @@
+#ifndef ORDENACAO_EXTERNA_H
+#define ORDENACAO_EXTERNA_H
+
+#include <stddef.h>              // Para size_t
+#include "pesquisa_ordenacao.h"  // Critérios de ordenação (ChaveOrdenacao)
+
+/**
+ * @file ordenacao_externa.h
+ * @brief Define a ordenação externa (merge sort em disco) de arquivos binários de
+ * livros, para acervos maiores que a memória disponível.
+ *
+ * O arquivo de entrada (no formato de `salvar_colecao_binario`: structs Livro em
+ * sequência) é lido em blocos que cabem no orçamento de memória; cada bloco é ordenado
+ * em memória e gravado em um arquivo temporário (uma "sequência ordenada"). As
+ * sequências são então intercaladas com um heap de mínimo, até MAX_VIAS_INTERCALACAO
+ * por vez: com mais sequências que isso, cada passagem intercala grupos de sequências
+ * vizinhas em sequências maiores, até restar uma última intercalação, gravada no
+ * arquivo de saída. Nenhum momento exige a coleção inteira na memória: o consumo fica
+ * limitado ao orçamento informado (mais alguns bytes por via de intercalação).
+ *
+ * A ordem é a mesma de `ordenar_colecao_por_chaves`, e também estável: livros iguais
+ * em todos os critérios saem na ordem em que estavam no arquivo (a intercalação
+ * desempata pela sequência mais antiga, e sequências vizinhas são intercaladas em ordem).
+ * Os arquivos temporários são criados com `tmpfile` e apagados automaticamente.
+ */
+
+/** @brief Orçamento de memória padrão da ordenação externa (64 MB). */
+#define ORCAMENTO_ORDENACAO_EXTERNA_PADRAO ((size_t)64 * 1024 * 1024)
+
+/** @brief Menor orçamento de memória aceito (64 KB, pouco mais de 200 livros). */
+#define ORCAMENTO_ORDENACAO_EXTERNA_MINIMO ((size_t)64 * 1024)
+
+/** @brief Número máximo de sequências intercaladas de uma vez (arquivos abertos juntos). */
+#define MAX_VIAS_INTERCALACAO 64
+
+/**
+ * @brief Números de uma ordenação externa, para exibição.
+ */
+typedef struct {
+    long livros;                 ///< Livros ordenados.
+    int sequencias;              ///< Sequências ordenadas geradas na primeira fase.
+    int passagens;               ///< Passagens de intercalação (0 se tudo coube na memória).
+} EstatisticasOrdenacaoExterna;
+
+// --- Protótipos das Funções ---
+
+/**
+ * @brief Ordena um arquivo binário de livros em disco, sem carregá-lo inteiro, e grava
+ * o resultado em outro arquivo binário (no mesmo formato).
+ *
+ * @param arquivo_entrada Arquivo binário de origem (ex: "biblioteca.dat"); não é alterado.
+ * @param arquivo_saida Arquivo binário de destino, diferente da entrada (é sobrescrito).
+ * @param chaves Critérios, do mais importante para o menos importante (ver
+ * `ordenar_colecao_por_chaves`).
+ * @param quantidade_chaves Número de critérios (1 a QUANTIDADE_CAMPOS_ORDENACAO).
+ * @param orcamento_memoria Memória máxima, em bytes, para os blocos ordenados e os
+ * buffers da intercalação; 0 usa ORCAMENTO_ORDENACAO_EXTERNA_PADRAO e valores menores
+ * que ORCAMENTO_ORDENACAO_EXTERNA_MINIMO são elevados a ele.
+ * @param estatisticas Opcional (pode ser NULL): recebe os números da ordenação.
+ * @return int 1 em caso de sucesso, 0 se os parâmetros forem inválidos ou houver falha
+ * de alocação ou de leitura/escrita (o arquivo de saída pode ficar incompleto).
+ */
+int ordenar_arquivo_binario_externo(const char* arquivo_entrada, const char* arquivo_saida,
+                                    const ChaveOrdenacao* chaves, int quantidade_chaves,
+                                    size_t orcamento_memoria, EstatisticasOrdenacaoExterna* estatisticas);
+
+#endif // ORDENACAO_EXTERNA_H
@@ -0,0 +1,356 @@
+#include <stdio.h>
+#include <stdlib.h> // Para malloc e free
+#include <string.h> // Para memcpy
+#include "ordenacao_paralela.h"
+
+#if defined(_WIN32) || defined(_WIN64) || defined(ORDENACAO_SEM_THREADS)
+#define ORDENACAO_SEQUENCIAL 1
+#else
+#include <pthread.h>
+#include <unistd.h> // Para sysconf
+#endif
+
+/** @brief Menor fatia de saída de uma intercalação entregue a uma thread. */
+#define FATIA_MINIMA_INTERCALACAO 4096
+
+/** @brief Fatias por thread em cada rodada (equilibra rodadas com intercalações de tamanhos diferentes). */
+#define FATIAS_POR_THREAD 4
+
+// Configuração (0 = ainda não definida; ver configurar_ordenacao_paralela)
+static int threads_configuradas = 0;
+static size_t limite_configurado = LIMITE_ORDENACAO_PARALELA_PADRAO;
+
+// --- Grupo de Threads ---
+
+/** @brief Função que executa a tarefa de número `indice`. */
+typedef void (*FuncaoTarefa)(void* contexto, int indice);
+
+/**
+ * @brief Grupo de threads de tamanho fixo, criado uma vez por ordenação paralela.
+ * Entre as fases (ordenação dos trechos e cada rodada de intercalação) as threads
+ * auxiliares esperam numa variável de condição pelo próximo lote de tarefas.
+ */
+typedef struct {
+    FuncaoTarefa executar;       ///< Função das tarefas da fase atual.
+    void* contexto;              ///< Contexto repassado a cada tarefa.
+    int quantidade;              ///< Número de tarefas da fase atual.
+    int proxima;                 ///< Próxima tarefa ainda não iniciada.
+    int pendentes;               ///< Tarefas da fase ainda não concluídas.
+#ifndef ORDENACAO_SEQUENCIAL
+    pthread_mutex_t trava;       ///< Protege todos os campos acima e abaixo.
+    pthread_cond_t nova_fase;    ///< Sinalizada quando um lote é publicado (ou no encerramento).
+    pthread_cond_t fase_concluida; ///< Sinalizada quando a última tarefa da fase termina.
+    unsigned long fase;          ///< Número do lote publicado mais recente.
+    int encerrar;                ///< 1 quando as threads auxiliares devem terminar.
+    pthread_t auxiliares[MAX_THREADS_ORDENACAO];
+    int criadas;                 ///< Threads auxiliares efetivamente criadas.
+#endif
+} GrupoThreads;
+
+#ifndef ORDENACAO_SEQUENCIAL
+/**
+ * @brief Executa as tarefas ainda não iniciadas da fase atual. Chamada e retorna com a
+ * trava obtida; a trava é liberada durante cada tarefa.
+ */
+static void executar_pendentes(GrupoThreads* grupo) {
+    while (grupo->proxima < grupo->quantidade) {
+        int indice = grupo->proxima++;
+        pthread_mutex_unlock(&grupo->trava);
+        grupo->executar(grupo->contexto, indice);
+        pthread_mutex_lock(&grupo->trava);
+        if (--grupo->pendentes == 0) {
+            pthread_cond_signal(&grupo->fase_concluida);
+        }
+    }
+}
+
+/**
+ * @brief Laço de cada thread auxiliar: espera um novo lote, ajuda a executá-lo e volta
+ * a esperar, até o encerramento do grupo.
+ */
+static void* trabalhar_grupo(void* argumento) {
+    GrupoThreads* grupo = (GrupoThreads*) argumento;
+    unsigned long vista = 0;
+    pthread_mutex_lock(&grupo->trava);
+    for (;;) {
+        while (grupo->fase == vista && !grupo->encerrar) {
+            pthread_cond_wait(&grupo->nova_fase, &grupo->trava);
+        }
+        if (grupo->encerrar) {
+            break;
+        }
+        vista = grupo->fase;
+        executar_pendentes(grupo);
+    }
+    pthread_mutex_unlock(&grupo->trava);
+    return NULL;
+}
+#endif
+
+/**
+ * @brief Cria as `threads - 1` threads auxiliares do grupo (a chamadora é a restante).
+ * Se alguma não puder ser criada, o grupo fica menor e as demais fazem o trabalho dela.
+ */
+static void iniciar_grupo_threads(GrupoThreads* grupo, int threads) {
+    grupo->quantidade = 0;
+    grupo->proxima = 0;
+    grupo->pendentes = 0;
+#ifdef ORDENACAO_SEQUENCIAL
+    (void) threads;
+#else
+    pthread_mutex_init(&grupo->trava, NULL);
+    pthread_cond_init(&grupo->nova_fase, NULL);
+    pthread_cond_init(&grupo->fase_concluida, NULL);
+    grupo->fase = 0;
+    grupo->encerrar = 0;
+    grupo->criadas = 0;
+    while (grupo->criadas < threads - 1 &&
+           pthread_create(&grupo->auxiliares[grupo->criadas], NULL, trabalhar_grupo, grupo) == 0) {
+        grupo->criadas++;
+    }
+#endif
+}
+
+/**
+ * @brief Executa as tarefas 0..quantidade-1 com o grupo (a chamadora inclusive) e só
+ * retorna quando todas terminarem.
+ */
+static void executar_tarefas(GrupoThreads* grupo, int quantidade, FuncaoTarefa executar, void* contexto) {
+#ifdef ORDENACAO_SEQUENCIAL
+    (void) grupo;
+    for (int i = 0; i < quantidade; i++) {
+        executar(contexto, i);
+    }
+#else
+    pthread_mutex_lock(&grupo->trava);
+    grupo->executar = executar;
+    grupo->contexto = contexto;
+    grupo->quantidade = quantidade;
+    grupo->proxima = 0;
+    grupo->pendentes = quantidade;
+    grupo->fase++;
+    pthread_cond_broadcast(&grupo->nova_fase);
+    executar_pendentes(grupo);
+    while (grupo->pendentes > 0) {
+        pthread_cond_wait(&grupo->fase_concluida, &grupo->trava);
+    }
+    pthread_mutex_unlock(&grupo->trava);
+#endif
+}
+
+/**
+ * @brief Encerra e aguarda as threads auxiliares e libera os recursos do grupo.
+ */
+static void encerrar_grupo_threads(GrupoThreads* grupo) {
+#ifdef ORDENACAO_SEQUENCIAL
+    (void) grupo;
+#else
+    pthread_mutex_lock(&grupo->trava);
+    grupo->encerrar = 1;
+    pthread_cond_broadcast(&grupo->nova_fase);
+    pthread_mutex_unlock(&grupo->trava);
+    for (int i = 0; i < grupo->criadas; i++) {
+        pthread_join(grupo->auxiliares[i], NULL);
+    }
+    pthread_cond_destroy(&grupo->fase_concluida);
+    pthread_cond_destroy(&grupo->nova_fase);
+    pthread_mutex_destroy(&grupo->trava);
+#endif
+}
+
+// --- Ordenação ---
+
+/**
+ * @brief Estado de uma ordenação paralela (trechos e rodadas de intercalação).
+ */
+typedef struct {
+    size_t tamanho;                  ///< Tamanho de cada elemento.
+    OrdenadorTrecho ordenar_trecho;  ///< Ordenação sequencial dos trechos.
+    ComparadorElementos comparar;    ///< Comparação das intercalações.
+    char* origem;                    ///< Vetor com os trechos ordenados da rodada atual.
+    char* destino;                   ///< Vetor que recebe as intercalações da rodada.
+    size_t* limites;                 ///< Início de cada trecho; limites[trechos] = fim do vetor.
+    int trechos;                     ///< Número de trechos da rodada atual.
+
+    // Fatias da rodada atual: a fatia f pertence à intercalação `par_da_fatia[f]` e
+    // produz as posições [diagonal_da_fatia[f], diagonal_da_fatia[f + 1]) da saída dela.
+    int* par_da_fatia;
+    size_t* diagonal_da_fatia;
+} OrdenacaoParalela;
+
+/**
+ * @brief Tarefa da primeira fase: ordena o trecho `indice`.
+ */
+static void ordenar_trecho_tarefa(void* contexto, int indice) {
+    OrdenacaoParalela* ordenacao = (OrdenacaoParalela*) contexto;
+    size_t inicio = ordenacao->limites[indice];
+    ordenacao->ordenar_trecho(ordenacao->origem + inicio * ordenacao->tamanho,
+                              ordenacao->limites[indice + 1] - inicio);
+}
+
+/**
+ * @brief Merge path: quantos elementos de `a` estão entre os `diagonal` primeiros da
+ * intercalação de `a` e `b` (empates saem de `a` primeiro).
+ */
+static size_t cortar_diagonal(const OrdenacaoParalela* ordenacao, const char* a, size_t quantidade_a,
+                              const char* b, size_t quantidade_b, size_t diagonal) {
+    size_t inicio = diagonal > quantidade_b ? diagonal - quantidade_b : 0;
+    size_t fim = diagonal < quantidade_a ? diagonal : quantidade_a;
+    while (inicio < fim) {
+        size_t meio = inicio + (fim - inicio) / 2;
+        // a[meio] vem antes de b[diagonal - meio - 1]? Então está entre os `diagonal` primeiros.
+        if (ordenacao->comparar(a + meio * ordenacao->tamanho,
+                                b + (diagonal - meio - 1) * ordenacao->tamanho) <= 0) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return inicio;
+}
+
+/**
+ * @brief Tarefa das rodadas: produz uma fatia da intercalação dos trechos 2p e 2p+1.
+ */
+static void intercalar_fatia_tarefa(void* contexto, int indice) {
+    OrdenacaoParalela* ordenacao = (OrdenacaoParalela*) contexto;
+    size_t tamanho = ordenacao->tamanho;
+    int par = ordenacao->par_da_fatia[indice];
+
+    size_t inicio = ordenacao->limites[2 * par];
+    size_t meio = ordenacao->limites[2 * par + 1 < ordenacao->trechos ? 2 * par + 1 : ordenacao->trechos];
+    size_t fim = ordenacao->limites[2 * par + 2 < ordenacao->trechos ? 2 * par + 2 : ordenacao->trechos];
+    const char* a = ordenacao->origem + inicio * tamanho;
+    const char* b = ordenacao->origem + meio * tamanho;
+    size_t quantidade_a = meio - inicio;
+    size_t quantidade_b = fim - meio;
+
+    size_t diagonal_inicial = ordenacao->diagonal_da_fatia[indice];
+    size_t diagonal_final = ordenacao->par_da_fatia[indice + 1] == par
+                                ? ordenacao->diagonal_da_fatia[indice + 1]
+                                : fim - inicio; // Última fatia do par
+
+    size_t i = cortar_diagonal(ordenacao, a, quantidade_a, b, quantidade_b, diagonal_inicial);
+    size_t j = diagonal_inicial - i;
+    size_t i_final = cortar_diagonal(ordenacao, a, quantidade_a, b, quantidade_b, diagonal_final);
+    size_t j_final = diagonal_final - i_final;
+
+    char* saida = ordenacao->destino + (inicio + diagonal_inicial) * tamanho;
+    while (i < i_final && j < j_final) {
+        if (ordenacao->comparar(a + i * tamanho, b + j * tamanho) <= 0) {
+            memcpy(saida, a + i++ * tamanho, tamanho);
+        } else {
+            memcpy(saida, b + j++ * tamanho, tamanho);
+        }
+        saida += tamanho;
+    }
+    memcpy(saida, a + i * tamanho, (i_final - i) * tamanho);
+    saida += (i_final - i) * tamanho;
+    memcpy(saida, b + j * tamanho, (j_final - j) * tamanho);
+}
+
+void configurar_ordenacao_paralela(int threads, size_t limite) {
+    threads_configuradas = threads > MAX_THREADS_ORDENACAO ? MAX_THREADS_ORDENACAO : (threads > 0 ? threads : 0);
+    limite_configurado = limite > 0 ? limite : LIMITE_ORDENACAO_PARALELA_PADRAO;
+}
+
+int threads_ordenacao_paralela(void) {
+#ifdef ORDENACAO_SEQUENCIAL
+    return 1;
+#else
+    if (threads_configuradas > 0) {
+        return threads_configuradas;
+    }
+    long processadores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (processadores < 1) {
+        return 1;
+    }
+    return processadores > MAX_THREADS_ORDENACAO ? MAX_THREADS_ORDENACAO : (int) processadores;
+#endif
+}
+
+int ordenar_em_paralelo(void* base, size_t quantidade, size_t tamanho,
+                        OrdenadorTrecho ordenar_trecho, ComparadorElementos comparar) {
+    int threads = threads_ordenacao_paralela();
+    if (quantidade < limite_configurado || quantidade < 2 * (size_t)threads || threads < 2) {
+        ordenar_trecho(base, quantidade);
+        return 1;
+    }
+
+    // Uma fatia por (FATIAS_POR_THREAD * threads) da saída, no mínimo FATIA_MINIMA_INTERCALACAO
+    size_t fatia = quantidade / ((size_t)threads * FATIAS_POR_THREAD);
+    if (fatia < FATIA_MINIMA_INTERCALACAO) {
+        fatia = FATIA_MINIMA_INTERCALACAO;
+    }
+    int maximo_fatias = (int)(quantidade / fatia) + threads + 1;
+
+    OrdenacaoParalela ordenacao;
+    ordenacao.tamanho = tamanho;
+    ordenacao.ordenar_trecho = ordenar_trecho;
+    ordenacao.comparar = comparar;
+    ordenacao.origem = (char*) base;
+    ordenacao.destino = (char*) malloc(quantidade * tamanho);
+    ordenacao.limites = (size_t*) malloc(((size_t)threads + 1) * sizeof(size_t));
+    ordenacao.par_da_fatia = (int*) malloc(((size_t)maximo_fatias + 1) * sizeof(int));
+    ordenacao.diagonal_da_fatia = (size_t*) malloc(((size_t)maximo_fatias + 1) * sizeof(size_t));
+    if (ordenacao.destino == NULL || ordenacao.limites == NULL ||
+        ordenacao.par_da_fatia == NULL || ordenacao.diagonal_da_fatia == NULL) {
+        perror("ERRO (ordenar_em_paralelo): Falha ao alocar vetores temporarios; ordenando sequencialmente");
+        free(ordenacao.destino);
+        free(ordenacao.limites);
+        free(ordenacao.par_da_fatia);
+        free(ordenacao.diagonal_da_fatia);
+        ordenar_trecho(base, quantidade);
+        return 1;
+    }
+
+    // O grupo de threads é criado uma única vez e atende todas as fases
+    GrupoThreads grupo;
+    iniciar_grupo_threads(&grupo, threads);
+
+    // 1. Um trecho por thread, ordenados em paralelo
+    ordenacao.trechos = threads;
+    for (int t = 0; t <= threads; t++) {
+        ordenacao.limites[t] = quantidade * (size_t)t / (size_t)threads;
+    }
+    executar_tarefas(&grupo, threads, ordenar_trecho_tarefa, &ordenacao);
+
+    // 2. Rodadas de intercalação dos trechos dois a dois, até sobrar um
+    while (ordenacao.trechos > 1) {
+        int pares = (ordenacao.trechos + 1) / 2;
+        int fatias = 0;
+        for (int p = 0; p < pares; p++) {
+            size_t inicio = ordenacao.limites[2 * p];
+            size_t fim = ordenacao.limites[2 * p + 2 < ordenacao.trechos ? 2 * p + 2 : ordenacao.trechos];
+            for (size_t diagonal = 0; diagonal < fim - inicio; diagonal += fatia) {
+                ordenacao.par_da_fatia[fatias] = p;
+                ordenacao.diagonal_da_fatia[fatias] = diagonal;
+                fatias++;
+            }
+        }
+        ordenacao.par_da_fatia[fatias] = -1; // Sentinela: a última fatia vai até o fim do par
+        ordenacao.diagonal_da_fatia[fatias] = 0;
+        executar_tarefas(&grupo, fatias, intercalar_fatia_tarefa, &ordenacao);
+
+        // Os limites da próxima rodada são os limites pares desta
+        for (int p = 0; p <= pares; p++) {
+            ordenacao.limites[p] = ordenacao.limites[2 * p < ordenacao.trechos ? 2 * p : ordenacao.trechos];
+        }
+        ordenacao.trechos = pares;
+        char* trocado = ordenacao.origem;
+        ordenacao.origem = ordenacao.destino;
+        ordenacao.destino = trocado;
+    }
+    encerrar_grupo_threads(&grupo);
+
+    // O resultado ficou no vetor auxiliar? Copia de volta.
+    if (ordenacao.origem != (char*) base) {
+        memcpy(base, ordenacao.origem, quantidade * tamanho);
+        ordenacao.destino = ordenacao.origem;
+    }
+    free(ordenacao.destino);
+    free(ordenacao.limites);
+    free(ordenacao.par_da_fatia);
+    free(ordenacao.diagonal_da_fatia);
+    return threads;
+}
@@ -0,0 +1,80 @@
+#ifndef ORDENACAO_PARALELA_H
+#define ORDENACAO_PARALELA_H
+
+#include <stddef.h> // Para size_t
+
+/**
+ * @file ordenacao_paralela.h
+ * @brief Define a ordenação paralela (merge sort em vários núcleos) usada nas
+ * ordenações grandes da coleção.
+ *
+ * O vetor é dividido em um trecho por thread, e cada trecho é ordenado pela função
+ * sequencial informada por quem chama. Os trechos ordenados são então intercalados
+ * dois a dois, em rodadas; em cada rodada, a saída de cada intercalação é dividida em
+ * fatias de mesmo tamanho e o ponto de corte de cada fatia nos dois trechos é achado
+ * por busca binária na diagonal da intercalação (merge path), de modo que todas as
+ * threads trabalham em todas as rodadas, inclusive na última, que tem uma única
+ * intercalação. Em empates a intercalação prefere o trecho da esquerda, então o
+ * resultado é estável se a ordenação de cada trecho for; com uma comparação de ordem
+ * total (sem empates), o resultado é idêntico ao da ordenação sequencial.
+ *
+ * As threads formam um grupo de tamanho fixo, criado uma vez por ordenação paralela e
+ * reaproveitado em todas as fases: entre a ordenação dos trechos e cada rodada de
+ * intercalação, as threads esperam numa variável de condição pelo próximo lote de
+ * tarefas, e só terminam ao fim da ordenação. A thread que chama também trabalha. Vetores menores que o limite configurado (ou com
+ * uma única thread configurada) são ordenados sequencialmente, sem memória extra. Em
+ * Windows (ou compilando com -DORDENACAO_SEM_THREADS), a ordenação é sempre sequencial.
+ */
+
+/** @brief Tamanho mínimo padrão (em elementos) para ordenar em paralelo. */
+#define LIMITE_ORDENACAO_PARALELA_PADRAO 100000
+
+/** @brief Número máximo de threads usadas em uma ordenação. */
+#define MAX_THREADS_ORDENACAO 32
+
+/**
+ * @brief Função que ordena sequencialmente um trecho contíguo do vetor.
+ * @param inicio Primeiro elemento do trecho.
+ * @param quantidade Número de elementos do trecho.
+ */
+typedef void (*OrdenadorTrecho)(void* inicio, size_t quantidade);
+
+/**
+ * @brief Função de comparação, no formato usado por qsort, consistente com o OrdenadorTrecho.
+ */
+typedef int (*ComparadorElementos)(const void* a, const void* b);
+
+// --- Protótipos das Funções ---
+
+/**
+ * @brief Configura o número de threads e o tamanho mínimo da ordenação paralela.
+ * @param threads Número de threads (limitado a MAX_THREADS_ORDENACAO); 0 usa o número
+ * de processadores disponíveis (o padrão).
+ * @param limite Tamanho mínimo, em elementos, para ordenar em paralelo; 0 volta ao padrão.
+ */
+void configurar_ordenacao_paralela(int threads, size_t limite);
+
+/**
+ * @brief Retorna o número de threads que uma ordenação paralela usará.
+ * @return int Número de threads (1 se a ordenação for sempre sequencial).
+ */
+int threads_ordenacao_paralela(void);
+
+/**
+ * @brief Ordena um vetor, em paralelo se ele tiver pelo menos o tamanho mínimo
+ * configurado e houver mais de uma thread, ou sequencialmente caso contrário.
+ *
+ * O caminho paralelo aloca um vetor auxiliar do tamanho do vetor ordenado; se a
+ * alocação falhar, o vetor é ordenado sequencialmente.
+ *
+ * @param base Início do vetor.
+ * @param quantidade Número de elementos.
+ * @param tamanho Tamanho de cada elemento em bytes.
+ * @param ordenar_trecho Ordenação sequencial de um trecho (usada também no caminho sequencial).
+ * @param comparar Comparação usada nas intercalações, com a mesma ordem de `ordenar_trecho`.
+ * @return int O número de threads usadas (1 = ordenação sequencial).
+ */
+int ordenar_em_paralelo(void* base, size_t quantidade, size_t tamanho,
+                        OrdenadorTrecho ordenar_trecho, ComparadorElementos comparar);
+
+#endif // ORDENACAO_PARALELA_H
@@ -3,236 +3,1611 @@
 #include <string.h> // Para strstr, strcmp
 #include "pesquisa_ordenacao.h"
 #include "livro.h"         // Para struct Livro e exibir_livro (se usado aqui)
-#include "lista_livros.h"  // Para ColecaoLivros, NoLista
+#include "lista_livros.h"  // Para ColecaoLivros, ArmazemLivros
+#include "busca_substring.h" // Varredura vetorizada (SSE2/AVX2) das arenas de textos
+#include "ordenacao_paralela.h" // Ordenação das referências em vários núcleos
 
 // --- FUNÇÕES DE PESQUISA E ORDENAÇÃO APRIMORADAS ---
 
+/**
+ * @brief Retorna o texto dobrado (minúsculas, sem acentos) do campo pesquisado de um registro.
+ */
+static const char* texto_do_campo(const ArmazemLivros* armazem, const RegistroLivro* registro, CampoPesquisa campo) {
+    return campo == CAMPO_AUTOR ? autor_dobrado_registro(armazem, registro) : titulo_dobrado_registro(armazem, registro);
+}
+
+/**
+ * @brief Função de comparação para qsort de posições (inteiros em ordem crescente).
+ */
+static int comparar_posicoes(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Acrescenta uma posição ao vetor de resultados de uma varredura, dobrando-o se preciso.
+ * @return int 1 em caso de sucesso, 0 se a realocação falhar.
+ */
+static int acrescentar_posicao(int** posicoes, int* quantidade, int* capacidade, int posicao) {
+    if (*quantidade == *capacidade) {
+        int nova = *capacidade > 0 ? *capacidade * 2 : 64;
+        int* maior = (int*) realloc(*posicoes, (size_t)nova * sizeof(int));
+        if (maior == NULL) {
+            perror("ERRO (acrescentar_posicao): Falha ao alocar resultados da pesquisa");
+            return 0;
+        }
+        *posicoes = maior;
+        *capacidade = nova;
+    }
+    (*posicoes)[(*quantidade)++] = posicao;
+    return 1;
+}
+
+/**
+ * @brief Varre a arena de títulos dobrados inteira com `buscar_substring` e coleta as
+ * posições dos registros cujo título contém o termo (já dobrado), em ordem crescente.
+ * Depois de uma ocorrência, a varredura salta para o título seguinte.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+static int varrer_titulos(const ArmazemLivros* armazem, const char* termo, int** posicoes, int* quantidade) {
+    const char* dados = armazem->titulos_dobrados.dados;
+    const char* fim = dados + armazem->titulos_dobrados.usado;
+    size_t tamanho_termo = strlen(termo);
+    int capacidade = 0;
+    int ordenado = 1;
+    *posicoes = NULL;
+    *quantidade = 0;
+
+    const char* atual = dados;
+    const char* achado;
+    while (atual < fim && (achado = buscar_substring(atual, (size_t)(fim - atual), termo, tamanho_termo)) != NULL) {
+        int titulo = localizar_titulo_na_arena(armazem, (size_t)(achado - dados));
+        int handle = armazem->donos_titulos[titulo].handle;
+        if (handle != HANDLE_INVALIDO) { // Ignora títulos de livros já removidos
+            int posicao = posicao_do_handle(armazem, handle);
+            if (*quantidade > 0 && (*posicoes)[*quantidade - 1] > posicao) {
+                ordenado = 0; // A coleção foi ordenada depois que os títulos foram gravados
+            }
+            if (!acrescentar_posicao(posicoes, quantidade, &capacidade, posicao)) {
+                free(*posicoes);
+                *posicoes = NULL;
+                return 0;
+            }
+        }
+        atual = titulo + 1 < armazem->quantidade_titulos ? dados + armazem->donos_titulos[titulo + 1].deslocamento : fim;
+    }
+
+    if (!ordenado) {
+        qsort(*posicoes, (size_t)*quantidade, sizeof(int), comparar_posicoes);
+    }
+    return 1;
+}
+
+/**
+ * @brief Varre apenas os autores dobrados distintos (arena do dicionário) com
+ * `buscar_substring`, marca os IDs cujo texto contém o termo (já dobrado) e coleta, em
+ * ordem, as posições dos registros com esses autores (comparação de inteiros).
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+static int varrer_autores(const ArmazemLivros* armazem, const char* termo, int** posicoes, int* quantidade) {
+    const DicionarioTextos* autores = &armazem->autores_dobrados;
+    int capacidade = 0;
+    *posicoes = NULL;
+    *quantidade = 0;
+    if (autores->quantidade == 0) {
+        return 1;
+    }
+
+    unsigned char* aceito = (unsigned char*) calloc((size_t)autores->quantidade, sizeof(unsigned char));
+    if (aceito == NULL) {
+        perror("ERRO (varrer_autores): Falha ao alocar marcas de autores");
+        return 0;
+    }
+    const char* dados = autores->textos.dados;
+    const char* fim = dados + autores->textos.usado;
+    size_t tamanho_termo = strlen(termo);
+    int algum = 0;
+    const char* atual = dados;
+    const char* achado;
+    while (atual < fim && (achado = buscar_substring(atual, (size_t)(fim - atual), termo, tamanho_termo)) != NULL) {
+        int id = id_do_deslocamento(autores, (size_t)(achado - dados));
+        aceito[id] = 1;
+        algum = 1;
+        atual = id + 1 < autores->quantidade ? dados + autores->deslocamentos[id + 1] : fim;
+    }
+
+    int sucesso = 1;
+    for (int i = 0; algum && i < armazem->quantidade; i++) {
+        if (aceito[armazem->registros[i].id_autor_dobrado] &&
+            !acrescentar_posicao(posicoes, quantidade, &capacidade, i)) {
+            free(*posicoes);
+            *posicoes = NULL;
+            sucesso = 0;
+            break;
+        }
+    }
+    free(aceito);
+    return sucesso;
+}
+
+/**
+ * @brief Calcula as posições a examinar na primeira chamada do cursor.
+ * - Com o índice de trigramas do campo ativo e termo de 3+ bytes: os candidatos do
+ *   índice, convertidos para posições e reordenados (ainda precisam ser verificados).
+ * - Caso contrário, com termo não vazio: as posições exatas, obtidas varrendo a arena
+ *   do campo de uma só vez com `buscar_substring` (não precisam de verificação).
+ * - Termo vazio ou falha de alocação: todas as posições, verificadas uma a uma.
+ * Em todos os casos, os resultados saem na ordem da coleção.
+ */
+static void preparar_cursor(const ColecaoLivros* colecao, CursorPesquisa* cursor) {
+    cursor->preparado = 1;
+    cursor->verificar = 1;
+
+    // O termo é dobrado uma única vez; os textos dos registros já estão dobrados.
+    size_t tamanho_termo = strlen(cursor->termo) + 1;
+    cursor->termo_dobrado = (char*) malloc(tamanho_termo);
+    if (cursor->termo_dobrado == NULL) {
+        perror("ERRO (preparar_cursor): Falha ao alocar termo da pesquisa");
+        cursor->restantes = 0;
+        return;
+    }
+    dobrar_texto(cursor->termo, cursor->termo_dobrado, tamanho_termo);
+
+    // Pesquisa repetida desde a última alteração da coleção: posições exatas do cache.
+    CacheConsultas* cache = cursor->termo_dobrado[0] != '\0' ? colecao->cache_consultas : NULL;
+    TipoConsultaCache tipo = cursor->campo == CAMPO_AUTOR ? CACHE_PESQUISA_AUTOR : CACHE_PESQUISA_TITULO;
+    const void* guardadas;
+    size_t tamanho;
+    if (cache != NULL && buscar_cache_consultas(cache, colecao->geracao, tipo, 0, cursor->termo_dobrado, &guardadas, &tamanho)) {
+        int* copia = tamanho > 0 ? (int*) malloc(tamanho) : NULL;
+        if (tamanho == 0 || copia != NULL) {
+            if (copia != NULL) {
+                memcpy(copia, guardadas, tamanho);
+            }
+            cursor->verificar = 0;
+            cursor->posicoes = copia;
+            cursor->total_posicoes = (int)(tamanho / sizeof(int));
+            if (copia == NULL) {
+                cursor->restantes = 0;
+            }
+            return;
+        }
+        // Sem memória para a cópia: recalcula normalmente
+    }
+
+    const IndiceTrigramas* indice = cursor->campo == CAMPO_AUTOR ? colecao->indice_autores : colecao->indice_titulos;
+    int* posicoes;
+    int quantidade;
+    if (indice != NULL && buscar_candidatos_trigramas(indice, cursor->termo_dobrado, &posicoes, &quantidade)) {
+        // Reaproveita o vetor de handles para guardar as posições.
+        for (int i = 0; i < quantidade; i++) {
+            posicoes[i] = posicao_do_handle(&colecao->armazem, posicoes[i]);
+        }
+        if (quantidade > 1) {
+            qsort(posicoes, (size_t)quantidade, sizeof(int), comparar_posicoes);
+        }
+    } else if (cursor->termo_dobrado[0] != '\0' &&
+               (cursor->campo == CAMPO_AUTOR ? varrer_autores(&colecao->armazem, cursor->termo_dobrado, &posicoes, &quantidade)
+                                             : varrer_titulos(&colecao->armazem, cursor->termo_dobrado, &posicoes, &quantidade))) {
+        cursor->verificar = 0;
+    } else {
+        return; // Examina todas as posições
+    }
+
+    if (cache != NULL) {
+        // Para guardar o resultado exato, os candidatos do índice são verificados já
+        // aqui, em vez de página a página.
+        if (cursor->verificar) {
+            int mantidas = 0;
+            for (int i = 0; i < quantidade; i++) {
+                if (strstr(texto_do_campo(&colecao->armazem, &colecao->armazem.registros[posicoes[i]], cursor->campo),
+                           cursor->termo_dobrado) != NULL) {
+                    posicoes[mantidas++] = posicoes[i];
+                }
+            }
+            quantidade = mantidas;
+            cursor->verificar = 0;
+        }
+        guardar_cache_consultas(cache, colecao->geracao, tipo, 0, cursor->termo_dobrado,
+                                posicoes, (size_t)quantidade * sizeof(int));
+        if (quantidade == 0) {
+            free(posicoes);
+            posicoes = NULL;
+        }
+    }
+
+    cursor->posicoes = posicoes;
+    cursor->total_posicoes = quantidade;
+    if (cursor->posicoes == NULL) {
+        cursor->restantes = 0; // Nenhum candidato: a pesquisa já terminou
+    }
+}
+
+void iniciar_cursor_pesquisa(CursorPesquisa* cursor, CampoPesquisa campo, const char* termo, int deslocamento, int limite) {
+    cursor->campo = campo;
+    cursor->termo = termo;
+    cursor->termo_dobrado = NULL;
+    cursor->preparado = 0;
+    cursor->verificar = 1;
+    cursor->posicoes = NULL;
+    cursor->total_posicoes = 0;
+    cursor->proxima = 0;
+    cursor->pular = deslocamento > 0 ? deslocamento : 0;
+    cursor->restantes = limite < 0 ? -1 : limite;
+}
+
+int proximo_resultado_pesquisa(const ColecaoLivros* colecao, CursorPesquisa* cursor) {
+    if (colecao == NULL || cursor == NULL || cursor->termo == NULL) {
+        return HANDLE_INVALIDO;
+    }
+    if (!cursor->preparado) {
+        preparar_cursor(colecao, cursor);
+    }
+
+    // Varredura (completa ou só dos candidatos), retomada de onde a chamada anterior parou
+    const ArmazemLivros* armazem = &colecao->armazem;
+    while (cursor->restantes != 0) {
+        int posicao;
+        if (cursor->posicoes != NULL) {
+            if (cursor->proxima >= cursor->total_posicoes) {
+                break;
+            }
+            posicao = cursor->posicoes[cursor->proxima++];
+        } else {
+            if (cursor->proxima >= armazem->quantidade) {
+                break;
+            }
+            posicao = cursor->proxima++;
+        }
+
+        // Usar strstr nos textos dobrados; os candidatos do índice também são verificados
+        if (cursor->verificar && strstr(texto_do_campo(armazem, &armazem->registros[posicao], cursor->campo), cursor->termo_dobrado) == NULL) {
+            continue;
+        }
+        if (cursor->pular > 0) {
+            cursor->pular--; // Resultado anterior ao deslocamento pedido
+            continue;
+        }
+        if (cursor->restantes > 0) {
+            cursor->restantes--;
+        }
+        return armazem->handle_de_posicao[posicao];
+    }
+    return HANDLE_INVALIDO; // Fim da coleção ou limite atingido
+}
+
+void encerrar_cursor_pesquisa(CursorPesquisa* cursor) {
+    if (cursor == NULL) {
+        return;
+    }
+    free(cursor->posicoes);
+    free(cursor->termo_dobrado);
+    cursor->posicoes = NULL;
+    cursor->termo_dobrado = NULL;
+    cursor->total_posicoes = 0;
+}
+
+/**
+ * @brief Implementação comum das pesquisas por callback: percorre um cursor e entrega cada resultado.
+ */
+static int pesquisar_livros(const ColecaoLivros* colecao, CampoPesquisa campo, const char* termo, int deslocamento,
+                            int limite, VisitanteLivro visitar, void* contexto) {
+    if (colecao == NULL || termo == NULL || visitar == NULL) {
+        return 0;
+    }
+
+    CursorPesquisa cursor;
+    iniciar_cursor_pesquisa(&cursor, campo, termo, deslocamento, limite);
+    int entregues = 0;
+    int handle;
+    while ((handle = proximo_resultado_pesquisa(colecao, &cursor)) != HANDLE_INVALIDO) {
+        entregues++;
+        if (!visitar(&colecao->armazem, obter_registro_armazem(&colecao->armazem, handle), handle, contexto)) {
+            break; // Interrompida por quem pediu a pesquisa
+        }
+    }
+    encerrar_cursor_pesquisa(&cursor);
+    return entregues;
+}
+
+int pesquisar_livros_por_titulo(const ColecaoLivros* colecao, const char* titulo_busca, int deslocamento,
+                                int limite, VisitanteLivro visitar, void* contexto) {
+    return pesquisar_livros(colecao, CAMPO_TITULO, titulo_busca, deslocamento, limite, visitar, contexto);
+}
+
+int pesquisar_livros_por_autor(const ColecaoLivros* colecao, const char* autor_busca, int deslocamento,
+                               int limite, VisitanteLivro visitar, void* contexto) {
+    return pesquisar_livros(colecao, CAMPO_AUTOR, autor_busca, deslocamento, limite, visitar, contexto);
+}
+
 /**
  * @brief Pesquisa o primeiro livro na coleção cujo título contém a string de busca.
- * A busca é case-sensitive e considera substrings (ex: buscar por "Senhor" pode encontrar "O Senhor dos Anéis").
+ * A busca não diferencia maiúsculas nem acentos e considera substrings (ex: buscar por "senhor" encontra "O Senhor dos Anéis").
  *
  * @param colecao Ponteiro constante para a ColecaoLivros a ser pesquisada.
  * @param titulo_busca String constante contendo o título (ou parte dele) a ser buscado.
- * @return const Livro* Ponteiro constante para os dados do primeiro livro encontrado,
- * ou NULL se nenhum livro corresponder, ou se os parâmetros forem inválidos.
- * @warning O ponteiro retornado aponta para dados internos da lista.
- * Não modifique o conteúdo apontado e não libere este ponteiro.
- * @note Se múltiplos livros corresponderem, apenas o primeiro encontrado na ordem da lista é retornado.
- * Para encontrar todos, seria necessária uma função diferente (ex: iterar e aplicar um callback).
- */
-const Livro* pesquisar_livro_por_titulo(const ColecaoLivros* colecao, const char* titulo_busca) {
+ * @param livro_encontrado Ponteiro para a struct Livro que receberá os dados do primeiro
+ * livro encontrado, ou NULL se só a existência importar.
+ * @return int 1 se algum livro corresponder, 0 se nenhum corresponder ou se os parâmetros forem inválidos.
+ * @note Se múltiplos livros corresponderem, apenas o primeiro encontrado na ordem da coleção é retornado.
+ * Para encontrar todos, use `pesquisar_livros_por_titulo` ou um CursorPesquisa.
+ */
+int pesquisar_livro_por_titulo(const ColecaoLivros* colecao, const char* titulo_busca, Livro* livro_encontrado) {
     if (colecao == NULL || titulo_busca == NULL) {
-        return NULL;
+        return 0;
+    }
+
+    CursorPesquisa cursor;
+    iniciar_cursor_pesquisa(&cursor, CAMPO_TITULO, titulo_busca, 0, 1);
+    int handle = proximo_resultado_pesquisa(colecao, &cursor);
+    encerrar_cursor_pesquisa(&cursor);
+    if (handle == HANDLE_INVALIDO) {
+        return 0; // Não encontrado
+    }
+    if (livro_encontrado != NULL) {
+        materializar_livro(&colecao->armazem, obter_registro_armazem(&colecao->armazem, handle), livro_encontrado);
     }
+    return 1;
+}
 
-    const NoLista* atual = colecao->inicio;
-    while (atual != NULL) {
-        // Usar strstr para busca de substring (case-sensitive)
-        if (strstr(atual->dadosLivro.titulo, titulo_busca) != NULL) {
-            return &(atual->dadosLivro); // Retorna ponteiro para os dados do livro no nó
+int sugerir_completamentos(const ColecaoLivros* colecao, CampoPesquisa campo, const char* prefixo, int maximo,
+                           OrdemSugestoes ordem, const char** sugestoes, int* popularidades) {
+    if (colecao == NULL || prefixo == NULL || colecao->prefixos_titulos == NULL) {
+        return 0;
+    }
+
+    // O prefixo é dobrado como os textos indexados; sem acentos, o texto dobrado nunca
+    // é maior que o original (ver normalizacao.h), então TAM_TITULO basta para ambos os campos.
+    char prefixo_dobrado[TAM_TITULO];
+    dobrar_texto(prefixo, prefixo_dobrado, sizeof(prefixo_dobrado));
+
+    IndicePrefixos* indice = campo == CAMPO_AUTOR ? colecao->prefixos_autores : colecao->prefixos_titulos;
+    return buscar_prefixo(indice, prefixo_dobrado, maximo, ordem, sugestoes, popularidades);
+}
+
+int contar_livros_por_ano(const ColecaoLivros* colecao, int ano_minimo, int ano_maximo) {
+    if (colecao == NULL) {
+        return 0;
+    }
+    return contar_intervalo_anos(&colecao->indice_anos, ano_minimo, ano_maximo);
+}
+
+int pesquisar_livros_por_ano(const ColecaoLivros* colecao, int ano_minimo, int ano_maximo, int deslocamento,
+                             int limite, VisitanteLivro visitar, void* contexto) {
+    if (colecao == NULL || visitar == NULL) {
+        return 0;
+    }
+
+    // Percorre apenas os baldes do intervalo, pulando baldes inteiros no deslocamento.
+    const IndiceAnos* indice = &colecao->indice_anos;
+    int pular = deslocamento > 0 ? deslocamento : 0;
+    int entregues = 0;
+    for (int b = primeiro_balde_anos(indice, ano_minimo);
+         b < indice->quantidade_baldes && indice->baldes[b].ano <= ano_maximo; b++) {
+        const BaldeAno* balde = &indice->baldes[b];
+        if (pular >= balde->quantidade) {
+            pular -= balde->quantidade;
+            continue;
+        }
+        for (int i = pular; i < balde->quantidade; i++) {
+            if (limite >= 0 && entregues == limite) {
+                return entregues;
+            }
+            int handle = balde->handles[i];
+            entregues++;
+            if (!visitar(&colecao->armazem, obter_registro_armazem(&colecao->armazem, handle), handle, contexto)) {
+                return entregues; // Interrompida por quem pediu a pesquisa
+            }
         }
-        // Para correspondência exata (case-sensitive):
-        // if (strcmp(atual->dadosLivro.titulo, titulo_busca) == 0) {
-        //     return &(atual->dadosLivro);
-        // }
-        atual = atual->proximo;
+        pular = 0;
     }
-    return NULL; // Não encontrado
+    return entregues;
+}
+
+int contar_livros_por_genero(const ColecaoLivros* colecao, const char* genero) {
+    if (colecao == NULL || genero == NULL) {
+        return 0;
+    }
+    return contar_genero(&colecao->indice_generos, buscar_id_texto(&colecao->armazem.generos, genero));
 }
 
 /**
- * @brief Função de comparação para qsort, para ordenar Livros por título (alfabética, case-sensitive).
- * Espera que 'a' e 'b' sejam ponteiros para structs Livro.
- *
- * @param a Ponteiro void para o primeiro Livro.
- * @param b Ponteiro void para o segundo Livro.
- * @return int <0 se o título de 'a' vem antes de 'b', 0 se são iguais, >0 se 'a' vem depois de 'b'.
+ * @brief Função de comparação para qsort do histograma: quantidade decrescente, depois
+ * gênero em ordem alfabética.
+ */
+static int comparar_contagens_genero(const void* a, const void* b) {
+    const ContagemGenero* x = (const ContagemGenero*)a;
+    const ContagemGenero* y = (const ContagemGenero*)b;
+    if (x->quantidade != y->quantidade) {
+        return (x->quantidade < y->quantidade) - (x->quantidade > y->quantidade);
+    }
+    return strcmp(x->genero, y->genero);
+}
+
+int histograma_generos(const ColecaoLivros* colecao, ContagemGenero* contagens, int maximo) {
+    if (colecao == NULL || contagens == NULL || maximo <= 0) {
+        return 0;
+    }
+
+    // Um gênero por ID do dicionário; poucas dezenas, então ordenar todos é barato.
+    const DicionarioTextos* generos = &colecao->armazem.generos;
+    ContagemGenero* todas = (ContagemGenero*) malloc((size_t)(generos->quantidade > 0 ? generos->quantidade : 1) * sizeof(ContagemGenero));
+    if (todas == NULL) {
+        perror("ERRO (histograma_generos): Falha ao alocar histograma");
+        return 0;
+    }
+    int total = 0;
+    for (int id = 0; id < generos->quantidade; id++) {
+        int quantidade = contar_genero(&colecao->indice_generos, id);
+        if (quantidade > 0) {
+            todas[total].genero = texto_do_id(generos, id);
+            todas[total].quantidade = quantidade;
+            total++;
+        }
+    }
+    qsort(todas, (size_t)total, sizeof(ContagemGenero), comparar_contagens_genero);
+
+    int gravadas = total < maximo ? total : maximo;
+    memcpy(contagens, todas, (size_t)gravadas * sizeof(ContagemGenero));
+    free(todas);
+    return gravadas;
+}
+
+int pesquisar_livros_por_generos(const ColecaoLivros* colecao, const char* const* generos, int quantidade_generos,
+                                 int deslocamento, int limite, VisitanteLivro visitar, void* contexto) {
+    if (colecao == NULL || generos == NULL || visitar == NULL) {
+        return 0;
+    }
+
+    // Um gênero: o conjunto do índice é percorrido diretamente. Vários: a união é
+    // acumulada alternando entre dois conjuntos temporários.
+    const BitmapHandles* conjunto = NULL;
+    BitmapHandles uniao[2];
+    inicializar_bitmap(&uniao[0]);
+    inicializar_bitmap(&uniao[1]);
+    int atual = 0;
+    for (int g = 0; g < quantidade_generos; g++) {
+        int id = generos[g] != NULL ? buscar_id_texto(&colecao->armazem.generos, generos[g]) : -1;
+        const BitmapHandles* do_genero = conjunto_do_genero(&colecao->indice_generos, id);
+        if (do_genero == NULL || do_genero->cardinalidade == 0) {
+            continue;
+        }
+        if (conjunto == NULL) {
+            conjunto = do_genero;
+            continue;
+        }
+        if (!unir_bitmaps(conjunto, do_genero, &uniao[atual])) {
+            liberar_bitmap(&uniao[0]);
+            liberar_bitmap(&uniao[1]);
+            return 0;
+        }
+        conjunto = &uniao[atual];
+        atual = 1 - atual;
+    }
+
+    int entregues = 0;
+    if (conjunto != NULL) {
+        int pular = deslocamento > 0 ? deslocamento : 0;
+        IteradorBitmap iterador;
+        iniciar_iterador_bitmap(&iterador, conjunto);
+        for (int handle = proximo_bitmap(&iterador); handle >= 0; handle = proximo_bitmap(&iterador)) {
+            if (pular > 0) {
+                pular--;
+                continue;
+            }
+            if (limite >= 0 && entregues == limite) {
+                break;
+            }
+            entregues++;
+            if (!visitar(&colecao->armazem, obter_registro_armazem(&colecao->armazem, handle), handle, contexto)) {
+                break; // Interrompida por quem pediu a pesquisa
+            }
+        }
+    }
+    liberar_bitmap(&uniao[0]);
+    liberar_bitmap(&uniao[1]);
+    return entregues;
+}
+
+int percorrer_visao_ordenada(const ColecaoLivros* colecao, TipoVisao tipo, int decrescente, int deslocamento,
+                             int limite, VisitanteLivro visitar, void* contexto) {
+    if (colecao == NULL || colecao->visoes == NULL || tipo < 0 || tipo >= QUANTIDADE_VISOES || visitar == NULL) {
+        return 0;
+    }
+
+    // Percorre os blocos em sequência (ou de trás para frente), pulando blocos inteiros no deslocamento.
+    const VisaoOrdenada* visao = &colecao->visoes[tipo];
+    int pular = deslocamento > 0 ? deslocamento : 0;
+    int entregues = 0;
+    for (int b = 0; b < visao->quantidade_blocos; b++) {
+        const BlocoVisao* bloco = visao->blocos[decrescente ? visao->quantidade_blocos - 1 - b : b];
+        if (pular >= bloco->quantidade) {
+            pular -= bloco->quantidade;
+            continue;
+        }
+        for (int i = pular; i < bloco->quantidade; i++) {
+            if (limite >= 0 && entregues == limite) {
+                return entregues;
+            }
+            int handle = bloco->handles[decrescente ? bloco->quantidade - 1 - i : i];
+            entregues++;
+            if (!visitar(&colecao->armazem, obter_registro_armazem(&colecao->armazem, handle), handle, contexto)) {
+                return entregues; // Interrompida por quem pediu a listagem
+            }
+        }
+        pular = 0;
+    }
+    return entregues;
+}
+
+/** @brief Número máximo de palavras consideradas na busca difusa. */
+#define MAX_TERMOS_DIFUSOS 8
+
+/** @brief Capacidade inicial da tabela de acumuladores da busca difusa (potência de 2). */
+#define CAPACIDADE_INICIAL_ACUMULADOR 64
+
+/**
+ * @brief Acumulador de um registro tocado pela busca difusa.
+ */
+typedef struct {
+    int handle;           ///< Handle do registro.
+    int termos;           ///< Quantas palavras da busca o registro aproximou.
+    int distancia;        ///< Soma das melhores distâncias de cada palavra.
+    int melhor;           ///< Melhor distância da palavra atual para o registro.
+    int ultimo_termo;     ///< Última palavra da busca que tocou o registro.
+} EntradaDifusa;
+
+/**
+ * @brief Acumuladores esparsos da busca difusa: apenas os registros tocados ocupam
+ * memória, num vetor denso (na ordem em que apareceram) localizado por uma pequena
+ * tabela hash de endereçamento aberto indexada pelo handle. O custo da busca depende
+ * dos registros tocados, e não do tamanho da coleção.
+ */
+typedef struct {
+    EntradaDifusa* entradas;  ///< Registros tocados, na ordem em que apareceram.
+    int quantidade_tocados;
+    int* tabela;              ///< Posição em `entradas` de cada handle (-1: vazia).
+    int capacidade;           ///< Tamanho da tabela (potência de 2); `entradas` comporta metade.
+    int termo_atual;          ///< Índice da palavra da busca em andamento.
+    int falhou;               ///< 1 se uma alocação falhou durante a busca.
+} AcumuladorDifuso;
+
+/** @brief Posição inicial de um handle na tabela do acumulador. */
+static int espalhar_handle(int handle, int capacidade) {
+    return (int)(((unsigned int)handle * 2654435761u) & (unsigned int)(capacidade - 1));
+}
+
+/**
+ * @brief Dobra a tabela do acumulador e o vetor de entradas, reposicionando os handles.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar (o acumulador fica intacto).
+ */
+static int crescer_acumulador_difuso(AcumuladorDifuso* acumulador) {
+    int nova_capacidade = acumulador->capacidade * 2;
+    int* tabela = (int*) malloc((size_t)nova_capacidade * sizeof(int));
+    EntradaDifusa* entradas = (EntradaDifusa*) realloc(acumulador->entradas,
+                                                       (size_t)(nova_capacidade / 2) * sizeof(EntradaDifusa));
+    if (entradas != NULL) {
+        acumulador->entradas = entradas;
+    }
+    if (tabela == NULL || entradas == NULL) {
+        free(tabela);
+        return 0;
+    }
+    for (int i = 0; i < nova_capacidade; i++) {
+        tabela[i] = -1;
+    }
+    for (int e = 0; e < acumulador->quantidade_tocados; e++) {
+        int i = espalhar_handle(entradas[e].handle, nova_capacidade);
+        while (tabela[i] >= 0) {
+            i = (i + 1) & (nova_capacidade - 1);
+        }
+        tabela[i] = e;
+    }
+    free(acumulador->tabela);
+    acumulador->tabela = tabela;
+    acumulador->capacidade = nova_capacidade;
+    return 1;
+}
+
+/**
+ * @brief Localiza o acumulador do handle, criando-o (zerado) se ainda não existir.
+ * @return EntradaDifusa* A entrada, ou NULL se a tabela precisou crescer e a alocação falhou.
+ */
+static EntradaDifusa* entrada_acumulador_difuso(AcumuladorDifuso* acumulador, int handle) {
+    int i = espalhar_handle(handle, acumulador->capacidade);
+    while (acumulador->tabela[i] >= 0) {
+        EntradaDifusa* entrada = &acumulador->entradas[acumulador->tabela[i]];
+        if (entrada->handle == handle) {
+            return entrada;
+        }
+        i = (i + 1) & (acumulador->capacidade - 1);
+    }
+    // Mantém a tabela no máximo meio cheia
+    if (acumulador->quantidade_tocados == acumulador->capacidade / 2) {
+        if (!crescer_acumulador_difuso(acumulador)) {
+            return NULL;
+        }
+        i = espalhar_handle(handle, acumulador->capacidade);
+        while (acumulador->tabela[i] >= 0) {
+            i = (i + 1) & (acumulador->capacidade - 1);
+        }
+    }
+    acumulador->tabela[i] = acumulador->quantidade_tocados;
+    EntradaDifusa* entrada = &acumulador->entradas[acumulador->quantidade_tocados++];
+    entrada->handle = handle;
+    entrada->termos = 0;
+    entrada->distancia = 0;
+    entrada->melhor = 0;
+    entrada->ultimo_termo = -1;
+    return entrada;
+}
+
+/**
+ * @brief VisitanteTermo da busca difusa: acumula, para cada registro que contém o
+ * termo encontrado, a melhor distância da palavra atual da busca.
+ */
+static void acumular_termo_difuso(const int* handles, int quantidade, int distancia, void* contexto) {
+    AcumuladorDifuso* acumulador = (AcumuladorDifuso*)contexto;
+    for (int i = 0; i < quantidade && !acumulador->falhou; i++) {
+        EntradaDifusa* entrada = entrada_acumulador_difuso(acumulador, handles[i]);
+        if (entrada == NULL) {
+            acumulador->falhou = 1;
+        } else if (entrada->ultimo_termo != acumulador->termo_atual) {
+            entrada->ultimo_termo = acumulador->termo_atual;
+            entrada->termos++;
+            entrada->melhor = distancia;
+            entrada->distancia += distancia;
+        } else if (distancia < entrada->melhor) {
+            entrada->distancia -= entrada->melhor - distancia;
+            entrada->melhor = distancia;
+        }
+    }
+}
+
+/**
+ * @brief Resultado difuso com a posição do registro, para o desempate na ordenação.
+ */
+typedef struct {
+    ResultadoDifuso resultado;
+    int posicao;
+} CandidatoDifuso;
+
+/**
+ * @brief Função de comparação para qsort dos candidatos difusos: mais palavras
+ * aproximadas primeiro, depois menor distância total, depois a ordem da coleção.
+ */
+static int comparar_candidatos_difusos(const void* a, const void* b) {
+    const CandidatoDifuso* x = (const CandidatoDifuso*)a;
+    const CandidatoDifuso* y = (const CandidatoDifuso*)b;
+    if (x->resultado.termos != y->resultado.termos) {
+        return y->resultado.termos - x->resultado.termos;
+    }
+    if (x->resultado.distancia != y->resultado.distancia) {
+        return x->resultado.distancia - y->resultado.distancia;
+    }
+    return x->posicao - y->posicao;
+}
+
+/**
+ * @brief Tolerância usada para uma palavra da busca: palavras curtas admitem menos
+ * erros, para que "de" não aproxime todas as palavras de duas letras.
  */
-static int comparar_livros_qsort_por_titulo(const void* a, const void* b) {
-    const Livro* livro_a = (const Livro*)a;
-    const Livro* livro_b = (const Livro*)b;
-    return strcmp(livro_a->titulo, livro_b->titulo);
+static int tolerancia_do_termo(size_t tamanho, int distancia_maxima) {
+    int tolerancia = tamanho <= 2 ? 0 : (tamanho <= 5 ? 1 : 2);
+    return tolerancia < distancia_maxima ? tolerancia : distancia_maxima;
+}
+
+int pesquisar_titulos_aproximados(const ColecaoLivros* colecao, const char* titulo_busca, int distancia_maxima,
+                                  ResultadoDifuso* resultados, int maximo) {
+    if (colecao == NULL || titulo_busca == NULL || resultados == NULL || maximo <= 0 ||
+        colecao->indice_difuso == NULL || colecao->armazem.quantidade == 0) {
+        return 0;
+    }
+
+    char termo_dobrado[TAM_TITULO];
+    dobrar_texto(titulo_busca, termo_dobrado, sizeof(termo_dobrado));
+
+    AcumuladorDifuso acumulador;
+    acumulador.capacidade = CAPACIDADE_INICIAL_ACUMULADOR;
+    acumulador.tabela = (int*) malloc((size_t)acumulador.capacidade * sizeof(int));
+    acumulador.entradas = (EntradaDifusa*) malloc((size_t)(acumulador.capacidade / 2) * sizeof(EntradaDifusa));
+    acumulador.quantidade_tocados = 0;
+    acumulador.falhou = 0;
+    int encontrados = 0;
+    CandidatoDifuso* candidatos = NULL;
+    if (acumulador.tabela == NULL || acumulador.entradas == NULL) {
+        perror("ERRO (pesquisar_titulos_aproximados): Falha ao alocar acumuladores");
+        goto liberar;
+    }
+    for (int i = 0; i < acumulador.capacidade; i++) {
+        acumulador.tabela[i] = -1;
+    }
+
+    // Cada palavra da busca consulta a BK-tree; só os registros dos termos próximos são tocados.
+    char termo[TAM_TERMO];
+    const char* cursor = termo_dobrado;
+    size_t tamanho;
+    for (acumulador.termo_atual = 0;
+         acumulador.termo_atual < MAX_TERMOS_DIFUSOS && (tamanho = proximo_termo(&cursor, termo, sizeof(termo))) > 0;
+         acumulador.termo_atual++) {
+        if (!buscar_termos_proximos(colecao->indice_difuso, termo, tolerancia_do_termo(tamanho, distancia_maxima),
+                                    acumular_termo_difuso, &acumulador)) {
+            goto liberar;
+        }
+        if (acumulador.falhou) {
+            perror("ERRO (pesquisar_titulos_aproximados): Falha ao alocar acumuladores");
+            goto liberar;
+        }
+    }
+    if (acumulador.quantidade_tocados == 0) {
+        goto liberar;
+    }
+
+    candidatos = (CandidatoDifuso*) malloc((size_t)acumulador.quantidade_tocados * sizeof(CandidatoDifuso));
+    if (candidatos == NULL) {
+        perror("ERRO (pesquisar_titulos_aproximados): Falha ao alocar candidatos");
+        goto liberar;
+    }
+    for (int i = 0; i < acumulador.quantidade_tocados; i++) {
+        const EntradaDifusa* entrada = &acumulador.entradas[i];
+        candidatos[i].resultado.handle = entrada->handle;
+        candidatos[i].resultado.termos = entrada->termos;
+        candidatos[i].resultado.distancia = entrada->distancia;
+        candidatos[i].posicao = posicao_do_handle(&colecao->armazem, entrada->handle);
+    }
+    qsort(candidatos, (size_t)acumulador.quantidade_tocados, sizeof(CandidatoDifuso), comparar_candidatos_difusos);
+
+    encontrados = acumulador.quantidade_tocados < maximo ? acumulador.quantidade_tocados : maximo;
+    for (int i = 0; i < encontrados; i++) {
+        resultados[i] = candidatos[i].resultado;
+    }
+
+liberar:
+    free(candidatos);
+    free(acumulador.entradas);
+    free(acumulador.tabela);
+    return encontrados;
+}
+
+int pesquisar_por_relevancia(const ColecaoLivros* colecao, const char* texto, ResultadoRelevancia* resultados, int maximo) {
+    if (colecao == NULL || colecao->indice_relevancia == NULL || texto == NULL) {
+        return 0;
+    }
+    char dobrado[TAM_BUSCA_RELEVANCIA];
+    dobrar_texto(texto, dobrado, sizeof(dobrado));
+
+    // A chave inclui o número de resultados pedidos (os K melhores dependem de K).
+    const void* guardados;
+    size_t tamanho;
+    if (colecao->cache_consultas != NULL && maximo > 0 &&
+        buscar_cache_consultas(colecao->cache_consultas, colecao->geracao, CACHE_RELEVANCIA, maximo, dobrado,
+                               &guardados, &tamanho)) {
+        if (tamanho > 0) {
+            memcpy(resultados, guardados, tamanho);
+        }
+        return (int)(tamanho / sizeof(ResultadoRelevancia));
+    }
+    int quantidade = buscar_relevancia(colecao->indice_relevancia, dobrado, resultados, maximo);
+    if (colecao->cache_consultas != NULL && maximo > 0) {
+        guardar_cache_consultas(colecao->cache_consultas, colecao->geracao, CACHE_RELEVANCIA, maximo, dobrado,
+                                resultados, (size_t)quantidade * sizeof(ResultadoRelevancia));
+    }
+    return quantidade;
 }
 
 /**
- * @brief Função de comparação para qsort, para ordenar Livros por ano de publicação (crescente).
- * Espera que 'a' e 'b' sejam ponteiros para structs Livro.
+ * @brief Livro candidato na seleção dos primeiros livros: a chave do critério e a
+ * posição na coleção (desempate e identificação).
+ */
+typedef struct {
+    const char* texto;    ///< Chave textual (título ou autor), nos critérios textuais.
+    int chave;            ///< Ano de publicação, nos critérios por ano.
+    int posicao;          ///< Posição do registro no vetor denso.
+} CandidatoSelecao;
+
+/**
+ * @brief Compara dois candidatos segundo o critério, desempatando pela posição.
+ * @return int <0 se 'a' vem antes de 'b', >0 se vem depois (nunca 0 para posições distintas).
+ */
+static int comparar_candidatos_selecao(const CandidatoSelecao* a, const CandidatoSelecao* b, CriterioOrdenacao criterio) {
+    int resultado;
+    if (criterio == CRITERIO_TITULO || criterio == CRITERIO_AUTOR) {
+        resultado = a->texto == b->texto ? 0 : strcmp(a->texto, b->texto); // Autores internados: mesmo ponteiro
+    } else {
+        resultado = (a->chave > b->chave) - (a->chave < b->chave);
+        if (criterio == CRITERIO_ANO_DECRESCENTE) {
+            resultado = -resultado;
+        }
+    }
+    return resultado != 0 ? resultado : (a->posicao > b->posicao) - (a->posicao < b->posicao);
+}
+
+/**
+ * @brief Desce o elemento `i` do heap de máximo (o candidato que vem por último no
+ * topo) até restaurar a propriedade de heap.
+ */
+static void descer_heap_selecao(CandidatoSelecao* heap, int quantidade, int i, CriterioOrdenacao criterio) {
+    CandidatoSelecao elemento = heap[i];
+    for (;;) {
+        int filho = 2 * i + 1;
+        if (filho >= quantidade) {
+            break;
+        }
+        if (filho + 1 < quantidade && comparar_candidatos_selecao(&heap[filho + 1], &heap[filho], criterio) > 0) {
+            filho++;
+        }
+        if (comparar_candidatos_selecao(&heap[filho], &elemento, criterio) <= 0) {
+            break;
+        }
+        heap[i] = heap[filho];
+        i = filho;
+    }
+    heap[i] = elemento;
+}
+
+/**
+ * @brief Sobe o elemento `i` do heap de máximo até restaurar a propriedade de heap.
+ */
+static void subir_heap_selecao(CandidatoSelecao* heap, int i, CriterioOrdenacao criterio) {
+    CandidatoSelecao elemento = heap[i];
+    while (i > 0) {
+        int pai = (i - 1) / 2;
+        if (comparar_candidatos_selecao(&heap[pai], &elemento, criterio) >= 0) {
+            break;
+        }
+        heap[i] = heap[pai];
+        i = pai;
+    }
+    heap[i] = elemento;
+}
+
+int selecionar_primeiros_livros(const ColecaoLivros* colecao, CriterioOrdenacao criterio, int k, int* handles) {
+    if (colecao == NULL || handles == NULL || k <= 0) {
+        return 0;
+    }
+    const ArmazemLivros* armazem = &colecao->armazem;
+    if (k > armazem->quantidade) {
+        k = armazem->quantidade;
+    }
+    if (k == 0) {
+        return 0;
+    }
+
+    CandidatoSelecao* heap = (CandidatoSelecao*) malloc((size_t)k * sizeof(CandidatoSelecao));
+    if (heap == NULL) {
+        perror("ERRO (selecionar_primeiros_livros): Falha ao alocar heap");
+        return 0;
+    }
+
+    // O heap guarda os k melhores vistos até agora, com o pior deles no topo: um
+    // candidato só entra se vier antes do topo (a maioria é descartada com 1 comparação).
+    int quantidade = 0;
+    for (int i = 0; i < armazem->quantidade; i++) {
+        const RegistroLivro* registro = &armazem->registros[i];
+        CandidatoSelecao candidato;
+        candidato.texto = criterio == CRITERIO_TITULO ? titulo_registro(armazem, registro)
+                        : criterio == CRITERIO_AUTOR  ? autor_registro(armazem, registro)
+                                                      : NULL;
+        candidato.chave = registro->anoPublicacao;
+        candidato.posicao = i;
+        if (quantidade < k) {
+            heap[quantidade] = candidato;
+            subir_heap_selecao(heap, quantidade++, criterio);
+        } else if (comparar_candidatos_selecao(&candidato, &heap[0], criterio) < 0) {
+            heap[0] = candidato;
+            descer_heap_selecao(heap, k, 0, criterio);
+        }
+    }
+
+    // Esvazia o heap de trás para frente: o topo é sempre o último dos restantes.
+    for (int restantes = quantidade; restantes > 0; restantes--) {
+        handles[restantes - 1] = armazem->handle_de_posicao[heap[0].posicao];
+        heap[0] = heap[restantes - 1];
+        descer_heap_selecao(heap, restantes - 1, 0, criterio);
+    }
+    free(heap);
+    return quantidade;
+}
+
+/**
+ * @brief Referência a um texto durante a ordenação: o texto, os próximos caracteres
+ * dele e a posição original. O vetor temporário guarda apenas isso (16 bytes), não
+ * cópias dos registros.
+ */
+typedef struct {
+    const char* texto;      ///< Chave textual (ex: título na arena).
+    unsigned int prefixo;   ///< Os 4 caracteres do texto a partir da profundidade atual (ver `prefixo_texto`).
+    int posicao;            ///< Posição original (no vetor denso, ou ID no dicionário); desempata textos iguais.
+} ReferenciaLivro;
+
+/**
+ * @brief Função de comparação para qsort, para ordenar referências pela posição original
+ * (crescente). Usada para manter estáveis os grupos de textos iguais.
+ * Espera que 'a' e 'b' sejam ponteiros para ReferenciaLivro.
  *
- * @param a Ponteiro void para o primeiro Livro.
- * @param b Ponteiro void para o segundo Livro.
- * @return int <0 se o ano de 'a' é menor que 'b', 0 se são iguais, >0 se o ano de 'a' é maior que 'b'.
+ * @param a Ponteiro void para a primeira ReferenciaLivro.
+ * @param b Ponteiro void para a segunda ReferenciaLivro.
+ * @return int <0 se a posição de 'a' é menor que a de 'b', 0 se são iguais, >0 se é maior.
  */
-static int comparar_livros_qsort_por_ano(const void* a, const void* b) {
-    const Livro* livro_a = (const Livro*)a;
-    const Livro* livro_b = (const Livro*)b;
+static int comparar_referencias_qsort_por_posicao(const void* a, const void* b) {
+    int posicao_a = ((const ReferenciaLivro*)a)->posicao;
+    int posicao_b = ((const ReferenciaLivro*)b)->posicao;
 
-    if (livro_a->anoPublicacao < livro_b->anoPublicacao) return -1;
-    if (livro_a->anoPublicacao > livro_b->anoPublicacao) return 1;
+    if (posicao_a < posicao_b) return -1;
+    if (posicao_a > posicao_b) return 1;
     return 0;
 }
 
+/** @brief Abaixo deste tamanho, a ordenação por texto termina por inserção. */
+#define LIMITE_INSERCAO_TEXTOS 16
+
+/** @brief Maior faixa de anos (último - primeiro + 1) ordenada com a tabela direta de anos. */
+#define LIMITE_TABELA_ANOS 65536
+
+/**
+ * @brief Empacota os 4 primeiros caracteres de um texto em um inteiro, o primeiro no
+ * byte mais significativo, com zeros depois do fim do texto. Comparar dois prefixos
+ * como inteiros equivale a comparar os 4 caracteres como `strcmp`.
+ */
+static unsigned int prefixo_texto(const char* texto) {
+    unsigned int prefixo = 0;
+    for (int i = 0; i < 4; i++) {
+        unsigned char c = (unsigned char) texto[i];
+        prefixo = (prefixo << 8) | c;
+        if (c == '\0') {
+            return prefixo << (8 * (3 - i));
+        }
+    }
+    return prefixo;
+}
+
+static void trocar_referencias(ReferenciaLivro* a, ReferenciaLivro* b) {
+    ReferenciaLivro temporaria = *a;
+    *a = *b;
+    *b = temporaria;
+}
+
 /**
- * @brief Função de comparação para qsort, para ordenar Livros por autor (alfabética, case-sensitive).
- * Espera que 'a' e 'b' sejam ponteiros para structs Livro.
+ * @brief Compara duas referências cujos textos são iguais até `profundidade` e cujos
+ * prefixos foram carregados nessa profundidade. Textos iguais comparam pela posição.
+ */
+static int comparar_referencias_texto(const ReferenciaLivro* a, const ReferenciaLivro* b, int profundidade) {
+    if (a->prefixo != b->prefixo) {
+        return a->prefixo < b->prefixo ? -1 : 1;
+    }
+    if ((a->prefixo & 0xFFu) != 0) { // Os dois textos continuam depois do prefixo
+        int comparacao = strcmp(a->texto + profundidade + 4, b->texto + profundidade + 4);
+        if (comparacao != 0) {
+            return comparacao;
+        }
+    }
+    return (a->posicao > b->posicao) - (a->posicao < b->posicao);
+}
+
+/**
+ * @brief Ordena por inserção um grupo pequeno de referências (ver `comparar_referencias_texto`).
+ */
+static void ordenar_textos_por_insercao(ReferenciaLivro* referencias, int quantidade, int profundidade) {
+    for (int i = 1; i < quantidade; i++) {
+        ReferenciaLivro atual = referencias[i];
+        int j = i;
+        while (j > 0 && comparar_referencias_texto(&referencias[j - 1], &atual, profundidade) > 0) {
+            referencias[j] = referencias[j - 1];
+            j--;
+        }
+        referencias[j] = atual;
+    }
+}
+
+/**
+ * @brief Ordena referências pelo texto com o quicksort multichave (quicksort de três
+ * vias sobre os caracteres), de forma estável.
  *
- * @param a Ponteiro void para o primeiro Livro.
- * @param b Ponteiro void para o segundo Livro.
- * @return int <0 se o autor de 'a' vem antes de 'b', 0 se são iguais, >0 se 'a' vem depois de 'b'.
+ * Todas as referências recebidas têm textos iguais até `profundidade`, e `prefixo`
+ * guarda os 4 caracteres seguintes de cada uma. Elas são divididas pelo prefixo em
+ * menores, iguais e maiores que o pivô; só o grupo dos iguais avança 4 caracteres
+ * (recarregando os prefixos), então cada prefixo comum é lido uma única vez em vez de
+ * repetido em cada `strcmp`. Como as partições só leem o vetor de referências, em
+ * sequência, os textos espalhados na arena são visitados uma vez por nível, e não a
+ * cada comparação. Grupos de textos inteiramente iguais ficam em ordem de posição.
+ * Dos três grupos, só os dois menores são ordenados por recursão e o maior continua no
+ * laço; como cada um deles tem no máximo metade das referências, a pilha de chamadas
+ * fica limitada a log2(quantidade) níveis, mesmo com pivôs ruins.
+ *
+ * @param referencias Vetor de referências com `texto`, `prefixo` e `posicao` preenchidos.
+ * @param quantidade Número de referências.
+ * @param profundidade Comprimento do prefixo já igual em todas as referências.
  */
-static int comparar_livros_qsort_por_autor(const void* a, const void* b) {
-    const Livro* livro_a = (const Livro*)a;
-    const Livro* livro_b = (const Livro*)b;
-    return strcmp(livro_a->autor, livro_b->autor);
+static void ordenar_referencias_multichave(ReferenciaLivro* referencias, int quantidade, int profundidade) {
+    while (quantidade > LIMITE_INSERCAO_TEXTOS) {
+        // Pivô: mediana do primeiro, do meio e do último (bom para entradas já ordenadas)
+        unsigned int a = referencias[0].prefixo;
+        unsigned int b = referencias[quantidade / 2].prefixo;
+        unsigned int c = referencias[quantidade - 1].prefixo;
+        unsigned int pivo = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+
+        // Partição em três vias: [0, menores) < pivô, [menores, maiores] = pivô, (maiores, fim) > pivô
+        int menores = 0;
+        int i = 0;
+        int maiores = quantidade - 1;
+        while (i <= maiores) {
+            unsigned int atual = referencias[i].prefixo;
+            if (atual < pivo) {
+                trocar_referencias(&referencias[menores++], &referencias[i++]);
+            } else if (atual > pivo) {
+                trocar_referencias(&referencias[i], &referencias[maiores--]);
+            } else {
+                i++;
+            }
+        }
+
+        // Grupos: menores e maiores seguem na mesma profundidade; os iguais, 4 caracteres adiante
+        ReferenciaLivro* inicio[3] = { referencias, referencias + menores, referencias + maiores + 1 };
+        int tamanho[3] = { menores, maiores - menores + 1, quantidade - maiores - 1 };
+        int avanco[3] = { 0, 4, 0 };
+        if ((pivo & 0xFFu) == 0) {
+            // Textos inteiramente iguais: restaura a ordem original entre eles
+            qsort(inicio[1], (size_t)tamanho[1], sizeof(ReferenciaLivro), comparar_referencias_qsort_por_posicao);
+            tamanho[1] = 0;
+        } else {
+            for (int j = 0; j < tamanho[1]; j++) {
+                inicio[1][j].prefixo = prefixo_texto(inicio[1][j].texto + profundidade + 4);
+            }
+        }
+
+        // Recursão nos dois grupos menores; o maior continua no laço
+        int maior = tamanho[0] >= tamanho[1] ? (tamanho[0] >= tamanho[2] ? 0 : 2) : (tamanho[1] >= tamanho[2] ? 1 : 2);
+        for (int g = 0; g < 3; g++) {
+            if (g != maior) {
+                ordenar_referencias_multichave(inicio[g], tamanho[g], profundidade + avanco[g]);
+            }
+        }
+        referencias = inicio[maior];
+        quantidade = tamanho[maior];
+        profundidade += avanco[maior];
+    }
+    ordenar_textos_por_insercao(referencias, quantidade, profundidade);
 }
 
+/**
+ * @brief Função de comparação para qsort com a mesma ordem do quicksort multichave:
+ * texto (case-sensitive) e, entre textos iguais, posição original. Usada nas
+ * intercalações da ordenação paralela.
+ */
+static int comparar_referencias_qsort_por_texto(const void* a, const void* b) {
+    const ReferenciaLivro* referencia_a = (const ReferenciaLivro*) a;
+    const ReferenciaLivro* referencia_b = (const ReferenciaLivro*) b;
+    int comparacao = strcmp(referencia_a->texto, referencia_b->texto);
+    if (comparacao != 0) {
+        return comparacao;
+    }
+    return comparar_referencias_qsort_por_posicao(a, b);
+}
 
 /**
- * @brief Ordena os dados dos livros na coleção por título (ordem alfabética, case-sensitive).
- * A função modifica a ordem dos dados Livro DENTRO dos nós existentes da lista encadeada.
- * A estrutura da lista (os nós e seus ponteiros 'proximo') não é alterada, apenas o conteúdo 'dadosLivro'.
+ * @brief Ordena sequencialmente um trecho de referências pelo texto (ver
+ * `ordenar_referencias_multichave`). No formato de OrdenadorTrecho.
+ */
+static void ordenar_trecho_referencias(void* inicio, size_t quantidade) {
+    ReferenciaLivro* referencias = (ReferenciaLivro*) inicio;
+    for (size_t i = 0; i < quantidade; i++) {
+        referencias[i].prefixo = prefixo_texto(referencias[i].texto);
+    }
+    ordenar_referencias_multichave(referencias, (int) quantidade, 0);
+}
+
+/**
+ * @brief Ordena as referências pelo texto, em paralelo se o vetor for grande (ver
+ * ordenacao_paralela.h). Os campos `texto` e `posicao` devem estar preenchidos.
+ * Como a ordem é total (a posição desempata), o resultado é o mesmo nos dois caminhos.
+ */
+static void ordenar_referencias_por_texto(ReferenciaLivro* referencias, int quantidade) {
+    ordenar_em_paralelo(referencias, (size_t) quantidade, sizeof(ReferenciaLivro),
+                        ordenar_trecho_referencias, comparar_referencias_qsort_por_texto);
+}
+
+/**
+ * @brief Reorganiza o armazenamento da coleção na ordem das referências já ordenadas
+ * e libera as referências. Os handles continuam identificando os mesmos livros.
+ * As referências (16 bytes por livro) são liberadas assim que a ordem dos handles é
+ * extraída, antes da permutação dos registros, que aloca apenas mais um int por livro.
  *
- * @param colecao Ponteiro para a ColecaoLivros a ser ordenada.
+ * @param colecao Ponteiro para a ColecaoLivros a ser reorganizada.
+ * @param referencias Vetor com uma referência por livro (posição no vetor denso), na
+ * nova ordem. É liberado aqui.
+ * @param nome_funcao Nome da função pública chamadora, usado nas mensagens de erro.
+ * @return int 1 em caso de sucesso, 0 se alguma alocação falhar (a ordem não muda).
  */
-void ordenar_colecao_por_titulo(ColecaoLivros* colecao) {
-    if (colecao == NULL || colecao->quantidade < 2) {
-        return; // Nada a ordenar ou coleção inválida
+static int aplicar_ordenacao(ColecaoLivros* colecao, ReferenciaLivro* referencias,
+                             const char* nome_funcao) {
+    int quantidade = colecao->armazem.quantidade;
+
+    int* ordem_handles = (int*) malloc((size_t)quantidade * sizeof(int));
+    if (ordem_handles == NULL) {
+        fprintf(stderr, "ERRO (%s): Falha ao alocar vetor temporario.\n", nome_funcao);
+        free(referencias);
+        return 0;
     }
 
-    // 1. Alocar um array temporário para armazenar as structs Livro
-    Livro* array_de_livros = (Livro*) malloc(colecao->quantidade * sizeof(Livro));
-    if (array_de_livros == NULL) {
-        perror("ERRO (ordenar_colecao_por_titulo): Falha ao alocar array temporario");
-        return;
+    for (int i = 0; i < quantidade; i++) {
+        ordem_handles[i] = colecao->armazem.handle_de_posicao[referencias[i].posicao];
+    }
+    free(referencias);
+    colecao->geracao++; // As posições mudam: resultados guardados deixam de valer
+    int sucesso = reordenar_armazem(&colecao->armazem, ordem_handles);
+    if (!sucesso) {
+        fprintf(stderr, "ERRO (%s): Falha ao reorganizar a colecao.\n", nome_funcao);
     }
 
-    // 2. Copiar os dados dos livros da lista para o array
-    NoLista* atual = colecao->inicio;
-    for (int i = 0; i < colecao->quantidade; i++) {
-        if (atual == NULL) { // Verificação de segurança, não deveria acontecer se colecao->quantidade está correto
-            fprintf(stderr, "ERRO (ordenar_colecao_por_titulo): Inconsistencia na quantidade de livros.\n");
-            free(array_de_livros);
-            return;
-        }
-        array_de_livros[i] = atual->dadosLivro; // Copia a struct
-        atual = atual->proximo;
+    free(ordem_handles);
+    return sucesso;
+}
+
+/**
+ * @brief Registra que todo o armazenamento está na ordem `tipo` (ver `ordem_atual`).
+ * Uma ordem de título, autor ou ano passa a ser mantida pela visão correspondente,
+ * e as visões são ativadas se ainda não estiverem (sem elas, a próxima alteração fora
+ * de ordem apenas faz a próxima ordenação ser completa).
+ */
+static void registrar_ordem(ColecaoLivros* colecao, int tipo) {
+    colecao->ordem_atual = tipo;
+    colecao->armazem_em_ordem = tipo != ORDEM_INDEFINIDA;
+    if (tipo != ORDEM_INDEFINIDA) {
+        ativar_visoes_ordenadas(colecao);
+    }
+}
+
+/**
+ * @brief Aproveita a ordem que a coleção já tem, quando é a pedida. Se o armazenamento
+ * ainda estiver nessa ordem, não há nada a fazer. Senão, a visão da ordem (mantida a
+ * cada inserção e remoção) já tem os livros ordenados: basta copiá-la, em O(N), e
+ * reordenar pela posição atual cada grupo de livros de mesma chave (a visão os deixa
+ * em ordem de handle), para que o resultado seja o mesmo da ordenação estável completa.
+ *
+ * @param colecao Ponteiro para a ColecaoLivros (não nulo).
+ * @param tipo Ordem pedida.
+ * @param nome_funcao Nome da função pública chamadora, usado nas mensagens de erro.
+ * @return int 1 se a coleção ficou na ordem pedida, 0 se é preciso ordená-la inteira.
+ */
+static int aproveitar_ordem_atual(ColecaoLivros* colecao, TipoVisao tipo, const char* nome_funcao) {
+    if (colecao->ordem_atual != (int) tipo) {
+        return 0;
+    }
+    if (colecao->armazem_em_ordem) {
+        return 1; // Já está na ordem pedida
+    }
+    if (colecao->visoes == NULL) {
+        return 0;
     }
 
-    // 3. Ordenar o array de structs Livro usando qsort
-    qsort(array_de_livros, colecao->quantidade, sizeof(Livro), comparar_livros_qsort_por_titulo);
+    ArmazemLivros* armazem = &colecao->armazem;
+    int quantidade = armazem->quantidade;
+    ReferenciaLivro* referencias = (ReferenciaLivro*) malloc((size_t)quantidade * sizeof(ReferenciaLivro));
+    int* ordem_handles = (int*) malloc((size_t)quantidade * sizeof(int));
+    if (referencias == NULL || ordem_handles == NULL) {
+        fprintf(stderr, "ERRO (%s): Falha ao alocar vetores temporarios.\n", nome_funcao);
+        free(referencias);
+        free(ordem_handles);
+        return 0;
+    }
 
-    // 4. Copiar os dados ordenados de volta para os nós da lista original
-    atual = colecao->inicio;
-    for (int i = 0; i < colecao->quantidade; i++) {
-         if (atual == NULL) { // Verificação de segurança
-            fprintf(stderr, "ERRO (ordenar_colecao_por_titulo): Inconsistencia ao copiar dados de volta.\n");
-            break; 
+    // 1. Copiar a ordem da visão, desempatando os livros de mesma chave pela posição
+    const VisaoOrdenada* visao = &colecao->visoes[tipo];
+    int k = 0;
+    for (int b = 0; b < visao->quantidade_blocos; b++) {
+        for (int i = 0; i < visao->blocos[b]->quantidade; i++) {
+            referencias[k++].posicao = posicao_do_handle(armazem, visao->blocos[b]->handles[i]);
         }
-        atual->dadosLivro = array_de_livros[i]; // Copia a struct ordenada
-        atual = atual->proximo;
     }
+    for (int inicio = 0; inicio < quantidade;) {
+        int fim = inicio + 1;
+        while (fim < quantidade &&
+               comparar_chaves_visao(tipo, armazem, &armazem->registros[referencias[inicio].posicao],
+                                     &armazem->registros[referencias[fim].posicao]) == 0) {
+            fim++;
+        }
+        if (fim - inicio > 1) {
+            qsort(&referencias[inicio], (size_t)(fim - inicio), sizeof(ReferenciaLivro),
+                  comparar_referencias_qsort_por_posicao);
+        }
+        inicio = fim;
+    }
+    for (int i = 0; i < quantidade; i++) {
+        ordem_handles[i] = armazem->handle_de_posicao[referencias[i].posicao];
+    }
+    free(referencias);
 
-    // 5. Liberar a memória do array temporário
-    free(array_de_livros);
-
-    // printf("INFO: Colecao ordenada por titulo.\n"); // Opcional: feedback
+    // 2. Reorganizar o armazenamento nessa ordem
+    colecao->geracao++; // As posições mudam: resultados guardados deixam de valer
+    int sucesso = reordenar_armazem(armazem, ordem_handles);
+    free(ordem_handles);
+    if (!sucesso) {
+        fprintf(stderr, "ERRO (%s): Falha ao reorganizar a colecao.\n", nome_funcao);
+        return 0;
+    }
+    registrar_ordem(colecao, tipo);
+    return 1;
 }
 
 /**
- * @brief Ordena os dados dos livros na coleção por ano de publicação (ordem crescente).
- * A função modifica a ordem dos dados Livro DENTRO dos nós existentes da lista encadeada.
+ * @brief Ordena os livros da coleção por título (ordem alfabética, case-sensitive).
+ * A função reorganiza o vetor denso do armazenamento; os handles dos livros não mudam.
  *
  * @param colecao Ponteiro para a ColecaoLivros a ser ordenada.
  */
-void ordenar_colecao_por_ano(ColecaoLivros* colecao) {
-    if (colecao == NULL || colecao->quantidade < 2) {
+void ordenar_colecao_por_titulo(ColecaoLivros* colecao) {
+    if (colecao == NULL || colecao->armazem.quantidade < 2) {
         return; // Nada a ordenar ou coleção inválida
     }
+    if (aproveitar_ordem_atual(colecao, VISAO_TITULO, "ordenar_colecao_por_titulo")) {
+        return;
+    }
 
-    // 1. Alocar array temporário
-    Livro* array_de_livros = (Livro*) malloc(colecao->quantidade * sizeof(Livro));
-    if (array_de_livros == NULL) {
-        perror("ERRO (ordenar_colecao_por_ano): Falha ao alocar array temporario");
+    const ArmazemLivros* armazem = &colecao->armazem;
+    ReferenciaLivro* referencias = (ReferenciaLivro*) malloc((size_t)armazem->quantidade * sizeof(ReferenciaLivro));
+    if (referencias == NULL) {
+        fprintf(stderr, "ERRO (ordenar_colecao_por_titulo): Falha ao alocar vetor temporario.\n");
         return;
     }
 
-    // 2. Copiar da lista para o array
-    NoLista* atual = colecao->inicio;
-    for (int i = 0; i < colecao->quantidade; i++) {
-        if (atual == NULL) {
-            fprintf(stderr, "ERRO (ordenar_colecao_por_ano): Inconsistencia na quantidade de livros.\n");
-            free(array_de_livros);
-            return;
-        }
-        array_de_livros[i] = atual->dadosLivro;
-        atual = atual->proximo;
+    // A chave é o ponteiro para o título na arena (nenhum texto é copiado)
+    for (int i = 0; i < armazem->quantidade; i++) {
+        referencias[i].texto = titulo_registro(armazem, &armazem->registros[i]);
+        referencias[i].posicao = i;
     }
 
-    // 3. Ordenar o array
-    qsort(array_de_livros, colecao->quantidade, sizeof(Livro), comparar_livros_qsort_por_ano);
+    ordenar_referencias_por_texto(referencias, armazem->quantidade);
+    if (aplicar_ordenacao(colecao, referencias, "ordenar_colecao_por_titulo")) {
+        registrar_ordem(colecao, VISAO_TITULO);
+    }
+}
 
-    // 4. Copiar de volta para a lista
-    atual = colecao->inicio;
-    for (int i = 0; i < colecao->quantidade; i++) {
-        if (atual == NULL) {
-            fprintf(stderr, "ERRO (ordenar_colecao_por_ano): Inconsistencia ao copiar dados de volta.\n");
-            break;
-        }
-        atual->dadosLivro = array_de_livros[i];
-        atual = atual->proximo;
+/**
+ * @brief Ordena os livros da coleção por ano de publicação (ordem crescente).
+ * A função reorganiza o vetor denso do armazenamento; os handles dos livros não mudam.
+ *
+ * @param colecao Ponteiro para a ColecaoLivros a ser ordenada.
+ */
+void ordenar_colecao_por_ano(ColecaoLivros* colecao) {
+    if (colecao == NULL || colecao->armazem.quantidade < 2) {
+        return; // Nada a ordenar ou coleção inválida
+    }
+    if (aproveitar_ordem_atual(colecao, VISAO_ANO, "ordenar_colecao_por_ano")) {
+        return;
     }
 
-    // 5. Liberar array
-    free(array_de_livros);
+    // Ordenação por contagem sobre os baldes do índice de anos: o tamanho de cada
+    // balde já é a contagem do ano, então basta calcular onde cada ano começa e
+    // distribuir os livros na ordem atual (estável), sem comparações entre livros.
+    // Com a faixa de anos pequena (o caso comum), o início de cada ano fica em uma
+    // tabela indexada por (ano - primeiro ano) e cada livro custa um único acesso;
+    // senão, o balde de cada livro é encontrado por busca binária.
+    const ArmazemLivros* armazem = &colecao->armazem;
+    const IndiceAnos* indice = &colecao->indice_anos;
+    int quantidade = armazem->quantidade;
+    int ano_inicial = indice->baldes[0].ano;
+    long long faixa = (long long)indice->baldes[indice->quantidade_baldes - 1].ano - ano_inicial + 1;
+    int tabela_direta = faixa <= LIMITE_TABELA_ANOS;
+    size_t tamanho_inicios = tabela_direta ? (size_t)faixa : (size_t)indice->quantidade_baldes;
+    int* inicio = (int*) malloc(tamanho_inicios * sizeof(int));
+    int* ordem_handles = (int*) malloc((size_t)quantidade * sizeof(int));
+    if (inicio == NULL || ordem_handles == NULL) {
+        fprintf(stderr, "ERRO (ordenar_colecao_por_ano): Falha ao alocar vetor temporario.\n");
+        free(inicio);
+        free(ordem_handles);
+        return;
+    }
 
-    // printf("INFO: Colecao ordenada por ano.\n"); // Opcional: feedback
+    int acumulado = 0;
+    for (int b = 0; b < indice->quantidade_baldes; b++) {
+        inicio[tabela_direta ? indice->baldes[b].ano - ano_inicial : b] = acumulado;
+        acumulado += indice->baldes[b].quantidade;
+    }
+    if (tabela_direta) {
+        for (int i = 0; i < quantidade; i++) {
+            ordem_handles[inicio[armazem->registros[i].anoPublicacao - ano_inicial]++] = armazem->handle_de_posicao[i];
+        }
+    } else {
+        for (int i = 0; i < quantidade; i++) {
+            int b = primeiro_balde_anos(indice, armazem->registros[i].anoPublicacao);
+            ordem_handles[inicio[b]++] = armazem->handle_de_posicao[i];
+        }
+    }
+    colecao->geracao++; // As posições mudam: resultados guardados deixam de valer
+    if (reordenar_armazem(&colecao->armazem, ordem_handles)) {
+        registrar_ordem(colecao, VISAO_ANO);
+    } else {
+        fprintf(stderr, "ERRO (ordenar_colecao_por_ano): Falha ao reorganizar a colecao.\n");
+    }
+
+    free(inicio);
+    free(ordem_handles);
 }
 
 /**
- * @brief Ordena os dados dos livros na coleção por autor (ordem alfabética, case-sensitive).
- * A função modifica a ordem dos dados Livro DENTRO dos nós existentes da lista encadeada.
+ * @brief Ordena os livros da coleção por autor (ordem alfabética, case-sensitive).
+ * Primeiro ordena apenas os autores distintos do dicionário (quicksort multichave),
+ * obtendo a posição alfabética de cada ID; depois distribui os livros por essa posição
+ * com uma ordenação por contagem (estável), sem comparar textos entre livros.
  *
  * @param colecao Ponteiro para a ColecaoLivros a ser ordenada.
  */
 void ordenar_colecao_por_autor(ColecaoLivros* colecao) {
-    if (colecao == NULL || colecao->quantidade < 2) {
+    if (colecao == NULL || colecao->armazem.quantidade < 2) {
         return; // Nada a ordenar ou coleção inválida
     }
+    if (aproveitar_ordem_atual(colecao, VISAO_AUTOR, "ordenar_colecao_por_autor")) {
+        return;
+    }
 
-    // 1. Alocar array temporário
-    Livro* array_de_livros = (Livro*) malloc(colecao->quantidade * sizeof(Livro));
-    if (array_de_livros == NULL) {
-        perror("ERRO (ordenar_colecao_por_autor): Falha ao alocar array temporario");
+    // 1. Ordenar os autores distintos (reaproveitando ReferenciaLivro: texto + ID)
+    const ArmazemLivros* armazem = &colecao->armazem;
+    const DicionarioTextos* autores = &armazem->autores;
+    ReferenciaLivro* ordem_autores = (ReferenciaLivro*) malloc((size_t)autores->quantidade * sizeof(ReferenciaLivro));
+    int* inicio_autor = (int*) calloc((size_t)autores->quantidade, sizeof(int));
+    int* ordem_handles = (int*) malloc((size_t)armazem->quantidade * sizeof(int));
+    if (ordem_autores == NULL || inicio_autor == NULL || ordem_handles == NULL) {
+        fprintf(stderr, "ERRO (ordenar_colecao_por_autor): Falha ao alocar vetores temporarios.\n");
+        free(ordem_autores);
+        free(inicio_autor);
+        free(ordem_handles);
         return;
     }
+    for (int id = 0; id < autores->quantidade; id++) {
+        ordem_autores[id].texto = texto_do_id(autores, id);
+        ordem_autores[id].posicao = id;
+    }
+    ordenar_referencias_por_texto(ordem_autores, autores->quantidade);
 
-    // 2. Copiar da lista para o array
-    NoLista* atual = colecao->inicio;
-    for (int i = 0; i < colecao->quantidade; i++) {
-        if (atual == NULL) {
-            fprintf(stderr, "ERRO (ordenar_colecao_por_autor): Inconsistencia na quantidade de livros.\n");
-            free(array_de_livros);
-            return;
+    // 2. Contar os livros de cada autor e calcular onde começa cada autor, em ordem alfabética
+    for (int i = 0; i < armazem->quantidade; i++) {
+        inicio_autor[armazem->registros[i].id_autor]++;
+    }
+    int acumulado = 0;
+    for (int i = 0; i < autores->quantidade; i++) {
+        int id = ordem_autores[i].posicao;
+        int livros_do_autor = inicio_autor[id];
+        inicio_autor[id] = acumulado;
+        acumulado += livros_do_autor;
+    }
+
+    // 3. Distribuir os livros na ordem atual (estável)
+    for (int i = 0; i < armazem->quantidade; i++) {
+        ordem_handles[inicio_autor[armazem->registros[i].id_autor]++] = armazem->handle_de_posicao[i];
+    }
+    colecao->geracao++; // As posições mudam: resultados guardados deixam de valer
+    if (reordenar_armazem(&colecao->armazem, ordem_handles)) {
+        registrar_ordem(colecao, VISAO_AUTOR);
+    } else {
+        fprintf(stderr, "ERRO (ordenar_colecao_por_autor): Falha ao reorganizar a colecao.\n");
+    }
+
+    free(ordem_autores);
+    free(inicio_autor);
+    free(ordem_handles);
+}
+
+/** @brief Tamanho da chave composta: 4 bytes por critério (8 para o ISBN) + 4 da posição. */
+#define TAM_CHAVE_COMPOSTA 32
+
+/**
+ * @brief Chave composta de um livro na ordenação por vários critérios, comparada com
+ * `memcmp`. Os bytes que sobram depois da posição ficam zerados.
+ */
+typedef struct {
+    unsigned char bytes[TAM_CHAVE_COMPOSTA];
+} ChaveComposta;
+
+/**
+ * @brief Função de comparação para qsort de chaves compostas (um único memcmp).
+ */
+static int comparar_chaves_compostas(const void* a, const void* b) {
+    return memcmp(a, b, TAM_CHAVE_COMPOSTA);
+}
+
+/**
+ * @brief Ordena sequencialmente um trecho de chaves compostas. No formato de OrdenadorTrecho.
+ * Como as chaves terminam na posição do livro, não há empates e qsort basta.
+ */
+static void ordenar_trecho_chaves(void* inicio, size_t quantidade) {
+    qsort(inicio, quantidade, sizeof(ChaveComposta), comparar_chaves_compostas);
+}
+
+/**
+ * @brief Grava `valor` em big-endian em `destino` (`bytes` bytes), invertendo os bits
+ * se `decrescente`, para que `memcmp` compare como o valor sem sinal.
+ */
+static void gravar_chave_big_endian(unsigned char* destino, unsigned long long valor, int bytes, int decrescente) {
+    if (decrescente) {
+        valor = ~valor;
+    }
+    for (int i = bytes - 1; i >= 0; i--) {
+        destino[i] = (unsigned char)(valor & 0xFFu);
+        valor >>= 8;
+    }
+}
+
+/**
+ * @brief Calcula a posição alfabética de cada texto: ordena as referências (com
+ * `texto` e `posicao` preenchidos) e grava em `classificacao[posicao]` a posição do
+ * texto na ordem, com textos iguais recebendo a mesma posição.
+ */
+static void classificar_textos(ReferenciaLivro* referencias, int quantidade, unsigned int* classificacao) {
+    ordenar_referencias_por_texto(referencias, quantidade);
+    unsigned int atual = 0;
+    for (int i = 0; i < quantidade; i++) {
+        if (i > 0 && strcmp(referencias[i - 1].texto, referencias[i].texto) != 0) {
+            atual++;
         }
-        array_de_livros[i] = atual->dadosLivro;
-        atual = atual->proximo;
+        classificacao[referencias[i].posicao] = atual;
     }
+}
 
-    // 3. Ordenar o array
-    qsort(array_de_livros, colecao->quantidade, sizeof(Livro), comparar_livros_qsort_por_autor);
+/**
+ * @brief Calcula a posição alfabética dos textos de um dicionário (por ID).
+ * @return unsigned int* Vetor com uma posição por ID (liberar com free), ou NULL se
+ * a alocação falhar.
+ */
+static unsigned int* classificar_dicionario(const DicionarioTextos* dicionario) {
+    int quantidade = dicionario->quantidade;
+    unsigned int* classificacao = (unsigned int*) malloc((size_t)(quantidade > 0 ? quantidade : 1) * sizeof(unsigned int));
+    ReferenciaLivro* referencias = (ReferenciaLivro*) malloc((size_t)(quantidade > 0 ? quantidade : 1) * sizeof(ReferenciaLivro));
+    if (classificacao == NULL || referencias == NULL) {
+        free(classificacao);
+        free(referencias);
+        return NULL;
+    }
+    for (int id = 0; id < quantidade; id++) {
+        referencias[id].texto = texto_do_id(dicionario, id);
+        referencias[id].posicao = id;
+    }
+    classificar_textos(referencias, quantidade, classificacao);
+    free(referencias);
+    return classificacao;
+}
 
-    // 4. Copiar de volta para a lista
-    atual = colecao->inicio;
-    for (int i = 0; i < colecao->quantidade; i++) {
-        if (atual == NULL) {
-            fprintf(stderr, "ERRO (ordenar_colecao_por_autor): Inconsistencia ao copiar dados de volta.\n");
-            break;
+/**
+ * @brief Calcula a posição alfabética do título de cada livro (por posição no vetor denso).
+ * @return unsigned int* Vetor com uma posição por livro (liberar com free), ou NULL se
+ * a alocação falhar.
+ */
+static unsigned int* classificar_titulos(const ArmazemLivros* armazem) {
+    unsigned int* classificacao = (unsigned int*) malloc((size_t)armazem->quantidade * sizeof(unsigned int));
+    ReferenciaLivro* referencias = (ReferenciaLivro*) malloc((size_t)armazem->quantidade * sizeof(ReferenciaLivro));
+    if (classificacao == NULL || referencias == NULL) {
+        free(classificacao);
+        free(referencias);
+        return NULL;
+    }
+    for (int i = 0; i < armazem->quantidade; i++) {
+        referencias[i].texto = titulo_registro(armazem, &armazem->registros[i]);
+        referencias[i].posicao = i;
+    }
+    classificar_textos(referencias, armazem->quantidade, classificacao);
+    free(referencias);
+    return classificacao;
+}
+
+/**
+ * @brief Ordem da coleção (TipoVisao) equivalente aos critérios: um único critério
+ * crescente de título, autor ou ano. Qualquer outra combinação é ORDEM_INDEFINIDA.
+ */
+static int ordem_dos_criterios(const ChaveOrdenacao* chaves, int quantidade_chaves) {
+    if (quantidade_chaves != 1 || chaves[0].decrescente) {
+        return ORDEM_INDEFINIDA;
+    }
+    switch (chaves[0].campo) {
+        case CAMPO_ORDENACAO_TITULO: return VISAO_TITULO;
+        case CAMPO_ORDENACAO_AUTOR:  return VISAO_AUTOR;
+        case CAMPO_ORDENACAO_ANO:    return VISAO_ANO;
+        default:                     return ORDEM_INDEFINIDA;
+    }
+}
+
+int ordenar_colecao_por_chaves(ColecaoLivros* colecao, const ChaveOrdenacao* chaves, int quantidade_chaves) {
+    if (colecao == NULL || chaves == NULL || quantidade_chaves < 1 || quantidade_chaves > QUANTIDADE_CAMPOS_ORDENACAO) {
+        return 0;
+    }
+    int campo_usado[QUANTIDADE_CAMPOS_ORDENACAO] = { 0 };
+    for (int c = 0; c < quantidade_chaves; c++) {
+        if (chaves[c].campo < 0 || chaves[c].campo >= QUANTIDADE_CAMPOS_ORDENACAO || campo_usado[chaves[c].campo]) {
+            return 0;
         }
-        atual->dadosLivro = array_de_livros[i];
-        atual = atual->proximo;
+        campo_usado[chaves[c].campo] = 1;
     }
+    const ArmazemLivros* armazem = &colecao->armazem;
+    int quantidade = armazem->quantidade;
+    if (quantidade < 2) {
+        return 1; // Nada a ordenar
+    }
+    int ordem = ordem_dos_criterios(chaves, quantidade_chaves);
+    if (ordem != ORDEM_INDEFINIDA &&
+        aproveitar_ordem_atual(colecao, (TipoVisao) ordem, "ordenar_colecao_por_chaves")) {
+        return 1;
+    }
+
+    // 1. Posições alfabéticas dos campos de texto usados (uma vez por texto distinto)
+    unsigned int* classificacao_titulos = campo_usado[CAMPO_ORDENACAO_TITULO] ? classificar_titulos(armazem) : NULL;
+    unsigned int* classificacao_autores = campo_usado[CAMPO_ORDENACAO_AUTOR] ? classificar_dicionario(&armazem->autores) : NULL;
+    unsigned int* classificacao_generos = campo_usado[CAMPO_ORDENACAO_GENERO] ? classificar_dicionario(&armazem->generos) : NULL;
+    ChaveComposta* chaves_livros = (ChaveComposta*) calloc((size_t)quantidade, sizeof(ChaveComposta));
+    if (chaves_livros == NULL ||
+        (campo_usado[CAMPO_ORDENACAO_TITULO] && classificacao_titulos == NULL) ||
+        (campo_usado[CAMPO_ORDENACAO_AUTOR] && classificacao_autores == NULL) ||
+        (campo_usado[CAMPO_ORDENACAO_GENERO] && classificacao_generos == NULL)) {
+        fprintf(stderr, "ERRO (ordenar_colecao_por_chaves): Falha ao alocar vetores temporarios.\n");
+        free(classificacao_titulos);
+        free(classificacao_autores);
+        free(classificacao_generos);
+        free(chaves_livros);
+        return 0;
+    }
+
+    // 2. Chave composta de cada livro: os critérios em ordem de prioridade e a posição atual
+    for (int i = 0; i < quantidade; i++) {
+        const RegistroLivro* registro = &armazem->registros[i];
+        unsigned char* destino = chaves_livros[i].bytes;
+        for (int c = 0; c < quantidade_chaves; c++) {
+            int decrescente = chaves[c].decrescente != 0;
+            switch (chaves[c].campo) {
+                case CAMPO_ORDENACAO_TITULO:
+                    gravar_chave_big_endian(destino, classificacao_titulos[i], 4, decrescente);
+                    break;
+                case CAMPO_ORDENACAO_AUTOR:
+                    gravar_chave_big_endian(destino, classificacao_autores[registro->id_autor], 4, decrescente);
+                    break;
+                case CAMPO_ORDENACAO_GENERO:
+                    gravar_chave_big_endian(destino, classificacao_generos[registro->id_genero], 4, decrescente);
+                    break;
+                case CAMPO_ORDENACAO_ANO:
+                    // O bit de sinal invertido faz os anos negativos virem antes dos positivos
+                    gravar_chave_big_endian(destino, (unsigned int)registro->anoPublicacao ^ 0x80000000u, 4, decrescente);
+                    break;
+                case CAMPO_ORDENACAO_ISBN:
+                    gravar_chave_big_endian(destino, registro->chave_isbn, 8, decrescente);
+                    destino += 4; // O ISBN ocupa 8 bytes
+                    break;
+                default:
+                    break;
+            }
+            destino += 4;
+        }
+        gravar_chave_big_endian(destino, (unsigned int)i, 4, 0);
+    }
+    free(classificacao_titulos);
+    free(classificacao_autores);
+    free(classificacao_generos);
 
-    // 5. Liberar array
-    free(array_de_livros);
+    // 3. Ordenar as chaves (memcmp) e reorganizar o armazenamento
+    ordenar_em_paralelo(chaves_livros, (size_t)quantidade, sizeof(ChaveComposta),
+                        ordenar_trecho_chaves, comparar_chaves_compostas);
+    int* ordem_handles = (int*) malloc((size_t)quantidade * sizeof(int));
+    if (ordem_handles == NULL) {
+        fprintf(stderr, "ERRO (ordenar_colecao_por_chaves): Falha ao alocar vetor temporario.\n");
+        free(chaves_livros);
+        return 0;
+    }
+    // A posição é o último campo gravado; seu deslocamento é o mesmo em todas as chaves
+    size_t deslocamento_posicao = 0;
+    for (int c = 0; c < quantidade_chaves; c++) {
+        deslocamento_posicao += chaves[c].campo == CAMPO_ORDENACAO_ISBN ? 8 : 4;
+    }
+    for (int i = 0; i < quantidade; i++) {
+        const unsigned char* bytes = chaves_livros[i].bytes + deslocamento_posicao;
+        int posicao = (int)(((unsigned int)bytes[0] << 24) | ((unsigned int)bytes[1] << 16) |
+                            ((unsigned int)bytes[2] << 8) | (unsigned int)bytes[3]);
+        ordem_handles[i] = armazem->handle_de_posicao[posicao];
+    }
+    free(chaves_livros);
 
-    // printf("INFO: Colecao ordenada por autor.\n"); // Opcional: feedback
-}
\ No newline at end of file
+    colecao->geracao++; // As posições mudam: resultados guardados deixam de valer
+    int sucesso = reordenar_armazem(&colecao->armazem, ordem_handles);
+    if (sucesso) {
+        registrar_ordem(colecao, ordem); // Outras combinações não são mantidas nas inserções
+    } else {
+        fprintf(stderr, "ERRO (ordenar_colecao_por_chaves): Falha ao reorganizar a colecao.\n");
+    }
+    free(ordem_handles);
+    return sucesso;
+}
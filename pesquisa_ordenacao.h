@@ -11,9 +11,203 @@
 
 // --- Métodos de Pesquisa ---
 
+/**
+ * @brief Função chamada para cada livro encontrado por `pesquisar_livros_por_titulo`.
+ * O registro é passado diretamente do armazenamento, sem cópias; use as funções de
+ * acesso de armazem_livros.h (ex: `titulo_registro`, `materializar_livro`) para lê-lo.
+ *
+ * @param armazem Armazenamento onde o registro está.
+ * @param registro Registro encontrado (válido apenas durante a chamada).
+ * @param handle Handle estável do registro.
+ * @param contexto Ponteiro repassado sem alterações pelo chamador da pesquisa.
+ * @return int 1 para continuar a pesquisa, 0 para interrompê-la.
+ * @warning A função não deve inserir nem remover livros da coleção pesquisada.
+ */
+typedef int (*VisitanteLivro)(const ArmazemLivros* armazem, const RegistroLivro* registro, int handle, void* contexto);
+
+/**
+ * @brief Campo dos livros examinado por uma pesquisa por substring.
+ */
+typedef enum {
+    CAMPO_TITULO,       ///< Pesquisa no título.
+    CAMPO_AUTOR         ///< Pesquisa no autor.
+} CampoPesquisa;
+
+/**
+ * @brief Estado de uma pesquisa por substring percorrida aos poucos (cursor).
+ * A pesquisa não diferencia maiúsculas de minúsculas nem letras acentuadas: o termo
+ * é dobrado uma vez (ver normalizacao.h) e comparado com os textos dobrados que o
+ * armazenamento calculou na inserção.
+ * O cursor guarda onde a varredura parou, de modo que cada página de resultados
+ * continua de onde a anterior terminou, sem reexaminar os livros já vistos.
+ *
+ * Na primeira chamada a `proximo_resultado_pesquisa`, se o índice de trigramas do
+ * campo estiver ativo e o termo tiver pelo menos 3 bytes, o cursor calcula os
+ * candidatos pelo índice e examina apenas eles (na ordem da coleção). Caso
+ * contrário, varre de uma só vez a arena de textos do campo (títulos, ou só os
+ * autores distintos) com a busca vetorizada de busca_substring.h. Com o cache de
+ * pesquisas ativo (ver `ativar_cache_consultas`), as posições exatas ficam guardadas
+ * e a mesma pesquisa, repetida antes de qualquer alteração da coleção, não examina
+ * nenhum livro.
+ * @warning O cursor só é válido enquanto a coleção não for modificada (inserção,
+ * remoção ou ordenação); depois disso, a pesquisa deve ser reiniciada. Ao terminar,
+ * libere-o com `encerrar_cursor_pesquisa`.
+ */
+typedef struct {
+    CampoPesquisa campo; ///< Campo pesquisado.
+    const char* termo;   ///< Texto buscado (não é copiado; deve continuar válido).
+    char* termo_dobrado; ///< Cópia dobrada do termo (minúsculas, sem acentos), comparada com os textos dobrados.
+    int preparado;       ///< 1 depois que os candidatos foram calculados.
+    int verificar;       ///< 1 se cada posição ainda precisa ser conferida com strstr.
+    int* posicoes;       ///< Posições candidatas em ordem crescente (NULL = todas as posições).
+    int total_posicoes;  ///< Número de posições candidatas (quando `posicoes` é usado).
+    int proxima;         ///< Próxima posição (ou índice em `posicoes`) a examinar.
+    int pular;           ///< Resultados que ainda serão pulados (deslocamento inicial).
+    int restantes;       ///< Resultados que ainda podem ser entregues (-1 = sem limite).
+} CursorPesquisa;
+
+/**
+ * @brief Prepara um cursor para pesquisar livros cujo campo contém `termo`.
+ * @param cursor Ponteiro para o CursorPesquisa a ser inicializado. Não deve ser NULL.
+ * @param campo Campo pesquisado (título ou autor).
+ * @param termo Texto buscado (substring; sem diferenciar maiúsculas nem acentos).
+ * @param deslocamento Número de resultados iniciais a pular (0 para nenhum).
+ * @param limite Número máximo de resultados a entregar (negativo para sem limite).
+ */
+void iniciar_cursor_pesquisa(CursorPesquisa* cursor, CampoPesquisa campo, const char* termo, int deslocamento, int limite);
+
+/**
+ * @brief Avança o cursor até o próximo livro cujo campo contém o termo buscado.
+ * @param colecao Ponteiro constante para a ColecaoLivros pesquisada.
+ * @param cursor Cursor inicializado com `iniciar_cursor_pesquisa`.
+ * @return int O handle do livro encontrado, ou HANDLE_INVALIDO se não houver mais
+ * resultados (fim da coleção ou limite atingido).
+ */
+int proximo_resultado_pesquisa(const ColecaoLivros* colecao, CursorPesquisa* cursor);
+
+/**
+ * @brief Libera a memória de candidatos do cursor. O cursor pode ser reiniciado depois.
+ * @param cursor Ponteiro para o CursorPesquisa. Se NULL, a função não faz nada.
+ */
+void encerrar_cursor_pesquisa(CursorPesquisa* cursor);
+
+/**
+ * @brief Entrega cada livro cujo título contém `titulo_busca` à função `visitar`,
+ * na ordem atual da coleção. A pesquisa termina no fim da coleção, ao atingir o
+ * limite ou quando `visitar` retorna 0. Usa o índice de trigramas de títulos, se ativo.
+ *
+ * @param colecao Ponteiro constante para a ColecaoLivros a ser pesquisada.
+ * @param titulo_busca Texto buscado (substring; sem diferenciar maiúsculas nem acentos).
+ * @param deslocamento Número de resultados iniciais a pular.
+ * @param limite Número máximo de resultados a entregar (negativo para sem limite).
+ * @param visitar Função chamada para cada resultado. Não deve ser NULL.
+ * @param contexto Ponteiro repassado a `visitar` (pode ser NULL).
+ * @return int O número de livros entregues a `visitar`.
+ */
+int pesquisar_livros_por_titulo(const ColecaoLivros* colecao, const char* titulo_busca, int deslocamento,
+                                int limite, VisitanteLivro visitar, void* contexto);
+
+/**
+ * @brief Entrega cada livro cujo autor contém `autor_busca` à função `visitar`.
+ * Mesmo comportamento de `pesquisar_livros_por_titulo`, usando o índice de trigramas
+ * de autores, se ativo.
+ */
+int pesquisar_livros_por_autor(const ColecaoLivros* colecao, const char* autor_busca, int deslocamento,
+                               int limite, VisitanteLivro visitar, void* contexto);
+
+/**
+ * @brief Conta os livros publicados no intervalo fechado [ano_minimo, ano_maximo],
+ * pelo índice de anos da coleção (sem examinar os livros).
+ * @return int O número de livros no intervalo (0 se a coleção for NULL).
+ */
+int contar_livros_por_ano(const ColecaoLivros* colecao, int ano_minimo, int ano_maximo);
+
+/**
+ * @brief Entrega à função `visitar` cada livro publicado no intervalo fechado
+ * [ano_minimo, ano_maximo], em ordem crescente de ano (dentro de um ano, em ordem
+ * não especificada). Usa o índice de anos: custa O(log A + K), sem examinar os livros
+ * fora do intervalo.
+ *
+ * @param colecao Ponteiro constante para a ColecaoLivros.
+ * @param ano_minimo Menor ano aceito.
+ * @param ano_maximo Maior ano aceito.
+ * @param deslocamento Número de resultados iniciais a pular.
+ * @param limite Número máximo de resultados a entregar (negativo para sem limite).
+ * @param visitar Função chamada para cada resultado. Não deve ser NULL.
+ * @param contexto Ponteiro repassado a `visitar` (pode ser NULL).
+ * @return int O número de livros entregues a `visitar`.
+ */
+int pesquisar_livros_por_ano(const ColecaoLivros* colecao, int ano_minimo, int ano_maximo, int deslocamento,
+                             int limite, VisitanteLivro visitar, void* contexto);
+
+/**
+ * @brief Número de livros de um gênero na coleção (uma faceta).
+ */
+typedef struct {
+    const char* genero;          ///< Texto do gênero (válido enquanto a coleção não for modificada).
+    int quantidade;              ///< Número de livros do gênero.
+} ContagemGenero;
+
+/**
+ * @brief Conta os livros de um gênero (comparação literal) pelo índice de gêneros,
+ * em O(1) depois de localizar o gênero no dicionário.
+ * @return int O número de livros do gênero (0 se o gênero não existir).
+ */
+int contar_livros_por_genero(const ColecaoLivros* colecao, const char* genero);
+
+/**
+ * @brief Monta o histograma de gêneros da coleção, em ordem decrescente de quantidade
+ * (empates em ordem alfabética). Cada contagem é lida do índice de gêneros, sem
+ * examinar os livros.
+ * @param colecao Ponteiro constante para a ColecaoLivros.
+ * @param contagens Vetor que recebe até `maximo` contagens (só gêneros com livros).
+ * @param maximo Capacidade de `contagens`.
+ * @return int O número de contagens gravadas.
+ */
+int histograma_generos(const ColecaoLivros* colecao, ContagemGenero* contagens, int maximo);
+
+/**
+ * @brief Entrega à função `visitar` cada livro de qualquer um dos gêneros informados
+ * (OU lógico), em ordem crescente de handle (a ordem de inserção, salvo handles
+ * reaproveitados). Com um só gênero, percorre direto o conjunto dele no índice de
+ * gêneros; com vários, percorre a união dos conjuntos. Livros de outros gêneros não
+ * são examinados.
+ *
+ * @param colecao Ponteiro constante para a ColecaoLivros.
+ * @param generos Gêneros aceitos (comparação literal; gêneros inexistentes são ignorados).
+ * @param quantidade_generos Número de gêneros em `generos`.
+ * @param deslocamento Número de resultados iniciais a pular.
+ * @param limite Número máximo de resultados a entregar (negativo para sem limite).
+ * @param visitar Função chamada para cada resultado. Não deve ser NULL.
+ * @param contexto Ponteiro repassado a `visitar` (pode ser NULL).
+ * @return int O número de livros entregues a `visitar` (0 também se a alocação da
+ * união falhar).
+ */
+int pesquisar_livros_por_generos(const ColecaoLivros* colecao, const char* const* generos, int quantidade_generos,
+                                 int deslocamento, int limite, VisitanteLivro visitar, void* contexto);
+
+/**
+ * @brief Entrega à função `visitar` os livros da coleção na ordem de uma visão
+ * ordenada (título, autor ou ano; ver visoes_ordenadas.h), sem ordenar nem alterar a
+ * coleção. Escolher outra ordem não custa nada: cada visão já está pronta. Livros com
+ * a mesma chave saem em ordem crescente de handle (decrescente, no sentido inverso).
+ *
+ * @param colecao Ponteiro constante para a ColecaoLivros (com as visões ativas; ver
+ * `ativar_visoes_ordenadas`).
+ * @param tipo Visão percorrida.
+ * @param decrescente 0 para percorrer do início ao fim, 1 do fim ao início.
+ * @param deslocamento Número de livros iniciais a pular (blocos inteiros são pulados de uma vez).
+ * @param limite Número máximo de livros a entregar (negativo para sem limite).
+ * @param visitar Função chamada para cada livro. Não deve ser NULL.
+ * @param contexto Ponteiro repassado a `visitar` (pode ser NULL).
+ * @return int O número de livros entregues a `visitar` (0 se as visões estiverem desativadas).
+ */
+int percorrer_visao_ordenada(const ColecaoLivros* colecao, TipoVisao tipo, int decrescente, int deslocamento,
+                             int limite, VisitanteLivro visitar, void* contexto);
+
 /**
  * @brief Pesquisa o primeiro livro na coleção cujo título contém a string de busca.
- * A busca é case-sensitive e considera substrings. Por exemplo, buscar por "Senhor"
+ * A busca não diferencia maiúsculas nem acentos e considera substrings. Por exemplo, buscar por "senhor dos aneis"
  * pode encontrar "O Senhor dos Anéis".
  *
  * @note A busca por ISBN, por ser um identificador único, geralmente está implementada
@@ -22,26 +216,125 @@
  *
  * @param colecao Ponteiro constante para a ColecaoLivros a ser pesquisada.
  * @param titulo_busca String constante contendo o título (ou parte dele) a ser buscado.
- * @return const Livro* Ponteiro constante para os dados do primeiro livro encontrado.
- * Retorna NULL se nenhum livro corresponder aos critérios de busca, ou se os
- * parâmetros de entrada forem inválidos (ex: colecao ou titulo_busca nulos).
- * @warning O ponteiro retornado aponta para dados internos da lista. Não modifique
- * o conteúdo apontado e não libere este ponteiro.
+ * @param livro_encontrado Ponteiro para uma struct Livro onde os dados do primeiro
+ * livro encontrado serão armazenados. Pode ser NULL se só a existência importar.
+ * @return int 1 se algum livro corresponder aos critérios de busca, 0 se nenhum
+ * corresponder ou se os parâmetros de entrada forem inválidos (ex: colecao ou
+ * titulo_busca nulos).
  * @note Se múltiplos livros corresponderem aos critérios, apenas o primeiro encontrado
- * (na ordem atual da lista) é retornado. Para obter todos os resultados, uma
- * abordagem diferente seria necessária (ex: uma função que retorna uma nova coleção
- * com os resultados ou que utiliza uma função de callback para processar cada achado).
+ * (na ordem atual da coleção) é retornado. Para obter todos os resultados, use
+ * `pesquisar_livros_por_titulo` (callback) ou um CursorPesquisa (paginação).
+ */
+int pesquisar_livro_por_titulo(const ColecaoLivros* colecao, const char* titulo_busca, Livro* livro_encontrado);
+
+/**
+ * @brief Sugere completamentos (autocompletar) para um prefixo de título ou de autor.
+ * Usa os índices de prefixos da coleção (ver `ativar_indices_prefixos`): cada sugestão
+ * é um título ou autor distinto que começa com o prefixo, sem diferenciar maiúsculas
+ * nem acentos. A popularidade é o número de livros que usam o texto.
+ *
+ * @param colecao Ponteiro constante para a ColecaoLivros.
+ * @param campo Campo completado (CAMPO_TITULO ou CAMPO_AUTOR).
+ * @param prefixo Texto digitado até o momento (pode ser vazio).
+ * @param maximo Número máximo de sugestões.
+ * @param ordem ORDEM_ALFABETICA ou ORDEM_POPULARIDADE.
+ * @param sugestoes Vetor com `maximo` posições que recebe as sugestões (válidas até
+ * a próxima alteração da coleção).
+ * @param popularidades Vetor opcional (pode ser NULL) que recebe a popularidade de cada sugestão.
+ * @return int O número de sugestões, ou 0 se os índices de prefixos estiverem desativados.
+ */
+int sugerir_completamentos(const ColecaoLivros* colecao, CampoPesquisa campo, const char* prefixo, int maximo,
+                           OrdemSugestoes ordem, const char** sugestoes, int* popularidades);
+
+/**
+ * @brief Um resultado da busca difusa (tolerante a erros de digitação).
+ */
+typedef struct {
+    int handle;      ///< Handle do livro encontrado.
+    int termos;      ///< Quantas palavras da busca aparecem (aproximadamente) no título.
+    int distancia;   ///< Soma das distâncias de edição dessas palavras (0 = todas exatas).
+} ResultadoDifuso;
+
+/**
+ * @brief Busca títulos parecidos com `titulo_busca`, tolerando erros de digitação.
+ * Cada palavra da busca é procurada na BK-tree do índice difuso (ver
+ * `ativar_indice_difuso`) com até `distancia_maxima` edições (palavras de até 2 letras
+ * exigem igualdade e de até 5 letras admitem 1 edição), sem calcular a distância
+ * para cada livro. Os livros são ordenados pelo número de palavras aproximadas
+ * (decrescente), pela distância total (crescente) e, por fim, pela ordem da coleção.
+ *
+ * @param colecao Ponteiro constante para a ColecaoLivros.
+ * @param titulo_busca Texto buscado (sem diferenciar maiúsculas nem acentos).
+ * @param distancia_maxima Tolerância por palavra (1 ou 2; limitada a DISTANCIA_DIFUSA_MAXIMA).
+ * @param resultados Vetor com `maximo` posições que recebe os melhores resultados.
+ * @param maximo Número máximo de resultados.
+ * @return int O número de resultados, ou 0 se o índice difuso estiver desativado.
+ */
+int pesquisar_titulos_aproximados(const ColecaoLivros* colecao, const char* titulo_busca, int distancia_maxima,
+                                  ResultadoDifuso* resultados, int maximo);
+
+/** @brief Tamanho máximo (com o terminador) do texto de uma busca por relevância. */
+#define TAM_BUSCA_RELEVANCIA 256
+
+/**
+ * @brief Busca por relevância: os livros cujos títulos, autores e gêneros melhor
+ * correspondem às palavras de `texto`, pela pontuação BM25 do índice de relevância
+ * (ver `ativar_indice_relevancia`). Um livro não precisa conter todas as palavras;
+ * palavras raras e termos no título pesam mais. Com o algoritmo WAND, apenas uma
+ * pequena parte dos livros que contêm palavras comuns chega a ser pontuada.
+ *
+ * @param colecao Ponteiro constante para a ColecaoLivros.
+ * @param texto Palavras buscadas (sem diferenciar maiúsculas nem acentos; o texto é
+ * truncado em TAM_BUSCA_RELEVANCIA - 1 bytes).
+ * @param resultados Vetor com `maximo` posições que recebe os resultados, do mais
+ * relevante ao menos relevante.
+ * @param maximo Número máximo de resultados.
+ * @return int O número de resultados, ou 0 se o índice de relevância estiver desativado.
  */
-const Livro* pesquisar_livro_por_titulo(const ColecaoLivros* colecao, const char* titulo_busca);
+int pesquisar_por_relevancia(const ColecaoLivros* colecao, const char* texto, ResultadoRelevancia* resultados, int maximo);
 
 // --- Métodos de Classificação (Ordenação) ---
 
+/**
+ * @brief Critério de ordenação das seleções dos primeiros livros.
+ */
+typedef enum {
+    CRITERIO_TITULO,             ///< Título em ordem alfabética (case-sensitive).
+    CRITERIO_AUTOR,              ///< Autor em ordem alfabética (case-sensitive).
+    CRITERIO_ANO_CRESCENTE,      ///< Ano de publicação, do mais antigo ao mais recente.
+    CRITERIO_ANO_DECRESCENTE     ///< Ano de publicação, do mais recente ao mais antigo.
+} CriterioOrdenacao;
+
+/**
+ * @brief Seleciona os `k` primeiros livros da coleção segundo o critério (ex: os 20
+ * mais antigos, a primeira página em ordem alfabética), sem ordenar nem modificar a
+ * coleção. Um heap limitado a `k` elementos percorre a coleção uma vez: custa
+ * O(N log k) e memória O(k). Empates são desfeitos pela posição na coleção, de modo
+ * que o resultado coincide com o início da ordenação estável correspondente.
+ *
+ * @param colecao Ponteiro constante para a ColecaoLivros.
+ * @param criterio Critério de ordenação.
+ * @param k Número de livros desejados.
+ * @param handles Vetor com espaço para `k` handles, que recebe os livros em ordem.
+ * @return int O número de handles gravados (min(k, tamanho da coleção)), ou 0 se os
+ * parâmetros forem inválidos ou a alocação falhar.
+ */
+int selecionar_primeiros_livros(const ColecaoLivros* colecao, CriterioOrdenacao criterio, int k, int* handles);
+
 /**
  * @brief Ordena os dados dos livros na coleção por título (ordem alfabética, case-sensitive).
- * Esta função modifica a ordem dos dados Livro DENTRO dos nós existentes da lista encadeada.
- * A estrutura da lista (os nós e seus ponteiros 'proximo') não é alterada, apenas o conteúdo 'dadosLivro'.
- * A ordenação é geralmente implementada copiando os dados para um array temporário,
- * ordenando o array com `qsort`, e depois copiando os dados ordenados de volta para a lista.
+ * Esta função reorganiza o vetor denso do armazenamento da coleção; os handles
+ * dos livros continuam os mesmos.
+ * A ordenação é implementada ordenando um array temporário de referências (ponteiro
+ * para o título + handle) com o quicksort multichave, que compara um caractere por vez
+ * e não relê os prefixos comuns, e depois reorganizando o armazenamento nessa ordem.
+ * A ordenação é estável (títulos iguais mantêm a ordem relativa).
+ *
+ * A coleção lembra a última ordenação (ver `ordem_atual` em lista_livros.h), mantida
+ * depois pela visão ordenada por título: se o armazenamento ainda estiver ordenado por
+ * título, nada é feito, e se inserções ou remoções o tiraram da ordem, a ordem é
+ * copiada da visão em O(N), sem comparar os títulos de novo. O mesmo vale para as
+ * ordenações por ano e por autor.
  *
  * @param colecao Ponteiro para a ColecaoLivros a ser ordenada.
  * Se a coleção for NULL ou tiver menos de 2 elementos, nenhuma ação é tomada.
@@ -50,8 +343,10 @@ void ordenar_colecao_por_titulo(ColecaoLivros* colecao);
 
 /**
  * @brief Ordena os dados dos livros na coleção por ano de publicação (ordem crescente).
- * Modifica a ordem dos dados Livro DENTRO dos nós existentes da lista, similarmente
- * à função `ordenar_colecao_por_titulo`.
+ * Reorganiza o vetor denso do armazenamento, como `ordenar_colecao_por_titulo`, mas sem
+ * comparações: os baldes do índice de anos já dão a contagem de cada ano, e os livros
+ * são distribuídos por contagem em O(N + faixa de anos) (O(N log A) se a faixa for
+ * muito grande). A ordenação é estável (livros do mesmo ano mantêm a ordem relativa).
  *
  * @param colecao Ponteiro para a ColecaoLivros a ser ordenada.
  * Se a coleção for NULL ou tiver menos de 2 elementos, nenhuma ação é tomada.
@@ -60,15 +355,59 @@ void ordenar_colecao_por_ano(ColecaoLivros* colecao);
 
 /**
  * @brief Ordena os dados dos livros na coleção por autor (ordem alfabética, case-sensitive).
- * Modifica a ordem dos dados Livro DENTRO dos nós existentes da lista.
- * A implementação desta função seguiria um padrão similar ao de
- * `ordenar_colecao_por_titulo`, utilizando uma função de comparação apropriada
- * para autores com `qsort`.
+ * Reorganiza o vetor denso do armazenamento, seguindo o mesmo padrão de
+ * `ordenar_colecao_por_titulo`. Como os autores são internados, apenas os autores
+ * distintos são comparados como texto; os livros são distribuídos pela posição
+ * alfabética (inteira) do seu autor com uma ordenação por contagem estável, em O(N).
  *
  * @param colecao Ponteiro para a ColecaoLivros a ser ordenada.
  * Se a coleção for NULL ou tiver menos de 2 elementos, nenhuma ação é tomada.
  */
 void ordenar_colecao_por_autor(ColecaoLivros* colecao);
 
+/**
+ * @brief Campo usado como chave na ordenação por vários critérios.
+ */
+typedef enum {
+    CAMPO_ORDENACAO_TITULO,      ///< Título (ordem alfabética, case-sensitive).
+    CAMPO_ORDENACAO_AUTOR,       ///< Autor (ordem alfabética, case-sensitive).
+    CAMPO_ORDENACAO_ANO,         ///< Ano de publicação.
+    CAMPO_ORDENACAO_GENERO,      ///< Gênero (ordem alfabética, case-sensitive).
+    CAMPO_ORDENACAO_ISBN,        ///< ISBN normalizado (ordem dos ISBN-13; ver chave_isbn.h).
+    QUANTIDADE_CAMPOS_ORDENACAO  ///< Número de campos (não é um campo).
+} CampoOrdenacao;
+
+/**
+ * @brief Um critério da ordenação por vários critérios: o campo e o sentido.
+ */
+typedef struct {
+    CampoOrdenacao campo;        ///< Campo comparado.
+    int decrescente;             ///< 0 = crescente, 1 = decrescente.
+} ChaveOrdenacao;
+
+/**
+ * @brief Ordena os livros da coleção por vários critérios em ordem de prioridade (ex:
+ * autor, depois ano decrescente, depois título), de forma estável: livros iguais em
+ * todos os critérios mantêm a ordem relativa.
+ *
+ * Cada livro recebe, uma única vez, uma chave composta de tamanho fixo em que cada
+ * critério ocupa alguns bytes em big-endian (textos viram sua posição alfabética,
+ * calculada uma vez por texto distinto; critérios decrescentes têm os bytes
+ * invertidos), seguida da posição atual do livro. Assim, comparar dois livros é um
+ * único `memcmp` e não há empates, o que garante a estabilidade. Reorganiza o vetor
+ * denso do armazenamento como as demais ordenações; os handles não mudam.
+ *
+ * @param colecao Ponteiro para a ColecaoLivros a ser ordenada.
+ * @param chaves Critérios, do mais importante para o menos importante.
+ * @param quantidade_chaves Número de critérios (1 a QUANTIDADE_CAMPOS_ORDENACAO); cada
+ * campo pode aparecer uma única vez.
+ * Um único critério crescente de título, autor ou ano equivale à ordenação
+ * correspondente e, como ela, aproveita e registra a ordem atual da coleção.
+ *
+ * @return int 1 em caso de sucesso (inclusive com menos de 2 livros), 0 se os critérios
+ * forem inválidos ou se alguma alocação falhar (a coleção não é alterada).
+ */
+int ordenar_colecao_por_chaves(ColecaoLivros* colecao, const ChaveOrdenacao* chaves, int quantidade_chaves);
+
 
 #endif // PESQUISA_ORDENACAO_H
\ No newline at end of file
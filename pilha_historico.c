@@ -20,6 +20,7 @@ PilhaHistorico* criar_pilha_historico() {
     }
     pilha->topo = NULL;
     pilha->quantidade = 0; // Inicializa a quantidade de elementos
+    inicializar_pool_nos(&pilha->pool_nos, sizeof(NoPilha), 0);
     return pilha;
 }
 
@@ -52,10 +53,9 @@ int push_historico(PilhaHistorico* pilha, const char* isbn) {
         return 0;
     }
 
-    NoPilha* novo_no = (NoPilha*) malloc(sizeof(NoPilha));
+    NoPilha* novo_no = (NoPilha*) alocar_no_pool(&pilha->pool_nos);
     if (novo_no == NULL) {
-        perror("ERRO (push_historico): Falha ao alocar memoria para novo no da pilha");
-        return 0;
+        return 0; // O pool já reporta a falha de alocação
     }
 
     strncpy(novo_no->isbn_consultado, isbn, TAM_ISBN - 1);
@@ -98,7 +98,7 @@ char* pop_historico(PilhaHistorico* pilha) {
     isbn_retorno[TAM_ISBN - 1] = '\0'; // Garante terminação nula, especialmente se o original não tinha ou era maior
 
     pilha->topo = no_removido->proximo;
-    free(no_removido);
+    liberar_no_pool(&pilha->pool_nos, no_removido);
     pilha->quantidade--; // Decrementa a quantidade
 
     return isbn_retorno;
@@ -125,8 +125,8 @@ const char* peek_historico(const PilhaHistorico* pilha) {
 
 /**
  * @brief Libera toda a memória alocada para a pilha de histórico.
- * Remove todos os elementos restantes (liberando a string ISBN alocada por pop_historico
- * durante este processo) e, em seguida, libera a própria estrutura da pilha.
+ * Devolve de uma só vez todos os nós restantes (blocos do pool da pilha), sem
+ * desempilhar um a um, e em seguida libera a própria estrutura da pilha.
  *
  * @param pilha Ponteiro para a PilhaHistorico a ser destruída.
  * Se a pilha for NULL, a função não faz nada.
@@ -136,13 +136,7 @@ void destruir_pilha_historico(PilhaHistorico* pilha) {
         return;
     }
 
-    char* isbn_temp;
-    while (!pilha_historico_vazia(pilha)) {
-        isbn_temp = pop_historico(pilha); // pop_historico já libera o NoPilha
-        if (isbn_temp != NULL) {
-            free(isbn_temp); // Libera a string ISBN que foi alocada e retornada por pop_historico
-        }
-    }
+    liberar_todos_nos_pool(&pilha->pool_nos); // Libera todos os NoPilha de uma só vez
 
     free(pilha); // Libera a estrutura da pilha em si
 }
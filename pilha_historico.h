@@ -13,6 +13,8 @@
  */
 #define TAM_ISBN 14
 
+#include "pool_nos.h" // Alocador em blocos usado para os nós da pilha
+
 /**
  * @brief Nó da pilha de histórico.
  * Contém uma string ISBN e um ponteiro para o próximo nó na pilha.
@@ -30,6 +32,7 @@ typedef struct NoPilha {
 typedef struct {
     NoPilha* topo;          ///< Ponteiro para o nó no topo da pilha (NULL se a pilha estiver vazia).
     int quantidade;         ///< Número de elementos atualmente na pilha.
+    PoolNos pool_nos;       ///< Pool de onde os nós da pilha são alocados (liberado de uma só vez).
 } PilhaHistorico;
 
 // --- Protótipos das Funções ---
@@ -86,8 +89,7 @@ int pilha_historico_vazia(const PilhaHistorico* pilha);
 
 /**
  * @brief Libera toda a memória alocada para a pilha de histórico e seus nós.
- * Isso inclui as strings ISBN que seriam retornadas (e alocadas) por `pop_historico`
- * durante o processo de esvaziamento da pilha.
+ * Os nós são devolvidos de uma só vez junto com os blocos do pool da pilha.
  *
  * @param pilha Ponteiro para a PilhaHistorico a ser destruída.
  * Se 'pilha' for NULL, a função não faz nada.
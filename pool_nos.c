@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <stdlib.h> // Para malloc e free
+#include "pool_nos.h"
+
+/** @brief Quantidade padrão de nós por bloco. */
+#define NOS_POR_BLOCO_PADRAO 256
+
+/** @brief Alinhamento usado para os nós (suficiente para ponteiros, int e double). */
+#define ALINHAMENTO_NO (sizeof(void*) > sizeof(double) ? sizeof(void*) : sizeof(double))
+
+/** @brief Tamanho do cabeçalho de bloco, arredondado para manter os nós alinhados. */
+#define TAMANHO_CABECALHO_BLOCO \
+    ((sizeof(BlocoPool) + ALINHAMENTO_NO - 1) / ALINHAMENTO_NO * ALINHAMENTO_NO)
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Aloca um novo bloco com espaço para `capacidade` nós e o torna o bloco corrente.
+ * Só é chamada quando o bloco corrente já foi todo entregue.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+static int adicionar_bloco_pool(PoolNos* pool, int capacidade) {
+    BlocoPool* bloco = (BlocoPool*) malloc(TAMANHO_CABECALHO_BLOCO + (size_t)capacidade * pool->tamanho_no);
+    if (bloco == NULL) {
+        perror("ERRO (adicionar_bloco_pool): Falha ao alocar bloco de nos");
+        return 0;
+    }
+
+    bloco->capacidade = capacidade;
+    bloco->proximo = pool->blocos;
+    pool->blocos = bloco;
+    pool->proximo_livre_bloco = (char*)bloco + TAMANHO_CABECALHO_BLOCO;
+    pool->restantes_bloco = capacidade;
+    return 1;
+}
+
+// --- FUNÇÕES DO POOL ---
+
+void inicializar_pool_nos(PoolNos* pool, size_t tamanho_no, int nos_por_bloco) {
+    // O nó precisa comportar o ponteiro da lista de livres e manter o alinhamento.
+    if (tamanho_no < sizeof(void*)) {
+        tamanho_no = sizeof(void*);
+    }
+    pool->tamanho_no = (tamanho_no + ALINHAMENTO_NO - 1) / ALINHAMENTO_NO * ALINHAMENTO_NO;
+    pool->nos_por_bloco = nos_por_bloco > 0 ? nos_por_bloco : NOS_POR_BLOCO_PADRAO;
+    pool->blocos = NULL;
+    pool->proximo_livre_bloco = NULL;
+    pool->restantes_bloco = 0;
+    pool->lista_livres = NULL;
+    pool->nos_em_uso = 0;
+}
+
+void* alocar_no_pool(PoolNos* pool) {
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    void* no;
+    if (pool->lista_livres != NULL) {
+        // Reaproveita um nó devolvido anteriormente.
+        no = pool->lista_livres;
+        pool->lista_livres = *(void**)no;
+    } else {
+        if (pool->restantes_bloco == 0 && !adicionar_bloco_pool(pool, pool->nos_por_bloco)) {
+            return NULL;
+        }
+        // Entrega os nós do bloco corrente em sequência (localidade de memória).
+        no = pool->proximo_livre_bloco;
+        pool->proximo_livre_bloco += pool->tamanho_no;
+        pool->restantes_bloco--;
+    }
+    pool->nos_em_uso++;
+    return no;
+}
+
+void liberar_no_pool(PoolNos* pool, void* no) {
+    if (pool == NULL || no == NULL) {
+        return;
+    }
+    *(void**)no = pool->lista_livres;
+    pool->lista_livres = no;
+    pool->nos_em_uso--;
+}
+
+void liberar_todos_nos_pool(PoolNos* pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    BlocoPool* bloco = pool->blocos;
+    while (bloco != NULL) {
+        BlocoPool* proximo = bloco->proximo;
+        free(bloco);
+        bloco = proximo;
+    }
+    inicializar_pool_nos(pool, pool->tamanho_no, pool->nos_por_bloco);
+}
@@ -0,0 +1,69 @@
+#ifndef POOL_NOS_H
+#define POOL_NOS_H
+
+#include <stddef.h> // Para size_t
+
+/**
+ * @file pool_nos.h
+ * @brief Define um alocador de nós de tamanho fixo (pool/slab), compartilhado pelas
+ * estruturas encadeadas do programa (fila de desejos e pilha de histórico).
+ *
+ * Os nós são obtidos de blocos grandes alocados de uma só vez, o que reduz o número
+ * de chamadas a malloc/free e mantém nós alocados em sequência próximos na memória.
+ * Nós liberados vão para uma lista de livres e são reaproveitados; todos os blocos
+ * podem ser devolvidos ao sistema de uma só vez com `liberar_todos_nos_pool`.
+ */
+
+/**
+ * @brief Cabeçalho de um bloco de nós. Os nós ficam logo após o cabeçalho.
+ */
+typedef struct BlocoPool {
+    struct BlocoPool* proximo;   ///< Próximo bloco alocado pelo pool.
+    int capacidade;              ///< Número de nós que cabem neste bloco.
+} BlocoPool;
+
+/**
+ * @brief Estrutura do pool de nós.
+ */
+typedef struct {
+    size_t tamanho_no;           ///< Tamanho de cada nó, arredondado para o alinhamento adequado.
+    int nos_por_bloco;           ///< Quantidade de nós alocados em cada novo bloco.
+    BlocoPool* blocos;           ///< Lista de blocos alocados (o mais recente primeiro).
+    char* proximo_livre_bloco;   ///< Próximo nó ainda não usado no bloco mais recente.
+    int restantes_bloco;         ///< Nós ainda não usados no bloco mais recente.
+    void* lista_livres;          ///< Lista encadeada (intrusiva) de nós devolvidos ao pool.
+    int nos_em_uso;              ///< Número de nós atualmente entregues aos chamadores.
+} PoolNos;
+
+// --- Protótipos das Funções ---
+
+/**
+ * @brief Inicializa um pool vazio. Nenhuma memória é alocada até o primeiro pedido.
+ * @param pool Ponteiro para o PoolNos a ser inicializado. Não deve ser NULL.
+ * @param tamanho_no Tamanho em bytes de cada nó (ex: sizeof(NoFila)).
+ * @param nos_por_bloco Quantidade de nós por bloco (valores <= 0 usam o padrão).
+ */
+void inicializar_pool_nos(PoolNos* pool, size_t tamanho_no, int nos_por_bloco);
+
+/**
+ * @brief Obtém um nó do pool (equivalente a malloc(tamanho_no)).
+ * @param pool Ponteiro para o PoolNos.
+ * @return void* Ponteiro para o nó (conteúdo não inicializado), ou NULL se a alocação falhar.
+ */
+void* alocar_no_pool(PoolNos* pool);
+
+/**
+ * @brief Devolve um nó ao pool para reaproveitamento (equivalente a free).
+ * @param pool Ponteiro para o PoolNos de onde o nó foi obtido.
+ * @param no Ponteiro para o nó. Se NULL, a função não faz nada.
+ */
+void liberar_no_pool(PoolNos* pool, void* no);
+
+/**
+ * @brief Libera de uma só vez todos os blocos do pool, invalidando todos os nós
+ * entregues. O pool volta ao estado vazio e pode ser reutilizado.
+ * @param pool Ponteiro para o PoolNos. Se NULL, a função não faz nada.
+ */
+void liberar_todos_nos_pool(PoolNos* pool);
+
+#endif // POOL_NOS_H
@@ -0,0 +1,283 @@
+#include <stdio.h>
+#include <stdlib.h> // Para malloc, realloc, free e qsort
+#include <string.h> // Para memmove e strcmp
+#include "visoes_ordenadas.h"
+
+/** @brief Ocupação dos blocos na construção (o restante absorve inserções). */
+#define PREENCHIMENTO_BLOCO_VISAO (CAPACIDADE_BLOCO_VISAO * 3 / 4)
+
+/** @brief Capacidade inicial do vetor de blocos. */
+#define CAPACIDADE_INICIAL_BLOCOS 16
+
+// --- Funções Auxiliares ---
+
+/**
+ * @brief Compara dois livros na ordem da visão (chave e, em empate, handle).
+ * @return int <0 se `a` vem antes de `b`, 0 se são o mesmo livro, >0 se vem depois.
+ */
+static int comparar_na_visao(TipoVisao tipo, const ArmazemLivros* armazem, int a, int b) {
+    if (a == b) {
+        return 0;
+    }
+    int comparacao = comparar_chaves_visao(tipo, armazem, obter_registro_armazem(armazem, a),
+                                           obter_registro_armazem(armazem, b));
+    if (comparacao != 0) {
+        return comparacao;
+    }
+    return a < b ? -1 : 1;
+}
+
+/**
+ * @brief Primeiro bloco cujo último handle não vem antes de `handle` (busca binária).
+ * @return int O índice do bloco, ou `quantidade_blocos` se todos vierem antes.
+ */
+static int localizar_bloco(const VisaoOrdenada* visao, const ArmazemLivros* armazem, int handle) {
+    int inicio = 0;
+    int fim = visao->quantidade_blocos;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        const BlocoVisao* bloco = visao->blocos[meio];
+        if (comparar_na_visao(visao->tipo, armazem, bloco->handles[bloco->quantidade - 1], handle) < 0) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return inicio;
+}
+
+/**
+ * @brief Primeira posição do bloco cujo handle não vem antes de `handle` (busca binária).
+ */
+static int localizar_no_bloco(const VisaoOrdenada* visao, const ArmazemLivros* armazem,
+                              const BlocoVisao* bloco, int handle) {
+    int inicio = 0;
+    int fim = bloco->quantidade;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (comparar_na_visao(visao->tipo, armazem, bloco->handles[meio], handle) < 0) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return inicio;
+}
+
+/**
+ * @brief Garante espaço para mais um bloco no vetor de blocos.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+static int garantir_capacidade_blocos(VisaoOrdenada* visao) {
+    if (visao->quantidade_blocos < visao->capacidade_blocos) {
+        return 1;
+    }
+    int nova = visao->capacidade_blocos > 0 ? visao->capacidade_blocos * 2 : CAPACIDADE_INICIAL_BLOCOS;
+    BlocoVisao** blocos = (BlocoVisao**) realloc(visao->blocos, (size_t)nova * sizeof(BlocoVisao*));
+    if (blocos == NULL) {
+        perror("ERRO (garantir_capacidade_blocos): Falha ao alocar blocos da visao");
+        return 0;
+    }
+    visao->blocos = blocos;
+    visao->capacidade_blocos = nova;
+    return 1;
+}
+
+/**
+ * @brief Insere um bloco já preenchido na posição `posicao` do vetor de blocos
+ * (a capacidade deve ter sido garantida).
+ */
+static void inserir_bloco(VisaoOrdenada* visao, int posicao, BlocoVisao* bloco) {
+    memmove(&visao->blocos[posicao + 1], &visao->blocos[posicao],
+            (size_t)(visao->quantidade_blocos - posicao) * sizeof(BlocoVisao*));
+    visao->blocos[posicao] = bloco;
+    visao->quantidade_blocos++;
+}
+
+/**
+ * @brief Livro durante a construção de uma visão: a chave e o handle.
+ */
+typedef struct {
+    const char* texto;           ///< Chave textual (título ou autor), nas visões por texto.
+    int chave;                   ///< Chave inteira (ano), na visão por ano.
+    int handle;                  ///< Handle do livro (desempate).
+} ElementoVisao;
+
+static int comparar_elementos_por_texto(const void* a, const void* b) {
+    const ElementoVisao* elemento_a = (const ElementoVisao*) a;
+    const ElementoVisao* elemento_b = (const ElementoVisao*) b;
+    int comparacao = strcmp(elemento_a->texto, elemento_b->texto);
+    if (comparacao != 0) {
+        return comparacao;
+    }
+    return (elemento_a->handle > elemento_b->handle) - (elemento_a->handle < elemento_b->handle);
+}
+
+static int comparar_elementos_por_chave(const void* a, const void* b) {
+    const ElementoVisao* elemento_a = (const ElementoVisao*) a;
+    const ElementoVisao* elemento_b = (const ElementoVisao*) b;
+    if (elemento_a->chave != elemento_b->chave) {
+        return elemento_a->chave < elemento_b->chave ? -1 : 1;
+    }
+    return (elemento_a->handle > elemento_b->handle) - (elemento_a->handle < elemento_b->handle);
+}
+
+// --- FUNÇÕES DA VISÃO ---
+
+int comparar_chaves_visao(TipoVisao tipo, const ArmazemLivros* armazem,
+                          const RegistroLivro* a, const RegistroLivro* b) {
+    switch (tipo) {
+        case VISAO_TITULO:
+            return strcmp(titulo_registro(armazem, a), titulo_registro(armazem, b));
+        case VISAO_AUTOR:
+            // Autores internados: o mesmo ID é o mesmo texto
+            return a->id_autor == b->id_autor ? 0 : strcmp(autor_registro(armazem, a), autor_registro(armazem, b));
+        case VISAO_ANO:
+            return (a->anoPublicacao > b->anoPublicacao) - (a->anoPublicacao < b->anoPublicacao);
+        default:
+            return 0;
+    }
+}
+
+void inicializar_visao_ordenada(VisaoOrdenada* visao, TipoVisao tipo) {
+    visao->tipo = tipo;
+    visao->blocos = NULL;
+    visao->quantidade_blocos = 0;
+    visao->capacidade_blocos = 0;
+    visao->total = 0;
+}
+
+int construir_visao_ordenada(VisaoOrdenada* visao, const ArmazemLivros* armazem) {
+    if (visao == NULL || armazem == NULL) {
+        return 0;
+    }
+    int quantidade = armazem->quantidade;
+    if (quantidade == 0) {
+        return 1;
+    }
+
+    ElementoVisao* elementos = (ElementoVisao*) malloc((size_t)quantidade * sizeof(ElementoVisao));
+    if (elementos == NULL) {
+        perror("ERRO (construir_visao_ordenada): Falha ao alocar vetor temporario");
+        return 0;
+    }
+    for (int i = 0; i < quantidade; i++) {
+        const RegistroLivro* registro = &armazem->registros[i];
+        elementos[i].texto = visao->tipo == VISAO_TITULO ? titulo_registro(armazem, registro)
+                           : visao->tipo == VISAO_AUTOR  ? autor_registro(armazem, registro)
+                                                         : NULL;
+        elementos[i].chave = registro->anoPublicacao;
+        elementos[i].handle = armazem->handle_de_posicao[i];
+    }
+    qsort(elementos, (size_t)quantidade, sizeof(ElementoVisao),
+          visao->tipo == VISAO_ANO ? comparar_elementos_por_chave : comparar_elementos_por_texto);
+
+    // Blocos preenchidos até PREENCHIMENTO_BLOCO_VISAO, na ordem obtida
+    for (int i = 0; i < quantidade; i += PREENCHIMENTO_BLOCO_VISAO) {
+        BlocoVisao* bloco = (BlocoVisao*) malloc(sizeof(BlocoVisao));
+        if (bloco == NULL || !garantir_capacidade_blocos(visao)) {
+            perror("ERRO (construir_visao_ordenada): Falha ao alocar blocos da visao");
+            free(bloco);
+            free(elementos);
+            liberar_visao_ordenada(visao);
+            return 0;
+        }
+        int restantes = quantidade - i;
+        bloco->quantidade = restantes < PREENCHIMENTO_BLOCO_VISAO ? restantes : PREENCHIMENTO_BLOCO_VISAO;
+        for (int j = 0; j < bloco->quantidade; j++) {
+            bloco->handles[j] = elementos[i + j].handle;
+        }
+        visao->blocos[visao->quantidade_blocos++] = bloco;
+    }
+    visao->total = quantidade;
+    free(elementos);
+    return 1;
+}
+
+int inserir_visao_ordenada(VisaoOrdenada* visao, const ArmazemLivros* armazem, int handle) {
+    if (visao == NULL || armazem == NULL) {
+        return 0;
+    }
+    if (visao->quantidade_blocos == 0) {
+        BlocoVisao* bloco = (BlocoVisao*) malloc(sizeof(BlocoVisao));
+        if (bloco == NULL || !garantir_capacidade_blocos(visao)) {
+            perror("ERRO (inserir_visao_ordenada): Falha ao alocar bloco da visao");
+            free(bloco);
+            return 0;
+        }
+        bloco->quantidade = 1;
+        bloco->handles[0] = handle;
+        inserir_bloco(visao, 0, bloco);
+        visao->total = 1;
+        return 1;
+    }
+
+    int b = localizar_bloco(visao, armazem, handle);
+    if (b == visao->quantidade_blocos) {
+        b--; // Depois de todos: vai para o final do último bloco
+    }
+    BlocoVisao* bloco = visao->blocos[b];
+
+    if (bloco->quantidade == CAPACIDADE_BLOCO_VISAO) {
+        // Bloco cheio: a metade superior vai para um bloco novo logo depois dele
+        BlocoVisao* novo = (BlocoVisao*) malloc(sizeof(BlocoVisao));
+        if (novo == NULL || !garantir_capacidade_blocos(visao)) {
+            perror("ERRO (inserir_visao_ordenada): Falha ao dividir bloco da visao");
+            free(novo);
+            return 0;
+        }
+        int metade = CAPACIDADE_BLOCO_VISAO / 2;
+        novo->quantidade = CAPACIDADE_BLOCO_VISAO - metade;
+        memcpy(novo->handles, &bloco->handles[metade], (size_t)novo->quantidade * sizeof(int));
+        bloco->quantidade = metade;
+        inserir_bloco(visao, b + 1, novo);
+        if (comparar_na_visao(visao->tipo, armazem, bloco->handles[metade - 1], handle) < 0) {
+            bloco = novo;
+        }
+    }
+
+    int posicao = localizar_no_bloco(visao, armazem, bloco, handle);
+    memmove(&bloco->handles[posicao + 1], &bloco->handles[posicao],
+            (size_t)(bloco->quantidade - posicao) * sizeof(int));
+    bloco->handles[posicao] = handle;
+    bloco->quantidade++;
+    visao->total++;
+    return 1;
+}
+
+void remover_visao_ordenada(VisaoOrdenada* visao, const ArmazemLivros* armazem, int handle) {
+    if (visao == NULL || armazem == NULL || visao->quantidade_blocos == 0) {
+        return;
+    }
+    int b = localizar_bloco(visao, armazem, handle);
+    if (b == visao->quantidade_blocos) {
+        return; // Depois de todos: não está na visão
+    }
+    BlocoVisao* bloco = visao->blocos[b];
+    int posicao = localizar_no_bloco(visao, armazem, bloco, handle);
+    if (posicao == bloco->quantidade || bloco->handles[posicao] != handle) {
+        return;
+    }
+
+    memmove(&bloco->handles[posicao], &bloco->handles[posicao + 1],
+            (size_t)(bloco->quantidade - posicao - 1) * sizeof(int));
+    bloco->quantidade--;
+    visao->total--;
+    if (bloco->quantidade == 0) {
+        free(bloco);
+        memmove(&visao->blocos[b], &visao->blocos[b + 1],
+                (size_t)(visao->quantidade_blocos - b - 1) * sizeof(BlocoVisao*));
+        visao->quantidade_blocos--;
+    }
+}
+
+void liberar_visao_ordenada(VisaoOrdenada* visao) {
+    if (visao == NULL) {
+        return;
+    }
+    for (int b = 0; b < visao->quantidade_blocos; b++) {
+        free(visao->blocos[b]);
+    }
+    free(visao->blocos);
+    inicializar_visao_ordenada(visao, visao->tipo);
+}
@@ -0,0 +1,99 @@
+#ifndef VISOES_ORDENADAS_H
+#define VISOES_ORDENADAS_H
+
+#include "armazem_livros.h" // Registros consultados para comparar os livros
+
+/**
+ * @file visoes_ordenadas.h
+ * @brief Define as visões ordenadas: sequências de handles dos livros em ordem de
+ * título, de autor ou de ano, mantidas a cada inserção e remoção, sem alterar a
+ * ordem do armazenamento.
+ *
+ * Uma visão é um vetor ordenado dividido em blocos de até CAPACIDADE_BLOCO_VISAO
+ * handles. O bloco de um livro é achado por busca binária sobre o último handle de
+ * cada bloco e a posição dentro do bloco por outra busca binária; inserir ou remover
+ * desloca apenas os handles de um bloco (um bloco cheio é dividido em dois, um bloco
+ * vazio é descartado). Percorrer a visão é ler os blocos em sequência.
+ *
+ * A ordem é total: livros com a mesma chave ficam em ordem crescente de handle, de
+ * modo que cada livro tem uma única posição possível e a remoção o encontra por
+ * busca binária. As chaves são lidas do armazenamento, então um livro deve ser
+ * inserido na visão depois de entrar no armazenamento e removido antes de sair dele.
+ */
+
+/** @brief Número máximo de handles em um bloco de uma visão. */
+#define CAPACIDADE_BLOCO_VISAO 256
+
+/**
+ * @brief Ordem mantida por uma visão.
+ */
+typedef enum {
+    VISAO_TITULO,                ///< Título em ordem alfabética (case-sensitive).
+    VISAO_AUTOR,                 ///< Autor em ordem alfabética (case-sensitive).
+    VISAO_ANO,                   ///< Ano de publicação, crescente.
+    QUANTIDADE_VISOES            ///< Número de visões (não é uma visão).
+} TipoVisao;
+
+/**
+ * @brief Trecho contíguo de uma visão.
+ */
+typedef struct {
+    int quantidade;                            ///< Número de handles no bloco.
+    int handles[CAPACIDADE_BLOCO_VISAO];       ///< Handles em ordem.
+} BlocoVisao;
+
+/**
+ * @brief Estrutura de uma visão ordenada.
+ */
+typedef struct {
+    TipoVisao tipo;              ///< Ordem mantida.
+    BlocoVisao** blocos;         ///< Blocos em ordem (nenhum vazio).
+    int quantidade_blocos;       ///< Número de blocos.
+    int capacidade_blocos;       ///< Capacidade alocada de `blocos`.
+    int total;                   ///< Número de handles na visão.
+} VisaoOrdenada;
+
+// --- Protótipos das Funções ---
+
+/**
+ * @brief Compara as chaves de dois registros na ordem de uma visão (sem desempate):
+ * título ou autor com `strcmp`, ano numericamente. É também a ordem mantida pela
+ * coleção depois de `ordenar_colecao_por_titulo`/`_autor`/`_ano`.
+ * @return int <0, 0 ou >0, como `strcmp`.
+ */
+int comparar_chaves_visao(TipoVisao tipo, const ArmazemLivros* armazem,
+                          const RegistroLivro* a, const RegistroLivro* b);
+
+/**
+ * @brief Inicializa uma visão vazia. Nenhuma memória é alocada até a primeira inserção.
+ * @param visao Ponteiro para a VisaoOrdenada. Não deve ser NULL.
+ * @param tipo Ordem mantida pela visão.
+ */
+void inicializar_visao_ordenada(VisaoOrdenada* visao, TipoVisao tipo);
+
+/**
+ * @brief Preenche uma visão vazia com todos os livros do armazenamento (uma única
+ * ordenação, com os blocos preenchidos até 3/4 para absorver inserções).
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar (a visão fica vazia).
+ */
+int construir_visao_ordenada(VisaoOrdenada* visao, const ArmazemLivros* armazem);
+
+/**
+ * @brief Insere um livro (já presente no armazenamento) em sua posição na visão.
+ * @return int 1 em caso de sucesso, 0 se a alocação falhar (nada é inserido).
+ */
+int inserir_visao_ordenada(VisaoOrdenada* visao, const ArmazemLivros* armazem, int handle);
+
+/**
+ * @brief Remove um livro (ainda presente no armazenamento) da visão. Handles
+ * ausentes são ignorados.
+ */
+void remover_visao_ordenada(VisaoOrdenada* visao, const ArmazemLivros* armazem, int handle);
+
+/**
+ * @brief Libera toda a memória da visão e a deixa vazia (reutilizável).
+ * @param visao Ponteiro para a VisaoOrdenada. Se NULL, a função não faz nada.
+ */
+void liberar_visao_ordenada(VisaoOrdenada* visao);
+
+#endif // VISOES_ORDENADAS_H